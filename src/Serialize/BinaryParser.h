@@ -15,6 +15,7 @@
  *      data is stored/read in a particular order. To make sure that the data being read matches
  *      the data being stored a hash based on the Traits is generated and stored as a prefix to
  *      the data. This allows the parser to validate it is reading the same object that was stored.
+ *      The prefix is the format version (1 byte) followed by the 64 bit hash (see BinaryTHash.h).
  *
  *      This uses BinaryParserUtil<T> to do that actual work of parsing and generating the appropriate
  *      tokens needed by a user of the ParserInterface. If an member is a serializeable user type `U` we
@@ -167,6 +168,10 @@ class BinaryParser: public ParserInterface
     {
         unsigned int size;
         getValue(size);
+        if (!checkStringLength(size))
+        {
+            return "";
+        }
         std::string     result(size, '\0');
         result.resize(size);
         input.read(&result[0], size);
@@ -176,9 +181,12 @@ class BinaryParser: public ParserInterface
         BinaryParser(std::istream& stream, ParserConfig config = ParserConfig{ParserInterface::ParseType::Strict})
             : ParserInterface(stream, config)
         {
-            std::size_t hash   = TBin::net2Host(read<TBin::BinForm32>());
-            std::size_t expect = std::uint32_t(thash<T>());
-            if (hash != expect)
+            if (read<std::uint8_t>() != binaryFormatVersion)
+            {
+                throw std::runtime_error("ThorsAnvil::Serialize::BinaryParser::BinaryParser: unsupported binary format version");
+            }
+            static constexpr THash expect = thash<T>();
+            if (TBin::net2Host(read<TBin::BinForm64>()) != expect)
             {
                 throw std::runtime_error("ThorsAnvil::Serialize::BinaryParser::BinaryParser: input hash for binary object did not match");
             }
@@ -212,6 +220,7 @@ class BinaryParser: public ParserInterface
         virtual void    getValue(bool& value)                  override {value = read<unsigned char>();}
 
         virtual void    getValue(std::string& value)           override {value = readString();};
+        using ParserInterface::getValue;                        // Overloads that are not virtual.
 
         virtual bool    isValueNull()                          override
         {
@@ -219,6 +228,8 @@ class BinaryParser: public ParserInterface
         }
 
         virtual std::string getRawValue()                      override {return readString();};
+
+        virtual bool    isBinary() const                       override {return true;}
 };
 
     }
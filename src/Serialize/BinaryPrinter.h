@@ -36,7 +36,12 @@ class BinaryPrinter: public PrinterInterface
         BinaryPrinter(std::ostream& output, PrinterInterface::PrinterConfig characteristics = PrinterConfig{})
             : PrinterInterface(output, characteristics)
         {}
-        virtual void openDoc()                              override    {write(TBin::host2Net(static_cast<TBin::BinForm32>(thash<T>())));}
+        virtual void openDoc()                              override
+        {
+            static constexpr THash hash = thash<T>();
+            write(binaryFormatVersion);
+            write(TBin::host2Net(static_cast<TBin::BinForm64>(hash)));
+        }
         virtual void closeDoc()                             override    {}
 
         virtual void openMap()                              override    {}
@@ -45,6 +50,7 @@ class BinaryPrinter: public PrinterInterface
         virtual void closeArray()                           override    {}
 
         virtual void addKey(std::string const& key)         override    {}
+        virtual void addKey(MemberKey const& key)           override    {}
 
         virtual void addValue(short int value)              override    {write(TBin::host2Net(static_cast<TBin::BinForm16>(value)));}
         virtual void addValue(int value)                    override    {write(TBin::host2Net(static_cast<TBin::BinForm32>(value)));}
@@ -63,6 +69,7 @@ class BinaryPrinter: public PrinterInterface
         virtual void addValue(bool value)                   override    {write(static_cast<unsigned char>(value));}
 
         virtual void addValue(std::string const& value)     override    {writeString(value);}
+        using PrinterInterface::addValue;                    // Overloads that are not virtual.
 
         virtual void addRawValue(std::string const& value)  override    {writeString(value);}
 
@@ -71,6 +78,12 @@ class BinaryPrinter: public PrinterInterface
             throw std::runtime_error("ThorsAnvil::Serialize::BinaryPrinter::addNull Not Implemented");
         }
 
+        virtual bool isBinary() const                       override    {return true;}
+
+        // Array elements are written back to back with no separator.
+        // So a chunk needs no extra state.
+        virtual bool canPrintArrayChunk() const             override    {return true;}
+
 };
 
     }
@@ -1,31 +1,37 @@
 #ifndef THORS_ANVIL_SERIALIZE_THASH_H
 #define THORS_ANVIL_SERIALIZE_THASH_H
 /*
- * Generates a (relatively) unique hash for a type T.
+ * Generates a (relatively) unique 64 bit hash for a type T.
  *
- * Uses a very simple but fast hashing algorithm. It is not designed to be anything
- * but fast. It is designed to guard against accidental changes not deliberate attacks.
+ * The member names and types are hashed with FNV-1a and each name is followed by
+ * a 64 bit finalizer (from MurmurHash3) so that a small change in a type changes
+ * the whole hash. It is designed to guard against accidental changes not deliberate attacks.
+ *
+ * The binary formats store the hash in a header (see BinaryPrinter<T>):
+ *      <binaryFormatVersion (1 byte)> <thash<T>() (8 bytes network byte order)>
+ *
+ * thash<T>() is constexpr so the hash is a compile time constant.
  */
 
 #include <cstdlib>
+#include <cstdint>
 
 namespace ThorsAnvil
 {
     namespace Serialize
     {
 
+using THash = std::uint64_t;
+
+static constexpr THash          thashSeed           = 0xcbf29ce484222325ULL;    // FNV-1a offset basis
+static constexpr std::uint8_t   binaryFormatVersion = 1;
+
 template<typename T>
-std::size_t thash(std::size_t restul = 0);
+constexpr THash thash(THash start = thashSeed);
 
     }
 }
 
-#if defined(HEADER_ONLY) && HEADER_ONLY == 1
-#include "BinaryTHash.source"
-#endif
-
-#ifndef COVERAGE_TEST
 #include "BinaryTHash.tpp"
-#endif
 
 #endif
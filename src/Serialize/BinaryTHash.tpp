@@ -10,21 +10,33 @@
 #include <memory>
 #include <set>
 #include <map>
-
+#include <tuple>
+#include <utility>
+#include <type_traits>
 
 namespace ThorsAnvil
 {
     namespace Serialize
     {
 
-inline std::size_t thash(std::size_t start, std::string const& input)
+inline constexpr THash thashMix(THash value)
+{
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb53a5ed9fb39ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+inline constexpr THash thash(THash start, char const* input)
 {
-    static constexpr std::size_t    mult = 37;
-    for (auto loop: input)
+    constexpr THash prime = 0x100000001b3ULL;                   // FNV-1a prime
+    for (; *input != '\0'; ++input)
     {
-        start = start * mult + loop;
+        start = (start ^ static_cast<unsigned char>(*input)) * prime;
     }
-    return start;
+    return thashMix(start);
 }
 
 template<typename T>
@@ -32,80 +44,89 @@ struct TraitsHash;
 
 
 template<typename T, typename M>
-inline std::size_t thash(std::size_t start, std::pair<char const*, M T::*> const& member)
+inline constexpr THash thash(THash start, std::pair<char const*, M T::*> const& member)
 {
-    TraitsHash<M>   typeHash;
-    start   = typeHash(start);
+    start   = TraitsHash<M>{}(start);
     return thash(start, member.first);
 }
 
 template<typename T>
-inline std::size_t thash(std::size_t result)
+inline constexpr THash thash(THash result)
 {
-    TraitsHash<T>   hasher;
-    return hasher(result);
+    return TraitsHash<T>{}(result);
 }
 
 template<typename T>
 struct TraitsHash
 {
-    template<typename Members, std::size_t... Seq>
-    std::size_t makeTraitsHashValue(std::size_t start, Members const& member, std::index_sequence<Seq...> const&)
+    // The macro generated Traits hold the member list in a constexpr tuple.
+    // The container Traits return an extractor object (that has no state) so the
+    // hash is taken from a default constructed object of the same type.
+    // Thus the whole hash can be evaluated at compile time.
+    using Members = typename std::decay<decltype(Traits<T>::getMembers())>::type;
+
+    template<typename M, std::size_t... Seq>
+    static constexpr THash makeTraitsHashValue(THash start, M const& member, std::index_sequence<Seq...> const&)
     {
-        auto d = {1, (start=thash(start, std::get<Seq>(member)), 1)...};
-        d.size();
+        ((start = thash(start, std::get<Seq>(member))), ...);
         return start;
     }
-    template<typename... Members>
-    std::size_t makeTraitsHash(std::size_t start, std::tuple<std::pair<char const*, Members>...>const& members)
+    template<typename... M>
+    static constexpr THash makeTraitsHash(THash start, std::tuple<std::pair<char const*, M>...> const& members)
     {
-        return makeTraitsHashValue(start, members, std::make_index_sequence<sizeof...(Members)>());
+        return makeTraitsHashValue(start, members, std::make_index_sequence<sizeof...(M)>());
     }
-    std::size_t makeTraitsHash(std::size_t start, std::tuple<void*> const&)
+    static constexpr THash makeTraitsHash(THash start, std::tuple<void*> const&)
     {
         return thash(start, "Empty");
     }
+    template<typename... M>
+    static constexpr THash getHash(THash start, std::tuple<M...>*)
+    {
+        return makeTraitsHash(start, Traits<T>::getMembers());
+    }
     template<typename Action>
-    std::size_t makeTraitsHash(std::size_t start, Action const& action)
+    static constexpr THash getHash(THash start, Action*)
     {
-        return action.getHash(start);
+        return Action{}.getHash(start);
     }
-    std::size_t operator()(std::size_t start)    {return makeTraitsHash(start, Traits<T>::getMembers());}
+    constexpr THash operator()(THash start) const {return getHash(start, static_cast<Members*>(nullptr));}
 };
 
-template<> struct TraitsHash<short>                 {std::size_t operator()(std::size_t start){return thash(start, "S");}};
-template<> struct TraitsHash<int>                   {std::size_t operator()(std::size_t start){return thash(start, "I");}};
-template<> struct TraitsHash<long>                  {std::size_t operator()(std::size_t start){return thash(start, "L");}};
-template<> struct TraitsHash<long long>             {std::size_t operator()(std::size_t start){return thash(start, "LL");}};
+template<> struct TraitsHash<short>                 {constexpr THash operator()(THash start) const {return thash(start, "S");}};
+template<> struct TraitsHash<int>                   {constexpr THash operator()(THash start) const {return thash(start, "I");}};
+template<> struct TraitsHash<long>                  {constexpr THash operator()(THash start) const {return thash(start, "L");}};
+template<> struct TraitsHash<long long>             {constexpr THash operator()(THash start) const {return thash(start, "LL");}};
 
-template<> struct TraitsHash<unsigned short>        {std::size_t operator()(std::size_t start){return thash(start, "US");}};
-template<> struct TraitsHash<unsigned int>          {std::size_t operator()(std::size_t start){return thash(start, "UI");}};
-template<> struct TraitsHash<unsigned long>         {std::size_t operator()(std::size_t start){return thash(start, "UL");}};
-template<> struct TraitsHash<unsigned long long>    {std::size_t operator()(std::size_t start){return thash(start, "ULL");}};
+template<> struct TraitsHash<unsigned short>        {constexpr THash operator()(THash start) const {return thash(start, "US");}};
+template<> struct TraitsHash<unsigned int>          {constexpr THash operator()(THash start) const {return thash(start, "UI");}};
+template<> struct TraitsHash<unsigned long>         {constexpr THash operator()(THash start) const {return thash(start, "UL");}};
+template<> struct TraitsHash<unsigned long long>    {constexpr THash operator()(THash start) const {return thash(start, "ULL");}};
 
-template<> struct TraitsHash<float>                 {std::size_t operator()(std::size_t start){return thash(start, "F");}};
-template<> struct TraitsHash<double>                {std::size_t operator()(std::size_t start){return thash(start, "D");}};
-template<> struct TraitsHash<long double>           {std::size_t operator()(std::size_t start){return thash(start, "LD");}};
+template<> struct TraitsHash<float>                 {constexpr THash operator()(THash start) const {return thash(start, "F");}};
+template<> struct TraitsHash<double>                {constexpr THash operator()(THash start) const {return thash(start, "D");}};
+template<> struct TraitsHash<long double>           {constexpr THash operator()(THash start) const {return thash(start, "LD");}};
 
-template<> struct TraitsHash<bool>                  {std::size_t operator()(std::size_t start){return thash(start, "B");}};
-template<> struct TraitsHash<std::string>           {std::size_t operator()(std::size_t start){return thash(start, "String");}};
+template<> struct TraitsHash<bool>                  {constexpr THash operator()(THash start) const {return thash(start, "B");}};
+template<> struct TraitsHash<std::string>           {constexpr THash operator()(THash start) const {return thash(start, "String");}};
+template<> struct TraitsHash<std::string_view>      {constexpr THash operator()(THash start) const {return thash(start, "String");}};
 
 template<typename T, std::size_t S>
-struct TraitsHash<std::array<T, S>>      {std::size_t operator()(std::size_t start){return thash(thash<T>(start + S), "std::array");}};
+struct TraitsHash<std::array<T, S>>      {constexpr THash operator()(THash start) const {return thash(thash<T>(start + S), "std::array");}};
 template<typename T>
-struct TraitsHash<std::list<T>>          {std::size_t operator()(std::size_t start){return thash(thash<T>(start), "std::list");}};
+struct TraitsHash<std::list<T>>          {constexpr THash operator()(THash start) const {return thash(thash<T>(start), "std::list");}};
 template<typename T>
-struct TraitsHash<std::vector<T>>        {std::size_t operator()(std::size_t start){return thash(thash<T>(start), "std::vector");}};
+struct TraitsHash<std::vector<T>>        {constexpr THash operator()(THash start) const {return thash(thash<T>(start), "std::vector");}};
 template<typename T>
-struct TraitsHash<std::deque<T>>         {std::size_t operator()(std::size_t start){return thash(thash<T>(start), "std::dequeu");}};
+struct TraitsHash<std::deque<T>>         {constexpr THash operator()(THash start) const {return thash(thash<T>(start), "std::dequeu");}};
 template<typename K, typename V>
-struct TraitsHash<std::pair<K, V>>       {std::size_t operator()(std::size_t start){return thash(thash<K>(thash<V>(start)), "std::pair");}};
+struct TraitsHash<std::pair<K, V>>       {constexpr THash operator()(THash start) const {return thash(thash<K>(thash<V>(start)), "std::pair");}};
 template<typename T>
-struct TraitsHash<std::multiset<T>>      {std::size_t operator()(std::size_t start){return thash(thash<T>(start), "std::multiset");}};
+struct TraitsHash<std::multiset<T>>      {constexpr THash operator()(THash start) const {return thash(thash<T>(start), "std::multiset");}};
 template<typename K, typename V>
-struct TraitsHash<std::map<K, V>>        {std::size_t operator()(std::size_t start){return thash(thash<K>(thash<V>(start)), "std::map");}};
+struct TraitsHash<std::map<K, V>>        {constexpr THash operator()(THash start) const {return thash(thash<K>(thash<V>(start)), "std::map");}};
 template<typename K, typename V>
-struct TraitsHash<std::multimap<K, V>>   {std::size_t operator()(std::size_t start){return thash(thash<K>(thash<V>(start)), "std::multimap");}};
+struct TraitsHash<std::multimap<K, V>>   {constexpr THash operator()(THash start) const {return thash(thash<K>(thash<V>(start)), "std::multimap");}};
     }
 }
 
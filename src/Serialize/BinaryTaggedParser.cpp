@@ -0,0 +1,252 @@
+#include "SerializeConfig.h"
+#ifdef NETWORK_BYTE_ORDER
+#include "BinaryTaggedParser.h"
+
+using namespace ThorsAnvil::Serialize;
+using ParserToken = ParserInterface::ParserToken;
+
+HEADER_ONLY_INCLUDE
+std::size_t TaggedSchema::findKey(std::string const& key) const
+{
+    std::size_t index = 0;
+    for (; index < keys.size() && keys[index] != key; ++index)
+    {}
+    return index;
+}
+
+HEADER_ONLY_INCLUDE
+BinaryTaggedParser::BinaryTaggedParser(std::istream& stream, ParserConfig config, TaggedSchema const& root)
+    : ParserInterface(stream, config)
+    , root(root)
+    , stage(Stage::DocStart)
+    , pending(nullptr)
+    , fieldSize(0)
+{}
+
+template<typename Obj>
+inline Obj BinaryTaggedParser::read()
+{
+    Obj   networkValue;
+    input.read(reinterpret_cast<char*>(&networkValue), sizeof(Obj));
+    if (!input || input.gcount() != sizeof(Obj))
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::BinaryTaggedParser::read: Unexpected read failure");
+    }
+    return networkValue;
+}
+
+HEADER_ONLY_INCLUDE
+std::size_t BinaryTaggedParser::readVarint()
+{
+    std::size_t result  = 0;
+    for (std::size_t shift = 0; shift < sizeof(std::size_t) * 8; shift += 7)
+    {
+        int next = input.get();
+        if (next == std::char_traits<char>::eof())
+        {
+            throw std::runtime_error("ThorsAnvil::Serialize::BinaryTaggedParser::readVarint: Unexpected end of input");
+        }
+        result |= static_cast<std::size_t>(next & 0x7F) << shift;
+        if ((next & 0x80) == 0)
+        {
+            return result;
+        }
+    }
+    throw std::runtime_error("ThorsAnvil::Serialize::BinaryTaggedParser::readVarint: Tag too large");
+}
+
+HEADER_ONLY_INCLUDE
+std::string BinaryTaggedParser::readText(std::size_t size)
+{
+    if (!checkStringLength(size))
+    {
+        return "";
+    }
+    std::string     result(size, '\0');
+    if (size > 0 && !input.read(&result[0], size))
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::BinaryTaggedParser::readText: Unexpected end of input");
+    }
+    return result;
+}
+
+HEADER_ONLY_INCLUDE
+std::string BinaryTaggedParser::readString()
+{
+    return readText(TBin::net2Host(read<TBin::BinForm32>()));
+}
+
+HEADER_ONLY_INCLUDE
+void BinaryTaggedParser::skip(std::size_t size)
+{
+    input.ignore(size);
+    if (static_cast<std::size_t>(input.gcount()) != size)
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::BinaryTaggedParser::skip: Unexpected end of input");
+    }
+}
+
+HEADER_ONLY_INCLUDE
+ParserToken BinaryTaggedParser::startValue(TaggedSchema const* node)
+{
+    if (node == nullptr)
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::BinaryTaggedParser::startValue: Type not supported by the tagged binary format");
+    }
+    switch (node->kind)
+    {
+        case TaggedSchema::Kind::Map:
+        case TaggedSchema::Kind::DynamicMap:
+            state.push_back(Frame{node, 0});
+            return ParserToken::MapStart;
+        case TaggedSchema::Kind::Array:
+            state.push_back(Frame{node, TBin::net2Host(read<TBin::BinForm32>())});
+            return ParserToken::ArrayStart;
+        case TaggedSchema::Kind::Value:
+            break;
+    }
+    if (state.empty())
+    {
+        stage = Stage::DocEnd;
+    }
+    return ParserToken::Value;
+}
+
+HEADER_ONLY_INCLUDE
+ParserToken BinaryTaggedParser::endContainer(ParserToken token)
+{
+    state.pop_back();
+    if (state.empty())
+    {
+        stage = Stage::DocEnd;
+    }
+    return token;
+}
+
+HEADER_ONLY_INCLUDE
+ParserToken BinaryTaggedParser::getNextToken()
+{
+    switch (stage)
+    {
+        case Stage::DocStart:
+            stage = Stage::Root;
+            return ParserToken::DocStart;
+        case Stage::Root:
+            stage = Stage::Body;
+            return startValue(&root);
+        case Stage::DocEnd:
+            stage = Stage::Done;
+            return ParserToken::DocEnd;
+        case Stage::Done:
+            return ParserToken::Error;
+        case Stage::Body:
+            break;
+    }
+
+    if (pending != nullptr)
+    {
+        // The key was returned by the last call.
+        TaggedSchema const* node = pending;
+        pending = nullptr;
+        return startValue(node);
+    }
+
+    Frame&  top = state.back();
+    if (top.node->kind == TaggedSchema::Kind::Array)
+    {
+        if (top.remaining == 0)
+        {
+            return endContainer(ParserToken::ArrayEnd);
+        }
+        --top.remaining;
+        return startValue(top.node->element);
+    }
+
+    for (;;)
+    {
+        std::size_t tag = readVarint();
+        if (tag == 0)
+        {
+            return endContainer(ParserToken::MapEnd);
+        }
+
+        std::size_t index;
+        if (tag % 2 == 0)
+        {
+            index   = tag / 2 - 1;
+            key     = index < top.node->keys.size() ? top.node->keys[index] : "";
+        }
+        else
+        {
+            key     = readText(tag / 2);
+            index   = top.node->findKey(key);
+        }
+        fieldSize   = TBin::net2Host(read<TBin::BinForm32>());
+
+        if (top.node->kind == TaggedSchema::Kind::DynamicMap)
+        {
+            pending = top.node->element;
+            return ParserToken::Key;
+        }
+        if (index < top.node->members.size())
+        {
+            pending = top.node->members[index];
+            return ParserToken::Key;
+        }
+        // A field added by a newer version of the type.
+        // The reader does not know about it so skip it.
+        skip(fieldSize);
+    }
+}
+
+HEADER_ONLY_INCLUDE
+void BinaryTaggedParser::ignoreTheValue()
+{
+    if (pending == nullptr)
+    {
+        // Not called directly after a key.
+        // Use the generic method.
+        ParserInterface::ignoreTheValue();
+        return;
+    }
+    pending = nullptr;
+    skip(fieldSize);
+}
+
+HEADER_ONLY_INCLUDE
+std::string BinaryTaggedParser::getKey()
+{
+    return key;
+}
+
+HEADER_ONLY_INCLUDE void BinaryTaggedParser::getValue(short int& value)             {value = TBin::net2Host(read<TBin::BinForm16>());}
+HEADER_ONLY_INCLUDE void BinaryTaggedParser::getValue(int& value)                   {value = TBin::net2Host(read<TBin::BinForm32>());}
+HEADER_ONLY_INCLUDE void BinaryTaggedParser::getValue(long int& value)              {value = TBin::net2Host(read<TBin::BinForm64>());}
+HEADER_ONLY_INCLUDE void BinaryTaggedParser::getValue(long long int& value)         {value = static_cast<unsigned long long int>(TBin::net2Host(read<TBin::BinForm128>()));}
+
+HEADER_ONLY_INCLUDE void BinaryTaggedParser::getValue(unsigned short int& value)    {value = TBin::net2Host(read<TBin::BinForm16>());}
+HEADER_ONLY_INCLUDE void BinaryTaggedParser::getValue(unsigned int& value)          {value = TBin::net2Host(read<TBin::BinForm32>());}
+HEADER_ONLY_INCLUDE void BinaryTaggedParser::getValue(unsigned long int& value)     {value = TBin::net2Host(read<TBin::BinForm64>());}
+HEADER_ONLY_INCLUDE void BinaryTaggedParser::getValue(unsigned long long int& value){value = static_cast<unsigned long long int>(TBin::net2Host(read<TBin::BinForm128>()));}
+
+HEADER_ONLY_INCLUDE void BinaryTaggedParser::getValue(float& value)                 {value = TBin::net2HostIEEE<float>(read<TBin::BinForm32>());}
+HEADER_ONLY_INCLUDE void BinaryTaggedParser::getValue(double& value)                {value = TBin::net2HostIEEE<double>(read<TBin::BinForm64>());}
+HEADER_ONLY_INCLUDE void BinaryTaggedParser::getValue(long double& value)           {value = TBin::net2HostIEEE<long double>(read<TBin::BinForm128>());}
+
+HEADER_ONLY_INCLUDE void BinaryTaggedParser::getValue(bool& value)                  {value = read<unsigned char>();}
+
+HEADER_ONLY_INCLUDE void BinaryTaggedParser::getValue(std::string& value)           {value = readString();}
+
+HEADER_ONLY_INCLUDE
+bool BinaryTaggedParser::isValueNull()
+{
+    throw std::runtime_error("ThorsAnvil::Serialize::BinaryTaggedParser::isValueNull Not Implemented");
+}
+
+HEADER_ONLY_INCLUDE
+std::string BinaryTaggedParser::getRawValue()
+{
+    return readString();
+}
+
+#endif
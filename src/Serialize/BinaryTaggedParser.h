@@ -0,0 +1,292 @@
+#ifndef THORS_ANVIL_SERIALIZE_BINARY_TAGGED_PARSER_H
+#define THORS_ANVIL_SERIALIZE_BINARY_TAGGED_PARSER_H
+/*
+ * BinaryTaggedParser
+ *      This is used in conjunction with BinaryTaggedPrinter
+ *
+ *      Together these provide a binary format that (unlike BinaryParser<T>) allows
+ *      the writer and reader to use different versions of a type.
+ *
+ *      Values are encoded exactly as BinaryPrinter<T> encodes them (network byte order).
+ *      Arrays are a 32 bit count followed by the elements.
+ *      Maps are a sequence of fields terminated by a zero byte. Each field is:
+ *
+ *          <Tag (varint)> <Size of value in bytes (32 bit)> <Value>
+ *
+ *          Tag even:   The field id (2 * id). The id is the position (1 based) of the member
+ *                      in the order Traits<T> prints them (parent members first).
+ *          Tag odd:    The key is written as text (2 * length + 1) followed by the key.
+ *                      Used for hand written Traits and maps with std::string keys.
+ *
+ *      The parser uses a TaggedSchema built from Traits<T> to convert a field id
+ *      back into a member name. A field the reader does not know about is skipped
+ *      using its size. A member missing from the stream is left untouched.
+ *
+ *      Note: The field id is the member position. So new members should be added
+ *            at the end of the Traits declaration (and not to a parent that has
+ *            already been used as a base of other types).
+ *
+ *      The positional BinaryParser<T>/BinaryPrinter<T> are unchanged and remain the
+ *      faster option when the reader and writer are known to use the same type.
+ */
+
+#ifdef NETWORK_BYTE_ORDER
+
+#include "Serialize.h"
+#include "ThorBinaryRep/BinaryRep.h"
+#include <istream>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <typeindex>
+#include <type_traits>
+
+namespace TBin  = ThorsAnvil::BinaryRep;
+namespace ThorsAnvil
+{
+    namespace Serialize
+    {
+
+/*
+ * Description of a type used by the BinaryTaggedParser.
+ */
+struct TaggedSchema
+{
+    enum class Kind {Value, Map, DynamicMap, Array};
+
+    Kind                                kind        = Kind::Value;
+    std::vector<std::string>            keys;                       // Map: Member names in print order.
+    std::vector<TaggedSchema const*>    members;                    // Map: Schema of each member.
+    TaggedSchema const*                 element     = nullptr;      // Array: element. DynamicMap: value.
+
+    std::size_t findKey(std::string const& key) const;
+};
+
+/*
+ * Builds the TaggedSchema for a type from its Traits.
+ * Each type is only built once (so recursive types work).
+ */
+class TaggedSchemaBuilder
+{
+    std::map<std::type_index, std::unique_ptr<TaggedSchema>>    nodes;
+
+    template<typename T>
+    void addMembers(TaggedSchema& node);
+    template<typename T, typename P>
+    void addParent(TaggedSchema& node, P*);
+    template<typename T, typename... P>
+    void addParent(TaggedSchema& node, Parents<P...>*);
+
+    template<typename T, typename... Members, std::size_t... Seq>
+    void addTuple(TaggedSchema& node, std::tuple<Members...> const& members, std::index_sequence<Seq...> const&);
+    template<typename T, typename... Members>
+    void addMemberList(TaggedSchema& node, std::tuple<Members...> const& members);
+    template<typename T, typename Action>
+    void addMemberList(TaggedSchema& node, Action const&);
+
+    void addMember(TaggedSchema&, void*) {}
+    template<typename O, typename M>
+    void addMember(TaggedSchema& node, std::pair<char const*, M O::*> const& member);
+    template<typename M>
+    void addMember(TaggedSchema& node, std::pair<char const*, M*> const& member);
+
+    template<typename T>
+    TaggedSchema const* buildElement(...);
+    template<typename T>
+    TaggedSchema const* buildElement(typename T::value_type*);
+    template<typename T>
+    TaggedSchema const* buildMapped(...);
+    template<typename T>
+    TaggedSchema const* buildMapped(typename T::mapped_type*);
+    public:
+        template<typename T>
+        TaggedSchema const* build();
+};
+
+template<typename T>
+TaggedSchema const& taggedSchema()
+{
+    static TaggedSchemaBuilder  builder;
+    static TaggedSchema const&  schema = *builder.build<T>();
+    return schema;
+}
+
+class BinaryTaggedParser: public ParserInterface
+{
+    enum class Stage {DocStart, Root, Body, DocEnd, Done};
+    struct Frame
+    {
+        TaggedSchema const*     node;
+        std::size_t             remaining;  // Elements left in an array.
+    };
+
+    TaggedSchema const&     root;
+    std::vector<Frame>      state;
+    Stage                   stage;
+    TaggedSchema const*     pending;        // Schema of the value whose key was returned.
+    std::size_t             fieldSize;
+    std::string             key;
+
+    template<typename Obj>
+    Obj             read();
+    std::size_t     readVarint();
+    std::string     readText(std::size_t size);
+    std::string     readString();
+    void            skip(std::size_t size);
+    ParserToken     startValue(TaggedSchema const* node);
+    ParserToken     endContainer(ParserToken token);
+    protected:
+        virtual void    ignoreTheValue()                        override;
+    public:
+        BinaryTaggedParser(std::istream& stream, ParserConfig config, TaggedSchema const& root);
+        virtual ParserToken getNextToken()                      override;
+        virtual std::string getKey()                            override;
+
+        virtual void    getValue(short int& value)              override;
+        virtual void    getValue(int& value)                    override;
+        virtual void    getValue(long int& value)               override;
+        virtual void    getValue(long long int& value)          override;
+
+        virtual void    getValue(unsigned short int& value)     override;
+        virtual void    getValue(unsigned int& value)           override;
+        virtual void    getValue(unsigned long int& value)      override;
+        virtual void    getValue(unsigned long long int& value) override;
+
+        virtual void    getValue(float& value)                  override;
+        virtual void    getValue(double& value)                 override;
+        virtual void    getValue(long double& value)            override;
+
+        virtual void    getValue(bool& value)                   override;
+
+        virtual void    getValue(std::string& value)            override;
+        using ParserInterface::getValue;                        // Overloads that are not virtual.
+
+        virtual bool    isValueNull()                           override;
+
+        virtual std::string getRawValue()                       override;
+
+        virtual bool    isBinary() const                        override {return true;}
+};
+
+/* ------------ TaggedSchemaBuilder ------------------------- */
+
+template<typename T>
+TaggedSchema const* TaggedSchemaBuilder::build()
+{
+    using Type = typename std::remove_cv<T>::type;
+
+    auto find = nodes.find(typeid(Type));
+    if (find != nodes.end())
+    {
+        return find->second.get();
+    }
+    // Add the node before the members are built.
+    // So a member that refers back to this type finds it.
+    TaggedSchema&   node = *(nodes[typeid(Type)] = std::make_unique<TaggedSchema>());
+
+    constexpr TraitType type = Traits<Type>::type;
+    if constexpr (type == TraitType::Map || type == TraitType::Parent)
+    {
+        node.kind = TaggedSchema::Kind::Map;
+        addMembers<Type>(node);
+    }
+    else if constexpr (type == TraitType::Array)
+    {
+        node.kind       = TaggedSchema::Kind::Array;
+        node.element    = buildElement<Type>(nullptr);
+    }
+    return &node;
+}
+
+template<typename T>
+void TaggedSchemaBuilder::addMembers(TaggedSchema& node)
+{
+    // Parent members are printed first.
+    if constexpr (Traits<T>::type == TraitType::Parent)
+    {
+        addParent<T>(node, static_cast<typename Traits<T>::Parent*>(nullptr));
+    }
+    addMemberList<T>(node, Traits<T>::getMembers());
+}
+
+template<typename T, typename P>
+void TaggedSchemaBuilder::addParent(TaggedSchema& node, P*)
+{
+    addMembers<P>(node);
+}
+
+template<typename T, typename... P>
+void TaggedSchemaBuilder::addParent(TaggedSchema& node, Parents<P...>*)
+{
+    auto discard = {1, (addMembers<P>(node), 1)...};
+    (void)discard;
+}
+
+template<typename T, typename... Members, std::size_t... Seq>
+void TaggedSchemaBuilder::addTuple(TaggedSchema& node, std::tuple<Members...> const& members, std::index_sequence<Seq...> const&)
+{
+    auto discard = {1, (addMember(node, std::get<Seq>(members)), 1)...};
+    (void)discard;
+}
+
+template<typename T, typename... Members>
+void TaggedSchemaBuilder::addMemberList(TaggedSchema& node, std::tuple<Members...> const& members)
+{
+    addTuple<T>(node, members, std::make_index_sequence<sizeof...(Members)>());
+}
+
+template<typename T, typename Action>
+void TaggedSchemaBuilder::addMemberList(TaggedSchema& node, Action const&)
+{
+    // The keys are generated by the object (eg std::map<std::string, V>)
+    // So they are written as text.
+    node.kind       = TaggedSchema::Kind::DynamicMap;
+    node.element    = buildMapped<T>(nullptr);
+}
+
+template<typename O, typename M>
+void TaggedSchemaBuilder::addMember(TaggedSchema& node, std::pair<char const*, M O::*> const& member)
+{
+    node.keys.emplace_back(member.first);
+    node.members.emplace_back(build<M>());
+}
+
+template<typename M>
+void TaggedSchemaBuilder::addMember(TaggedSchema& node, std::pair<char const*, M*> const& member)
+{
+    node.keys.emplace_back(member.first);
+    node.members.emplace_back(build<M>());
+}
+
+template<typename T>
+TaggedSchema const* TaggedSchemaBuilder::buildElement(...)
+{
+    // Arrays of different types (std::tuple) are not supported.
+    return nullptr;
+}
+template<typename T>
+TaggedSchema const* TaggedSchemaBuilder::buildElement(typename T::value_type*)
+{
+    return build<typename T::value_type>();
+}
+template<typename T>
+TaggedSchema const* TaggedSchemaBuilder::buildMapped(...)
+{
+    return nullptr;
+}
+template<typename T>
+TaggedSchema const* TaggedSchemaBuilder::buildMapped(typename T::mapped_type*)
+{
+    return build<typename T::mapped_type>();
+}
+
+    }
+}
+
+#if defined(HEADER_ONLY) && HEADER_ONLY == 1
+#include "BinaryTaggedParser.source"
+#endif
+
+#endif
+#endif
@@ -0,0 +1,161 @@
+#include "SerializeConfig.h"
+#ifdef NETWORK_BYTE_ORDER
+#include "BinaryTaggedPrinter.h"
+#include <limits>
+
+using namespace ThorsAnvil::Serialize;
+
+HEADER_ONLY_INCLUDE
+BinaryTaggedPrinter::BinaryTaggedPrinter(std::ostream& output, PrinterConfig config)
+    : PrinterInterface(output, config)
+{}
+
+template<typename Out>
+inline void BinaryTaggedPrinter::write(Out value)
+{
+    buffer.append(reinterpret_cast<char const*>(&value), sizeof(Out));
+}
+
+HEADER_ONLY_INCLUDE
+void BinaryTaggedPrinter::writeVarint(std::size_t value)
+{
+    while (value >= 0x80)
+    {
+        buffer.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<char>(value));
+}
+
+HEADER_ONLY_INCLUDE
+void BinaryTaggedPrinter::writeString(std::string const& value)
+{
+    write(TBin::host2Net(static_cast<TBin::BinForm32>(value.size())));
+    buffer.append(value);
+}
+
+HEADER_ONLY_INCLUDE
+BinaryTaggedPrinter::Frame& BinaryTaggedPrinter::currentMap(char const* method)
+{
+    if (state.empty() || !state.back().isMap)
+    {
+        throw std::runtime_error(std::string("ThorsAnvil::Serialize::BinaryTaggedPrinter::") + method + ": Currently not in a map");
+    }
+    return state.back();
+}
+
+HEADER_ONLY_INCLUDE
+void BinaryTaggedPrinter::reserveSize()
+{
+    // The size of the value is not known until it has been written.
+    // So reserve space that is filled in by endValue().
+    state.back().sizeSlot = buffer.size();
+    write(TBin::BinForm32{0});
+}
+
+HEADER_ONLY_INCLUDE
+void BinaryTaggedPrinter::endValue()
+{
+    if (state.empty())
+    {
+        output.write(buffer.data(), buffer.size());
+        buffer.clear();
+        return;
+    }
+    Frame&  top = state.back();
+    if (top.isMap)
+    {
+        std::size_t size = buffer.size() - top.sizeSlot - sizeof(TBin::BinForm32);
+        if (size > std::numeric_limits<TBin::BinForm32>::max())
+        {
+            throw std::runtime_error("ThorsAnvil::Serialize::BinaryTaggedPrinter::endValue: Field too large");
+        }
+        TBin::BinForm32 networkSize = TBin::host2Net(static_cast<TBin::BinForm32>(size));
+        buffer.replace(top.sizeSlot, sizeof(networkSize), reinterpret_cast<char const*>(&networkSize), sizeof(networkSize));
+    }
+}
+
+HEADER_ONLY_INCLUDE
+void BinaryTaggedPrinter::openDoc()
+{}
+HEADER_ONLY_INCLUDE
+void BinaryTaggedPrinter::closeDoc()
+{}
+
+HEADER_ONLY_INCLUDE
+void BinaryTaggedPrinter::openMap()
+{
+    state.push_back(Frame{true, 0, 0});
+}
+HEADER_ONLY_INCLUDE
+void BinaryTaggedPrinter::closeMap()
+{
+    currentMap("closeMap");
+    writeVarint(0);
+    state.pop_back();
+    endValue();
+}
+HEADER_ONLY_INCLUDE
+void BinaryTaggedPrinter::openArray(std::size_t size)
+{
+    write(TBin::host2Net(static_cast<TBin::BinForm32>(size)));
+    state.push_back(Frame{false, 0, 0});
+}
+HEADER_ONLY_INCLUDE
+void BinaryTaggedPrinter::closeArray()
+{
+    if (state.empty() || state.back().isMap)
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::BinaryTaggedPrinter::closeArray: Currently not in an array");
+    }
+    state.pop_back();
+    endValue();
+}
+
+HEADER_ONLY_INCLUDE
+void BinaryTaggedPrinter::addKey(std::string const& key)
+{
+    // Hand written Traits or a map with std::string keys.
+    // The key is written as text.
+    ++currentMap("addKey").keys;
+    writeVarint(key.size() * 2 + 1);
+    buffer.append(key);
+    reserveSize();
+}
+HEADER_ONLY_INCLUDE
+void BinaryTaggedPrinter::addKey(MemberKey const&)
+{
+    // Members are printed in the order of the Traits declaration.
+    // So the position of the key in the map is its id.
+    std::size_t id = ++currentMap("addKey").keys;
+    writeVarint(id * 2);
+    reserveSize();
+}
+
+HEADER_ONLY_INCLUDE void BinaryTaggedPrinter::addValue(short int value)             {write(TBin::host2Net(static_cast<TBin::BinForm16>(value)));  endValue();}
+HEADER_ONLY_INCLUDE void BinaryTaggedPrinter::addValue(int value)                   {write(TBin::host2Net(static_cast<TBin::BinForm32>(value)));  endValue();}
+HEADER_ONLY_INCLUDE void BinaryTaggedPrinter::addValue(long int value)              {write(TBin::host2Net(static_cast<TBin::BinForm64>(value)));  endValue();}
+HEADER_ONLY_INCLUDE void BinaryTaggedPrinter::addValue(long long int value)         {write(TBin::host2Net(static_cast<TBin::BinForm128>(value))); endValue();}
+
+HEADER_ONLY_INCLUDE void BinaryTaggedPrinter::addValue(unsigned short int value)    {write(TBin::host2Net(static_cast<TBin::BinForm16>(value)));  endValue();}
+HEADER_ONLY_INCLUDE void BinaryTaggedPrinter::addValue(unsigned int value)          {write(TBin::host2Net(static_cast<TBin::BinForm32>(value)));  endValue();}
+HEADER_ONLY_INCLUDE void BinaryTaggedPrinter::addValue(unsigned long int value)     {write(TBin::host2Net(static_cast<TBin::BinForm64>(value)));  endValue();}
+HEADER_ONLY_INCLUDE void BinaryTaggedPrinter::addValue(unsigned long long int value){write(TBin::host2Net(static_cast<TBin::BinForm128>(value))); endValue();}
+
+HEADER_ONLY_INCLUDE void BinaryTaggedPrinter::addValue(float value)                 {write(TBin::host2NetIEEE(value)); endValue();}
+HEADER_ONLY_INCLUDE void BinaryTaggedPrinter::addValue(double value)                {write(TBin::host2NetIEEE(value)); endValue();}
+HEADER_ONLY_INCLUDE void BinaryTaggedPrinter::addValue(long double value)           {write(TBin::host2NetIEEE(value)); endValue();}
+
+HEADER_ONLY_INCLUDE void BinaryTaggedPrinter::addValue(bool value)                  {write(static_cast<unsigned char>(value)); endValue();}
+
+HEADER_ONLY_INCLUDE void BinaryTaggedPrinter::addValue(std::string const& value)    {writeString(value); endValue();}
+
+HEADER_ONLY_INCLUDE void BinaryTaggedPrinter::addRawValue(std::string const& value) {writeString(value); endValue();}
+
+HEADER_ONLY_INCLUDE
+void BinaryTaggedPrinter::addNull()
+{
+    throw std::runtime_error("ThorsAnvil::Serialize::BinaryTaggedPrinter::addNull Not Implemented");
+}
+
+#endif
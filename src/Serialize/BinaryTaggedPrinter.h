@@ -0,0 +1,86 @@
+#ifndef THORS_ANVIL_SERIALIZE_BINARY_TAGGED_PRINTER_H
+#define THORS_ANVIL_SERIALIZE_BINARY_TAGGED_PRINTER_H
+/*
+ * BinaryTaggedPrinter
+ *  See documentation in BinaryTaggedParser.h
+ */
+
+#ifdef NETWORK_BYTE_ORDER
+
+#include "Serialize.h"
+#include "ThorBinaryRep/BinaryRep.h"
+#include <string>
+#include <vector>
+
+namespace TBin  = ThorsAnvil::BinaryRep;
+namespace ThorsAnvil
+{
+    namespace Serialize
+    {
+
+class BinaryTaggedPrinter: public PrinterInterface
+{
+    struct Frame
+    {
+        bool            isMap;
+        std::size_t     keys;       // Number of keys written to the map.
+        std::size_t     sizeSlot;   // Position of the reserved size of the current field.
+    };
+    std::vector<Frame>  state;
+    std::string         buffer;
+
+    template<typename Out>
+    void write(Out value);
+    void writeVarint(std::size_t value);
+    void writeString(std::string const& value);
+    void reserveSize();
+    void endValue();
+    Frame& currentMap(char const* method);
+    public:
+        BinaryTaggedPrinter(std::ostream& output, PrinterConfig config = PrinterConfig{});
+        virtual void openDoc()                              override;
+        virtual void closeDoc()                             override;
+
+        virtual void openMap()                              override;
+        virtual void closeMap()                             override;
+        virtual void openArray(std::size_t size)            override;
+        virtual void closeArray()                           override;
+
+        virtual void addKey(std::string const& key)         override;
+        virtual void addKey(MemberKey const& key)           override;
+
+        virtual void addValue(short int value)              override;
+        virtual void addValue(int value)                    override;
+        virtual void addValue(long int value)               override;
+        virtual void addValue(long long int value)          override;
+
+        virtual void addValue(unsigned short int value)     override;
+        virtual void addValue(unsigned int value)           override;
+        virtual void addValue(unsigned long int value)      override;
+        virtual void addValue(unsigned long long int value) override;
+
+        virtual void addValue(float value)                  override;
+        virtual void addValue(double value)                 override;
+        virtual void addValue(long double value)            override;
+
+        virtual void addValue(bool value)                   override;
+
+        virtual void addValue(std::string const& value)     override;
+        using PrinterInterface::addValue;                    // Overloads that are not virtual.
+
+        virtual void addRawValue(std::string const& value)  override;
+
+        virtual void addNull()                              override;
+
+        virtual bool isBinary() const                       override {return true;}
+};
+
+    }
+}
+
+#if defined(HEADER_ONLY) && HEADER_ONLY == 1
+#include "BinaryTaggedPrinter.source"
+#endif
+
+#endif
+#endif
@@ -0,0 +1,69 @@
+#ifndef THORS_ANVIL_SERIALIZE_BINARY_TAGGED_H
+#define THORS_ANVIL_SERIALIZE_BINARY_TAGGED_H
+/*
+ * Defines the Tagged Binary Serialization interface
+ *      ThorsAnvil::Serialize::BinaryTagged
+ *      ThorsAnvil::Serialize::binTaggedExport
+ *      ThorsAnvil::Serialize::binTaggedImport
+ *
+ * Usage:
+ *      std::cout << binTaggedExport(object); // converts object to Tagged Binary on an output stream
+ *      std::cin  >> binTaggedImport(object); // converts Tagged Binary to a C++ object from an input stream
+ *
+ * Unlike binExport()/binImport() the reader may use a different version of the type
+ * than the writer (see BinaryTaggedParser.h).
+ */
+
+#ifdef NETWORK_BYTE_ORDER
+
+#include "BinaryTaggedParser.h"
+#include "BinaryTaggedPrinter.h"
+#include "Exporter.h"
+#include "Importer.h"
+
+namespace ThorsAnvil
+{
+    namespace Serialize
+    {
+
+template<typename T>
+struct BinaryTagged
+{
+    private:
+    class BinaryTaggedParserWrapper: public BinaryTaggedParser
+    {
+        public:
+            BinaryTaggedParserWrapper(std::istream& stream, ParserInterface::ParserConfig config)
+                : BinaryTaggedParser(stream, config, taggedSchema<T>())
+            {}
+    };
+    public:
+    using Parser  = BinaryTaggedParserWrapper;
+    using Printer = BinaryTaggedPrinter;
+};
+
+// @function-api
+// @param value             The object to be serialized.
+// @param config            Printer configuration. The output type is ignored.
+// @param catchExceptions   'false:    exceptions propogate.   'true':   parsing exceptions are stopped.
+// @return                  Object that can be passed to operator<< for serialization.
+template<typename T>
+Exporter<BinaryTagged<T>, T> binTaggedExport(T const& value, PrinterInterface::PrinterConfig config = PrinterInterface::PrinterConfig{}, bool catchExceptions = false)
+{
+    return Exporter<BinaryTagged<T>, T>(value, config, catchExceptions);
+}
+// @function-api
+// @param value             The object to be de-serialized.
+// @param parseStrictness   'Weak':    ignore missing extra fields. 'Exact': Any missing fields throws exception.
+// @param catchExceptions   'false:    exceptions propogate.        'true':   parsing exceptions are stopped.
+// @return                  Object that can be passed to operator>> for de-serialization.
+template<typename T>
+Importer<BinaryTagged<T>, T> binTaggedImport(T& value, ParserInterface::ParserConfig config = ParserInterface::ParserConfig{}, bool catchExceptions = false)
+{
+    return Importer<BinaryTagged<T>, T>(value, config, catchExceptions);
+}
+    }
+}
+
+#endif
+#endif
@@ -0,0 +1,403 @@
+#include "SerializeConfig.h"
+#include "BsonParser.h"
+#include <sstream>
+#include <limits>
+#include <type_traits>
+#include <cstring>
+
+using namespace ThorsAnvil::Serialize;
+using ParserToken = ParserInterface::ParserToken;
+
+namespace
+{
+    // Element types (http://bsonspec.org/spec.html)
+    char const  bsonDouble      = 0x01;
+    char const  bsonString      = 0x02;
+    char const  bsonDocument    = 0x03;
+    char const  bsonArray       = 0x04;
+    char const  bsonBinary      = 0x05;
+    char const  bsonUndefined   = 0x06;
+    char const  bsonObjectId    = 0x07;
+    char const  bsonBool        = 0x08;
+    char const  bsonDateTime    = 0x09;
+    char const  bsonNull        = 0x0A;
+    char const  bsonInt32       = 0x10;
+    char const  bsonTimestamp   = 0x11;
+    char const  bsonInt64       = 0x12;
+}
+
+HEADER_ONLY_INCLUDE
+BsonParser::BsonParser(std::istream& stream, ParserConfig config, BsonContainer root)
+    : ParserInterface(stream, config)
+    , root(root)
+    , stage(Stage::DocStart)
+    , elementType(0)
+    , valueType(ValueType::Null)
+    , intValue(0)
+    , floatValue(0)
+{}
+
+HEADER_ONLY_INCLUDE
+int BsonParser::readByte()
+{
+    int result = input.get();
+    if (result == std::char_traits<char>::eof())
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::BsonParser::readByte: Unexpected end of input");
+    }
+    return result;
+}
+
+template<typename Int>
+inline Int BsonParser::readLittleEndian()
+{
+    using Unsigned = typename std::make_unsigned<Int>::type;
+    Unsigned    result = 0;
+    for (std::size_t loop = 0; loop < sizeof(Int); ++loop)
+    {
+        result |= static_cast<Unsigned>(readByte()) << (loop * 8);
+    }
+    return static_cast<Int>(result);
+}
+
+HEADER_ONLY_INCLUDE
+void BsonParser::readCString(std::string& output)
+{
+    if (!std::getline(input, output, '\0'))
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::BsonParser::readCString: Unexpected end of input");
+    }
+}
+
+HEADER_ONLY_INCLUDE
+void BsonParser::skip(std::size_t size)
+{
+    input.ignore(size);
+    if (static_cast<std::size_t>(input.gcount()) != size)
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::BsonParser::skip: Unexpected end of input");
+    }
+}
+
+HEADER_ONLY_INCLUDE
+ParserToken BsonParser::readValue(char type)
+{
+    switch (type)
+    {
+        case bsonDouble:
+        {
+            std::uint64_t   bits = readLittleEndian<std::uint64_t>();
+            std::memcpy(&floatValue, &bits, sizeof(floatValue));
+            valueType   = ValueType::Float;
+            return ParserToken::Value;
+        }
+        case bsonString:
+        {
+            std::int32_t    size = readLittleEndian<std::int32_t>();
+            if (size < 1)
+            {
+                throw std::runtime_error("ThorsAnvil::Serialize::BsonParser::readValue: Invalid string size");
+            }
+            if (!checkStringLength(size - 1))
+            {
+                return ParserToken::Error;
+            }
+            textValue.resize(size - 1);
+            if (size > 1 && !input.read(&textValue[0], size - 1))
+            {
+                throw std::runtime_error("ThorsAnvil::Serialize::BsonParser::readValue: Unexpected end of input");
+            }
+            if (readByte() != 0)
+            {
+                throw std::runtime_error("ThorsAnvil::Serialize::BsonParser::readValue: String not null terminated");
+            }
+            valueType   = ValueType::Text;
+            return ParserToken::Value;
+        }
+        case bsonDocument:
+            readLittleEndian<std::int32_t>();
+            state.push_back(true);
+            valueType   = ValueType::Container;
+            return ParserToken::MapStart;
+        case bsonArray:
+            readLittleEndian<std::int32_t>();
+            state.push_back(false);
+            valueType   = ValueType::Container;
+            return ParserToken::ArrayStart;
+        case bsonBinary:
+        {
+            std::int32_t    size = readLittleEndian<std::int32_t>();
+            readByte();     // Sub-type
+            if (size < 0)
+            {
+                throw std::runtime_error("ThorsAnvil::Serialize::BsonParser::readValue: Invalid binary size");
+            }
+            if (!checkStringLength(size))
+            {
+                return ParserToken::Error;
+            }
+            textValue.resize(size);
+            if (size > 0 && !input.read(&textValue[0], size))
+            {
+                throw std::runtime_error("ThorsAnvil::Serialize::BsonParser::readValue: Unexpected end of input");
+            }
+            valueType   = ValueType::Text;
+            return ParserToken::Value;
+        }
+        case bsonObjectId:
+            textValue.resize(12);
+            if (!input.read(&textValue[0], 12))
+            {
+                throw std::runtime_error("ThorsAnvil::Serialize::BsonParser::readValue: Unexpected end of input");
+            }
+            valueType   = ValueType::Text;
+            return ParserToken::Value;
+        case bsonBool:
+            intValue    = readByte();
+            valueType   = ValueType::Bool;
+            return ParserToken::Value;
+        case bsonUndefined:
+        case bsonNull:
+            valueType   = ValueType::Null;
+            return ParserToken::Value;
+        case bsonInt32:
+            intValue    = readLittleEndian<std::int32_t>();
+            valueType   = ValueType::Integer;
+            return ParserToken::Value;
+        case bsonDateTime:
+        case bsonTimestamp:
+        case bsonInt64:
+            intValue    = readLittleEndian<std::int64_t>();
+            valueType   = ValueType::Integer;
+            return ParserToken::Value;
+    }
+    throw std::runtime_error("ThorsAnvil::Serialize::BsonParser::readValue: Unsupported element type");
+}
+
+HEADER_ONLY_INCLUDE
+ParserToken BsonParser::endDocument()
+{
+    bool isMap = state.back();
+    state.pop_back();
+    if (state.empty())
+    {
+        if (root == BsonContainer::Value && readByte() != 0)
+        {
+            throw std::runtime_error("ThorsAnvil::Serialize::BsonParser::endDocument: Expected a single value in the root document");
+        }
+        stage = Stage::DocEnd;
+    }
+    return isMap ? ParserToken::MapEnd : ParserToken::ArrayEnd;
+}
+
+HEADER_ONLY_INCLUDE
+ParserToken BsonParser::getNextToken()
+{
+    switch (stage)
+    {
+        case Stage::DocStart:
+            stage = Stage::Root;
+            return ParserToken::DocStart;
+        case Stage::DocEnd:
+            stage = Stage::Done;
+            return ParserToken::DocEnd;
+        case Stage::Done:
+            return ParserToken::Error;
+        case Stage::Root:
+        {
+            stage = Stage::Body;
+            readLittleEndian<std::int32_t>();
+            if (root == BsonContainer::Map)
+            {
+                state.push_back(true);
+                valueType   = ValueType::Container;
+                return ParserToken::MapStart;
+            }
+            if (root == BsonContainer::Array)
+            {
+                state.push_back(false);
+                valueType   = ValueType::Container;
+                return ParserToken::ArrayStart;
+            }
+            // A single value wrapped in a document.
+            char type = readByte();
+            readCString(textValue);
+            ParserToken result = readValue(type);
+            if (result == ParserToken::Value)
+            {
+                if (readByte() != 0)
+                {
+                    throw std::runtime_error("ThorsAnvil::Serialize::BsonParser::getNextToken: Expected a single value in the root document");
+                }
+                stage = Stage::DocEnd;
+            }
+            return result;
+        }
+        case Stage::Body:
+            break;
+    }
+
+    if (elementType != 0)
+    {
+        // The key was returned by the last call.
+        char type   = elementType;
+        elementType = 0;
+        return readValue(type);
+    }
+
+    char type = readByte();
+    if (type == 0)
+    {
+        return endDocument();
+    }
+    readCString(textValue);
+    if (state.back())
+    {
+        elementType = type;
+        valueType   = ValueType::Text;
+        return ParserToken::Key;
+    }
+    // Array: The key is the index and is not needed.
+    return readValue(type);
+}
+
+HEADER_ONLY_INCLUDE
+void BsonParser::ignoreTheValue()
+{
+    char type   = elementType;
+    elementType = 0;
+    switch (type)
+    {
+        case 0:
+            // Not called directly after a key.
+            // Use the generic method.
+            ParserInterface::ignoreTheValue();
+            return;
+        case bsonDocument:
+        case bsonArray:
+        case bsonString:
+        {
+            // The length of a document includes the length field (and the terminating null).
+            // The length of a string does not (but includes its terminating null).
+            std::int32_t size       = readLittleEndian<std::int32_t>();
+            std::int32_t minSize    = type == bsonString ? 1 : 5;
+            if (size < minSize)
+            {
+                throw std::runtime_error("ThorsAnvil::Serialize::BsonParser::ignoreTheValue: Invalid size");
+            }
+            if (type == bsonString && !checkStringLength(size - 1))
+            {
+                return;
+            }
+            skip(type == bsonString ? size : size - 4);
+            return;
+        }
+        default:
+            readValue(type);
+            return;
+    }
+}
+
+HEADER_ONLY_INCLUDE
+std::string BsonParser::getKey()
+{
+    return textValue;
+}
+
+template<typename T>
+inline T BsonParser::getInteger()
+{
+    using Limit = std::numeric_limits<T>;
+    if (valueType == ValueType::Integer)
+    {
+        if constexpr (std::is_signed<T>::value)
+        {
+            if (intValue >= Limit::min() && intValue <= Limit::max())
+            {
+                return static_cast<T>(intValue);
+            }
+        }
+        else
+        {
+            if (intValue >= 0 && static_cast<std::uint64_t>(intValue) <= Limit::max())
+            {
+                return static_cast<T>(intValue);
+            }
+        }
+    }
+    throw std::runtime_error("ThorsAnvil::Serialize::BsonParser::getValue: Value is not an integer in range");
+}
+template<typename T>
+inline T BsonParser::getFloat()
+{
+    switch (valueType)
+    {
+        case ValueType::Float:      return static_cast<T>(floatValue);
+        case ValueType::Integer:    return static_cast<T>(intValue);
+        default:
+            break;
+    }
+    throw std::runtime_error("ThorsAnvil::Serialize::BsonParser::getValue: Value is not a number");
+}
+
+HEADER_ONLY_INCLUDE void BsonParser::getValue(short& value)                         {value = getInteger<short>();}
+HEADER_ONLY_INCLUDE void BsonParser::getValue(int& value)                           {value = getInteger<int>();}
+HEADER_ONLY_INCLUDE void BsonParser::getValue(long& value)                          {value = getInteger<long>();}
+HEADER_ONLY_INCLUDE void BsonParser::getValue(long long& value)                     {value = getInteger<long long>();}
+
+HEADER_ONLY_INCLUDE void BsonParser::getValue(unsigned short& value)                {value = getInteger<unsigned short>();}
+HEADER_ONLY_INCLUDE void BsonParser::getValue(unsigned int& value)                  {value = getInteger<unsigned int>();}
+HEADER_ONLY_INCLUDE void BsonParser::getValue(unsigned long& value)                 {value = getInteger<unsigned long>();}
+HEADER_ONLY_INCLUDE void BsonParser::getValue(unsigned long long& value)            {value = getInteger<unsigned long long>();}
+
+HEADER_ONLY_INCLUDE void BsonParser::getValue(float& value)                         {value = getFloat<float>();}
+HEADER_ONLY_INCLUDE void BsonParser::getValue(double& value)                        {value = getFloat<double>();}
+HEADER_ONLY_INCLUDE void BsonParser::getValue(long double& value)                   {value = getFloat<long double>();}
+
+HEADER_ONLY_INCLUDE
+void BsonParser::getValue(bool& value)
+{
+    if (valueType != ValueType::Bool)
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::BsonParser::getValue: Value is not a bool");
+    }
+    value = intValue != 0;
+}
+
+HEADER_ONLY_INCLUDE
+void BsonParser::getValue(std::string& value)
+{
+    if (valueType != ValueType::Text)
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::BsonParser::getValue: Value is not a string");
+    }
+    value = textValue;
+}
+
+HEADER_ONLY_INCLUDE
+bool BsonParser::isValueNull()
+{
+    return valueType == ValueType::Null;
+}
+
+HEADER_ONLY_INCLUDE
+std::string BsonParser::getRawValue()
+{
+    switch (valueType)
+    {
+        case ValueType::Text:       return textValue;
+        case ValueType::Bool:       return intValue ? "true" : "false";
+        case ValueType::Null:       return "null";
+        case ValueType::Integer:    return std::to_string(intValue);
+        case ValueType::Float:
+        {
+            std::stringstream   buffer;
+            buffer.precision(std::numeric_limits<double>::max_digits10);
+            buffer << floatValue;
+            return buffer.str();
+        }
+        case ValueType::Container:
+            break;
+    }
+    throw std::runtime_error("ThorsAnvil::Serialize::BsonParser::getRawValue: Unknown value type");
+}
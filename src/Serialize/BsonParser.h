@@ -0,0 +1,114 @@
+#ifndef THORS_ANVIL_SERIALIZE_BSON_PARSER_H
+#define THORS_ANVIL_SERIALIZE_BSON_PARSER_H
+/*
+ * BsonParser
+ *      This is used in conjunction with BsonPrinter
+ *
+ *      Together these provide an implementation of:
+ *          the ParserInterface
+ *          and PrinterInterface
+ *      for Binary Json (http://bsonspec.org/spec.html)
+ *
+ *      Each document (Map/Array) is prefixed by its length in bytes. So when
+ *      DeSerialization finds a key it does not need the parser skips the whole
+ *      value with a single seek rather than tokenizing it.
+ *
+ *      A Bson stream always contains a document. The document does not say
+ *      if it is an array or an object (and a single value must be wrapped in
+ *      a document) so the parser is told what the root is:
+ *          BsonContainer::Map      The root document is an object.
+ *          BsonContainer::Array    The root document is an array (keys are ignored).
+ *          BsonContainer::Value    The root document is {"": value} and only the value is returned.
+ *      Bson<T> (see BsonThor.h) works this out from Traits<T>.
+ *
+ *      Encoding choices made by the printer:
+ *          short/int/unsigned short:   int32
+ *          long/long long/unsigned:    int64 (unsigned values larger than int64 throw)
+ *          float/double/long double:   double
+ *          Raw values:                 String of the value as generated by operator<<
+ *
+ *      The parser also accepts: binary, ObjectId (as a string of bytes),
+ *      undefined (as null), UTC datetime and timestamp (as int64).
+ */
+
+#include "Serialize.h"
+#include <istream>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace ThorsAnvil
+{
+    namespace Serialize
+    {
+
+enum class BsonContainer {Map, Array, Value};
+
+class BsonParser: public ParserInterface
+{
+    enum class Stage     {DocStart, Root, Body, DocEnd, Done};
+    enum class ValueType {Integer, Float, Bool, Null, Text, Container};
+
+    BsonContainer           root;
+    std::vector<bool>       state;          // true for Map, false for Array.
+    Stage                   stage;
+    char                    elementType;    // Type of the element whose key was returned.
+
+    ValueType               valueType;      // Type of the last token (Container for MapStart/ArrayStart).
+    std::int64_t            intValue;
+    double                  floatValue;
+    std::string             textValue;
+
+    int             readByte();
+    template<typename Int>
+    Int             readLittleEndian();
+    void            readCString(std::string& output);
+    void            skip(std::size_t size);
+    ParserToken     readValue(char type);
+    ParserToken     endDocument();
+
+    template<typename T>
+    T getInteger();
+    template<typename T>
+    T getFloat();
+    protected:
+        virtual void    ignoreTheValue()                        override;
+    public:
+        BsonParser(std::istream& stream, ParserConfig config = ParserConfig{}, BsonContainer root = BsonContainer::Map);
+        virtual ParserToken getNextToken()                      override;
+        virtual std::string getKey()                            override;
+
+        virtual void    getValue(short int& value)              override;
+        virtual void    getValue(int& value)                    override;
+        virtual void    getValue(long int& value)               override;
+        virtual void    getValue(long long int& value)          override;
+
+        virtual void    getValue(unsigned short int& value)     override;
+        virtual void    getValue(unsigned int& value)           override;
+        virtual void    getValue(unsigned long int& value)      override;
+        virtual void    getValue(unsigned long long int& value) override;
+
+        virtual void    getValue(float& value)                  override;
+        virtual void    getValue(double& value)                 override;
+        virtual void    getValue(long double& value)            override;
+
+        virtual void    getValue(bool& value)                   override;
+
+        virtual void    getValue(std::string& value)            override;
+        using ParserInterface::getValue;                        // Overloads that are not virtual.
+
+        virtual bool    isValueNull()                           override;
+
+        virtual std::string getRawValue()                       override;
+
+        virtual bool    isBinary() const                        override {return true;}
+};
+
+    }
+}
+
+#if defined(HEADER_ONLY) && HEADER_ONLY == 1
+#include "BsonParser.source"
+#endif
+
+#endif
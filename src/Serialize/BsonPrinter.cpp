@@ -0,0 +1,246 @@
+#include "SerializeConfig.h"
+#include "BsonPrinter.h"
+#include <limits>
+#include <cstring>
+
+using namespace ThorsAnvil::Serialize;
+
+namespace
+{
+    // Element types (http://bsonspec.org/spec.html)
+    char const  bsonDouble      = 0x01;
+    char const  bsonString      = 0x02;
+    char const  bsonDocument    = 0x03;
+    char const  bsonArray       = 0x04;
+    char const  bsonBool        = 0x08;
+    char const  bsonNull        = 0x0A;
+    char const  bsonInt32       = 0x10;
+    char const  bsonInt64       = 0x12;
+}
+
+HEADER_ONLY_INCLUDE
+BsonPrinter::BsonPrinter(std::ostream& output, PrinterConfig config)
+    : PrinterInterface(output, config)
+    , rootValue(false)
+{}
+
+template<typename Int>
+inline void BsonPrinter::writeLittleEndian(Int value)
+{
+    using Unsigned = typename std::make_unsigned<Int>::type;
+    Unsigned    bits = static_cast<Unsigned>(value);
+    for (std::size_t loop = 0; loop < sizeof(Int); ++loop)
+    {
+        buffer.push_back(static_cast<char>(bits & 0xFF));
+        bits >>= 8;
+    }
+}
+
+HEADER_ONLY_INCLUDE
+void BsonPrinter::writeElement(char type)
+{
+    if (state.empty())
+    {
+        // Bson only allows a document at the top level.
+        // So a single value is written as the document {"": value}
+        // BsonParser knows to expect this from the type being read.
+        openDocument(false, 0);
+        rootValue   = true;
+        key.clear();
+    }
+    Document&   top = state.back();
+    buffer.push_back(type);
+    if (top.isArray)
+    {
+        buffer.append(std::to_string(top.index++));
+    }
+    else
+    {
+        buffer.append(key);
+    }
+    buffer.push_back('\0');
+}
+HEADER_ONLY_INCLUDE
+void BsonPrinter::endElement()
+{
+    if (rootValue)
+    {
+        rootValue = false;
+        closeDocument(false);
+    }
+}
+HEADER_ONLY_INCLUDE
+void BsonPrinter::openDocument(bool isArray, char type)
+{
+    if (!state.empty())
+    {
+        writeElement(type);
+    }
+    // Reserve space for the length.
+    // It is filled in by closeDocument().
+    state.push_back(Document{isArray, buffer.size(), 0});
+    writeLittleEndian(std::int32_t{0});
+}
+HEADER_ONLY_INCLUDE
+void BsonPrinter::closeDocument(bool isArray)
+{
+    if (state.empty() || state.back().isArray != isArray)
+    {
+        throw std::runtime_error(isArray
+            ? "ThorsAnvil::Serialize::BsonPrinter: Invalid call to closeArray(): Currently not in an array"
+            : "ThorsAnvil::Serialize::BsonPrinter: Invalid call to closeMap(): Currently not in a map");
+    }
+    buffer.push_back('\0');
+
+    std::size_t offset  = state.back().offset;
+    std::size_t size    = buffer.size() - offset;
+    if (size > static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max()))
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::BsonPrinter::closeDocument: Document too large");
+    }
+    for (std::size_t loop = 0; loop < 4; ++loop)
+    {
+        buffer[offset + loop] = static_cast<char>((size >> (loop * 8)) & 0xFF);
+    }
+    state.pop_back();
+
+    if (state.empty())
+    {
+        output.write(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+}
+HEADER_ONLY_INCLUDE
+void BsonPrinter::writeInt32(std::int32_t value)
+{
+    writeElement(bsonInt32);
+    writeLittleEndian(value);
+    endElement();
+}
+HEADER_ONLY_INCLUDE
+void BsonPrinter::writeInt64(std::int64_t value)
+{
+    writeElement(bsonInt64);
+    writeLittleEndian(value);
+    endElement();
+}
+HEADER_ONLY_INCLUDE
+void BsonPrinter::writeDouble(double value)
+{
+    std::uint64_t   bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeElement(bsonDouble);
+    writeLittleEndian(bits);
+    endElement();
+}
+HEADER_ONLY_INCLUDE
+void BsonPrinter::writeString(std::string const& value)
+{
+    writeElement(bsonString);
+    writeLittleEndian(static_cast<std::int32_t>(value.size() + 1));
+    buffer.append(value);
+    buffer.push_back('\0');
+    endElement();
+}
+
+HEADER_ONLY_INCLUDE
+void BsonPrinter::openDoc()
+{}
+HEADER_ONLY_INCLUDE
+void BsonPrinter::closeDoc()
+{}
+
+HEADER_ONLY_INCLUDE
+void BsonPrinter::openMap()
+{
+    openDocument(false, bsonDocument);
+}
+HEADER_ONLY_INCLUDE
+void BsonPrinter::closeMap()
+{
+    closeDocument(false);
+}
+HEADER_ONLY_INCLUDE
+void BsonPrinter::openArray(std::size_t)
+{
+    openDocument(true, bsonArray);
+}
+HEADER_ONLY_INCLUDE
+void BsonPrinter::closeArray()
+{
+    closeDocument(true);
+}
+
+HEADER_ONLY_INCLUDE
+void BsonPrinter::addKey(std::string const& newKey)
+{
+    if (state.empty() || state.back().isArray)
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::BsonPrinter: Invalid call to addKey(): Currently not in a map");
+    }
+    // The key is written after the element type.
+    // So it is held until the value is added.
+    key = newKey;
+}
+HEADER_ONLY_INCLUDE
+void BsonPrinter::addKey(MemberKey const& newKey)
+{
+    if (state.empty() || state.back().isArray)
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::BsonPrinter: Invalid call to addKey(): Currently not in a map");
+    }
+    key.assign(newKey.name);
+}
+
+HEADER_ONLY_INCLUDE void BsonPrinter::addValue(short value)                 {writeInt32(value);}
+HEADER_ONLY_INCLUDE void BsonPrinter::addValue(int value)                   {writeInt32(value);}
+HEADER_ONLY_INCLUDE void BsonPrinter::addValue(long value)                  {writeInt64(value);}
+HEADER_ONLY_INCLUDE void BsonPrinter::addValue(long long value)             {writeInt64(value);}
+
+HEADER_ONLY_INCLUDE void BsonPrinter::addValue(unsigned short value)        {writeInt32(value);}
+HEADER_ONLY_INCLUDE void BsonPrinter::addValue(unsigned int value)          {writeInt64(value);}
+HEADER_ONLY_INCLUDE void BsonPrinter::addValue(unsigned long value)         {addValue(static_cast<unsigned long long>(value));}
+HEADER_ONLY_INCLUDE
+void BsonPrinter::addValue(unsigned long long value)
+{
+    // Bson has no unsigned 64 bit integer.
+    if (value > static_cast<unsigned long long>(std::numeric_limits<std::int64_t>::max()))
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::BsonPrinter::addValue: Unsigned value too large for Bson int64");
+    }
+    writeInt64(static_cast<std::int64_t>(value));
+}
+
+HEADER_ONLY_INCLUDE void BsonPrinter::addValue(float value)                 {writeDouble(value);}
+HEADER_ONLY_INCLUDE void BsonPrinter::addValue(double value)                {writeDouble(value);}
+// Bson has no extended precision type.
+HEADER_ONLY_INCLUDE void BsonPrinter::addValue(long double value)           {writeDouble(static_cast<double>(value));}
+
+HEADER_ONLY_INCLUDE
+void BsonPrinter::addValue(bool value)
+{
+    writeElement(bsonBool);
+    buffer.push_back(value ? 1 : 0);
+    endElement();
+}
+
+HEADER_ONLY_INCLUDE
+void BsonPrinter::addValue(std::string const& value)
+{
+    writeString(value);
+}
+
+HEADER_ONLY_INCLUDE
+void BsonPrinter::addRawValue(std::string const& value)
+{
+    // Raw values are the text generated by operator<<
+    // So they are stored as a string and handed back to operator>> by the parser.
+    writeString(value);
+}
+
+HEADER_ONLY_INCLUDE
+void BsonPrinter::addNull()
+{
+    writeElement(bsonNull);
+    endElement();
+}
@@ -0,0 +1,87 @@
+#ifndef THORS_ANVIL_SERIALIZE_BSON_PRINTER_H
+#define THORS_ANVIL_SERIALIZE_BSON_PRINTER_H
+/*
+ * BsonPrinter
+ *  See documentation in BsonParser.h
+ */
+
+#include "Serialize.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace ThorsAnvil
+{
+    namespace Serialize
+    {
+
+class BsonPrinter: public PrinterInterface
+{
+    struct Document
+    {
+        bool            isArray;
+        std::size_t     offset;     // Position of the reserved length slot in buffer.
+        std::size_t     index;      // Next key for an array.
+    };
+    std::vector<Document>   state;
+    std::string             buffer;
+    std::string             key;
+    bool                    rootValue;
+
+    template<typename Int>
+    void writeLittleEndian(Int value);
+    void writeElement(char type);
+    void endElement();
+    void openDocument(bool isArray, char type);
+    void closeDocument(bool isArray);
+    void writeInt32(std::int32_t value);
+    void writeInt64(std::int64_t value);
+    void writeDouble(double value);
+    void writeString(std::string const& value);
+    public:
+        BsonPrinter(std::ostream& output, PrinterConfig config = PrinterConfig{});
+        virtual void openDoc()                              override;
+        virtual void closeDoc()                             override;
+
+        virtual void openMap()                              override;
+        virtual void closeMap()                             override;
+        virtual void openArray(std::size_t size)            override;
+        virtual void closeArray()                           override;
+
+        virtual void addKey(std::string const& key)         override;
+        virtual void addKey(MemberKey const& key)           override;
+
+        virtual void addValue(short int value)              override;
+        virtual void addValue(int value)                    override;
+        virtual void addValue(long int value)               override;
+        virtual void addValue(long long int value)          override;
+
+        virtual void addValue(unsigned short int value)     override;
+        virtual void addValue(unsigned int value)           override;
+        virtual void addValue(unsigned long int value)      override;
+        virtual void addValue(unsigned long long int value) override;
+
+        virtual void addValue(float value)                  override;
+        virtual void addValue(double value)                 override;
+        virtual void addValue(long double value)            override;
+
+        virtual void addValue(bool value)                   override;
+
+        virtual void addValue(std::string const& value)     override;
+        using PrinterInterface::addValue;                    // Overloads that are not virtual.
+
+        virtual void addRawValue(std::string const& value)  override;
+
+        virtual void addNull()                              override;
+
+        virtual bool isBinary() const                       override {return true;}
+};
+
+    }
+}
+
+#if defined(HEADER_ONLY) && HEADER_ONLY == 1
+#include "BsonPrinter.source"
+#endif
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef THORS_ANVIL_SERIALIZE_BSON_H
+#define THORS_ANVIL_SERIALIZE_BSON_H
+/*
+ * Defines the Bson Serialization interface
+ *      ThorsAnvil::Serialize::Bson
+ *      ThorsAnvil::Serialize::bsonExport
+ *      ThorsAnvil::Serialize::bsonImport
+ *
+ * Usage:
+ *      std::cout << bsonExport(object); // converts object to Bson on an output stream
+ *      std::cin  >> bsonImport(object); // converts Bson to a C++ object from an input stream
+ *
+ * Note: The streams should be opened in binary mode.
+ */
+
+#include "BsonParser.h"
+#include "BsonPrinter.h"
+#include "Exporter.h"
+#include "Importer.h"
+
+namespace ThorsAnvil
+{
+    namespace Serialize
+    {
+
+/*
+ * The Bson root document does not say if it is an object or an array.
+ * So work it out from the type being read.
+ */
+template<typename T, TraitType type = Traits<T>::type>
+struct BsonRootType
+{
+    static constexpr BsonContainer value = BsonContainer::Value;
+};
+template<typename T>
+struct BsonRootType<T, TraitType::Map>
+{
+    static constexpr BsonContainer value = BsonContainer::Map;
+};
+template<typename T>
+struct BsonRootType<T, TraitType::Parent>
+{
+    static constexpr BsonContainer value = BsonContainer::Map;
+};
+template<typename T>
+struct BsonRootType<T, TraitType::Array>
+{
+    static constexpr BsonContainer value = BsonContainer::Array;
+};
+template<typename T>
+struct BsonRootType<T, TraitType::Pointer>
+{
+    static constexpr BsonContainer value = BsonRootType<typename BaseTypeGetter<T>::type>::value;
+};
+
+template<typename T>
+struct Bson
+{
+    private:
+    class BsonParserWrapper: public BsonParser
+    {
+        public:
+            BsonParserWrapper(std::istream& stream, ParserInterface::ParserConfig config)
+                : BsonParser(stream, config, BsonRootType<T>::value)
+            {}
+    };
+    public:
+    using Parser  = BsonParserWrapper;
+    using Printer = BsonPrinter;
+};
+
+// @function-api
+// @param value             The object to be serialized.
+// @param config            Printer configuration. The output type is ignored (Bson has only one form).
+// @param catchExceptions   'false:    exceptions propogate.   'true':   parsing exceptions are stopped.
+// @return                  Object that can be passed to operator<< for serialization.
+template<typename T>
+Exporter<Bson<T>, T> bsonExport(T const& value, PrinterInterface::PrinterConfig config = PrinterInterface::PrinterConfig{}, bool catchExceptions = false)
+{
+    return Exporter<Bson<T>, T>(value, config, catchExceptions);
+}
+// @function-api
+// @param value             The object to be de-serialized.
+// @param parseStrictness   'Weak':    ignore missing extra fields. 'Strict': Any missing or extra fields throws exception.
+// @param catchExceptions   'false:    exceptions propogate.        'true':   parsing exceptions are stopped.
+// @return                  Object that can be passed to operator>> for de-serialization.
+template<typename T>
+Importer<Bson<T>, T> bsonImport(T& value, ParserInterface::ParserConfig config = ParserInterface::ParserConfig{}, bool catchExceptions = false)
+{
+    return Importer<Bson<T>, T>(value, config, catchExceptions);
+}
+    }
+}
+
+#endif
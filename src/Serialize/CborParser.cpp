@@ -0,0 +1,409 @@
+#include "SerializeConfig.h"
+#include "CborParser.h"
+#include <sstream>
+#include <limits>
+#include <cstring>
+#include <cmath>
+
+using namespace ThorsAnvil::Serialize;
+using ParserToken = ParserInterface::ParserToken;
+
+namespace
+{
+    // Major types (RFC 8949 section 3.1)
+    int const   cborUnsigned    = 0;
+    int const   cborNegative    = 1;
+    int const   cborBytes       = 2;
+    int const   cborText        = 3;
+    int const   cborArray       = 4;
+    int const   cborMap         = 5;
+    int const   cborTag         = 6;
+    int const   cborSimple      = 7;
+
+    int const   cborIndefinite  = 31;
+    int const   cborBreak       = 0xFF;
+
+    double decodeHalf(std::uint16_t half)
+    {
+        int     exponent    = (half >> 10) & 0x1F;
+        int     mantissa    = half & 0x3FF;
+        double  value;
+        if (exponent == 0)
+        {
+            value = std::ldexp(mantissa, -24);
+        }
+        else if (exponent != 31)
+        {
+            value = std::ldexp(mantissa + 1024, exponent - 25);
+        }
+        else
+        {
+            value = (mantissa == 0) ? std::numeric_limits<double>::infinity() : std::numeric_limits<double>::quiet_NaN();
+        }
+        return (half & 0x8000) ? -value : value;
+    }
+}
+
+HEADER_ONLY_INCLUDE
+CborParser::CborParser(std::istream& stream, ParserConfig config)
+    : ParserInterface(stream, config)
+    , stage(Stage::DocStart)
+    , valueType(ValueType::Null)
+    , intValue(0)
+    , floatValue(0)
+{}
+
+HEADER_ONLY_INCLUDE
+int CborParser::readByte()
+{
+    int result = input.get();
+    if (result == std::char_traits<char>::eof())
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::CborParser::readByte: Unexpected end of input");
+    }
+    return result;
+}
+
+HEADER_ONLY_INCLUDE
+std::uint64_t CborParser::readArgument(int info)
+{
+    int size;
+    switch (info)
+    {
+        case 24:    size = 1; break;
+        case 25:    size = 2; break;
+        case 26:    size = 4; break;
+        case 27:    size = 8; break;
+        default:
+            if (info < 24)
+            {
+                return info;
+            }
+            throw std::runtime_error("ThorsAnvil::Serialize::CborParser::readArgument: Invalid additional information in initial byte");
+    }
+    std::uint64_t   result = 0;
+    for (int loop = 0; loop < size; ++loop)
+    {
+        result = (result << 8) | readByte();
+    }
+    return result;
+}
+
+HEADER_ONLY_INCLUDE
+void CborParser::readString(int major, int info, std::string& output)
+{
+    output.clear();
+    if (info != cborIndefinite)
+    {
+        std::uint64_t   size = readArgument(info);
+        if (!checkStringLength(size))
+        {
+            return;
+        }
+        output.resize(size);
+        if (!input.read(&output[0], size))
+        {
+            throw std::runtime_error("ThorsAnvil::Serialize::CborParser::readString: Unexpected end of input");
+        }
+        return;
+    }
+    // Indefinite length string: A sequence of definite length chunks terminated by a break.
+    for (int initial = readByte(); initial != cborBreak; initial = readByte())
+    {
+        if ((initial >> 5) != major || (initial & 0x1F) == cborIndefinite)
+        {
+            throw std::runtime_error("ThorsAnvil::Serialize::CborParser::readString: Invalid chunk in indefinite length string");
+        }
+        std::uint64_t   size    = readArgument(initial & 0x1F);
+        std::size_t     offset  = output.size();
+        if (!checkStringLength(size, offset))
+        {
+            return;
+        }
+        output.resize(offset + size);
+        if (!input.read(&output[offset], size))
+        {
+            throw std::runtime_error("ThorsAnvil::Serialize::CborParser::readString: Unexpected end of input");
+        }
+    }
+}
+
+HEADER_ONLY_INCLUDE
+ParserToken CborParser::readItem()
+{
+    int initial = readByte();
+    // Tags add semantic information we do not use.
+    // Skip the tag numbers and use the tagged item.
+    // Note: A loop (not recursion) so a long run of tags can not overflow the stack.
+    while ((initial >> 5) == cborTag)
+    {
+        readArgument(initial & 0x1F);
+        initial = readByte();
+    }
+    int major   = initial >> 5;
+    int info    = initial & 0x1F;
+
+    switch (major)
+    {
+        case cborUnsigned:
+            valueType   = ValueType::Unsigned;
+            intValue    = readArgument(info);
+            return ParserToken::Value;
+        case cborNegative:
+            valueType   = ValueType::Negative;
+            intValue    = readArgument(info);
+            return ParserToken::Value;
+        case cborBytes:
+        case cborText:
+            valueType   = ValueType::Text;
+            readString(major, info, textValue);
+            return ParserToken::Value;
+        case cborArray:
+        {
+            bool            indefinite  = info == cborIndefinite;
+            std::uint64_t   size        = indefinite ? 0 : readArgument(info);
+            state.push_back(Container{false, indefinite, size, false});
+            valueType   = ValueType::Container;
+            return ParserToken::ArrayStart;
+        }
+        case cborMap:
+        {
+            bool            indefinite  = info == cborIndefinite;
+            std::uint64_t   size        = indefinite ? 0 : readArgument(info);
+            state.push_back(Container{true, indefinite, size, true});
+            valueType   = ValueType::Container;
+            return ParserToken::MapStart;
+        }
+        case cborTag:
+            // Skipped above.
+            break;
+        case cborSimple:
+            break;
+    }
+    switch (info)
+    {
+        case 20:
+        case 21:
+            valueType   = ValueType::Bool;
+            intValue    = (info == 21);
+            return ParserToken::Value;
+        case 22:
+        case 23:
+            valueType   = ValueType::Null;
+            return ParserToken::Value;
+        case 25:
+            valueType   = ValueType::Float;
+            floatValue  = decodeHalf(static_cast<std::uint16_t>(readArgument(info)));
+            return ParserToken::Value;
+        case 26:
+        {
+            valueType   = ValueType::Float;
+            std::uint32_t   bits = static_cast<std::uint32_t>(readArgument(info));
+            float           value;
+            std::memcpy(&value, &bits, sizeof(value));
+            floatValue  = value;
+            return ParserToken::Value;
+        }
+        case 27:
+        {
+            valueType   = ValueType::Float;
+            std::uint64_t   bits = readArgument(info);
+            std::memcpy(&floatValue, &bits, sizeof(floatValue));
+            return ParserToken::Value;
+        }
+        case cborIndefinite:
+            throw std::runtime_error("ThorsAnvil::Serialize::CborParser::readItem: Unexpected break");
+    }
+    throw std::runtime_error("ThorsAnvil::Serialize::CborParser::readItem: Unsupported simple value");
+}
+
+HEADER_ONLY_INCLUDE
+ParserToken CborParser::endContainer()
+{
+    bool isMap = state.back().isMap;
+    state.pop_back();
+    if (state.empty())
+    {
+        stage = Stage::DocEnd;
+    }
+    return isMap ? ParserToken::MapEnd : ParserToken::ArrayEnd;
+}
+
+HEADER_ONLY_INCLUDE
+ParserToken CborParser::getNextToken()
+{
+    switch (stage)
+    {
+        case Stage::DocStart:
+            stage = Stage::Body;
+            return ParserToken::DocStart;
+        case Stage::DocEnd:
+            stage = Stage::Done;
+            return ParserToken::DocEnd;
+        case Stage::Done:
+            return ParserToken::Error;
+        case Stage::Body:
+            break;
+    }
+
+    if (state.empty())
+    {
+        // The root item.
+        ParserToken result = readItem();
+        if (result == ParserToken::Value)
+        {
+            stage = Stage::DocEnd;
+        }
+        return result;
+    }
+
+    Container&  top = state.back();
+    if (!top.isMap || top.expectKey)
+    {
+        // Check for the end of the container before reading the next element/key.
+        bool atEnd = top.indefinite ? (input.peek() == cborBreak) : (top.remaining == 0);
+        if (atEnd)
+        {
+            if (top.indefinite)
+            {
+                input.get();
+            }
+            return endContainer();
+        }
+    }
+    if (top.isMap && top.expectKey)
+    {
+        int initial = readByte();
+        if ((initial >> 5) != cborText)
+        {
+            throw std::runtime_error("ThorsAnvil::Serialize::CborParser::getNextToken: Map keys must be text strings");
+        }
+        readString(cborText, initial & 0x1F, textValue);
+        valueType       = ValueType::Text;
+        top.expectKey   = false;
+        return ParserToken::Key;
+    }
+
+    // Note: Count the element before reading it as reading may push a new container.
+    if (top.isMap)
+    {
+        top.expectKey = true;
+    }
+    if (!top.indefinite)
+    {
+        --top.remaining;
+    }
+    return readItem();
+}
+
+HEADER_ONLY_INCLUDE
+std::string CborParser::getKey()
+{
+    return textValue;
+}
+
+template<typename T>
+inline T CborParser::getSigned()
+{
+    using Limit = std::numeric_limits<T>;
+    if (valueType == ValueType::Unsigned && intValue <= static_cast<std::uint64_t>(Limit::max()))
+    {
+        return static_cast<T>(intValue);
+    }
+    // Encoded value is -1 - intValue
+    if (valueType == ValueType::Negative && intValue <= static_cast<std::uint64_t>(Limit::max()))
+    {
+        return static_cast<T>(-1 - static_cast<T>(intValue));
+    }
+    throw std::runtime_error("ThorsAnvil::Serialize::CborParser::getValue: Value is not an integer in range");
+}
+template<typename T>
+inline T CborParser::getUnsigned()
+{
+    if (valueType == ValueType::Unsigned && intValue <= std::numeric_limits<T>::max())
+    {
+        return static_cast<T>(intValue);
+    }
+    throw std::runtime_error("ThorsAnvil::Serialize::CborParser::getValue: Value is not an unsigned integer in range");
+}
+template<typename T>
+inline T CborParser::getFloat()
+{
+    switch (valueType)
+    {
+        case ValueType::Float:      return static_cast<T>(floatValue);
+        case ValueType::Unsigned:   return static_cast<T>(intValue);
+        case ValueType::Negative:   return -1 - static_cast<T>(intValue);
+        default:
+            break;
+    }
+    throw std::runtime_error("ThorsAnvil::Serialize::CborParser::getValue: Value is not a number");
+}
+
+HEADER_ONLY_INCLUDE void CborParser::getValue(short& value)                         {value = getSigned<short>();}
+HEADER_ONLY_INCLUDE void CborParser::getValue(int& value)                           {value = getSigned<int>();}
+HEADER_ONLY_INCLUDE void CborParser::getValue(long& value)                          {value = getSigned<long>();}
+HEADER_ONLY_INCLUDE void CborParser::getValue(long long& value)                     {value = getSigned<long long>();}
+
+HEADER_ONLY_INCLUDE void CborParser::getValue(unsigned short& value)                {value = getUnsigned<unsigned short>();}
+HEADER_ONLY_INCLUDE void CborParser::getValue(unsigned int& value)                  {value = getUnsigned<unsigned int>();}
+HEADER_ONLY_INCLUDE void CborParser::getValue(unsigned long& value)                 {value = getUnsigned<unsigned long>();}
+HEADER_ONLY_INCLUDE void CborParser::getValue(unsigned long long& value)            {value = getUnsigned<unsigned long long>();}
+
+HEADER_ONLY_INCLUDE void CborParser::getValue(float& value)                         {value = getFloat<float>();}
+HEADER_ONLY_INCLUDE void CborParser::getValue(double& value)                        {value = getFloat<double>();}
+HEADER_ONLY_INCLUDE void CborParser::getValue(long double& value)                   {value = getFloat<long double>();}
+
+HEADER_ONLY_INCLUDE
+void CborParser::getValue(bool& value)
+{
+    if (valueType != ValueType::Bool)
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::CborParser::getValue: Value is not a bool");
+    }
+    value = intValue != 0;
+}
+
+HEADER_ONLY_INCLUDE
+void CborParser::getValue(std::string& value)
+{
+    if (valueType != ValueType::Text)
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::CborParser::getValue: Value is not a string");
+    }
+    value = textValue;
+}
+
+HEADER_ONLY_INCLUDE
+bool CborParser::isValueNull()
+{
+    return valueType == ValueType::Null;
+}
+
+HEADER_ONLY_INCLUDE
+std::string CborParser::getRawValue()
+{
+    switch (valueType)
+    {
+        case ValueType::Text:       return textValue;
+        case ValueType::Bool:       return intValue ? "true" : "false";
+        case ValueType::Null:       return "null";
+        case ValueType::Unsigned:   return std::to_string(intValue);
+        case ValueType::Negative:
+            if (intValue == std::numeric_limits<std::uint64_t>::max())
+            {
+                return "-18446744073709551616";
+            }
+            return "-" + std::to_string(intValue + 1);
+        case ValueType::Float:
+        {
+            std::stringstream   buffer;
+            buffer.precision(std::numeric_limits<double>::max_digits10);
+            buffer << floatValue;
+            return buffer.str();
+        }
+        case ValueType::Container:
+            break;
+    }
+    throw std::runtime_error("ThorsAnvil::Serialize::CborParser::getRawValue: Unknown value type");
+}
@@ -0,0 +1,112 @@
+#ifndef THORS_ANVIL_SERIALIZE_CBOR_PARSER_H
+#define THORS_ANVIL_SERIALIZE_CBOR_PARSER_H
+/*
+ * CborParser
+ *      This is used in conjunction with CborPrinter
+ *
+ *      Together these provide an implementation of:
+ *          the ParserInterface
+ *          and PrinterInterface
+ *      for the Concise Binary Object Representation (CBOR RFC 8949).
+ *
+ *      Unlike the Binary format this is self describing. Keys are written
+ *      for each member so fields can be added/removed/re-ordered and the
+ *      data can be read by any other CBOR implementation.
+ *
+ *      Encoding choices made by the printer:
+ *          Integers:       Smallest encoding that holds the value (major type 0/1).
+ *          float/double:   IEEE 754 single/double (long double is written as double).
+ *          Strings/Keys:   Text strings (major type 3).
+ *          Arrays:         Definite length (the size passed to openArray()).
+ *          Maps:           Indefinite length (terminated by a break).
+ *          Raw values:     Text string of the value as generated by operator<<
+ *
+ *      The parser accepts any well formed CBOR document:
+ *          Definite or indefinite length maps/arrays/strings.
+ *          Half/single/double precision floats.
+ *          Tags are skipped (the tagged value is used).
+ *          Map keys must be text strings.
+ */
+
+#include "Serialize.h"
+#include <istream>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace ThorsAnvil
+{
+    namespace Serialize
+    {
+
+class CborParser: public ParserInterface
+{
+    enum class Stage     {DocStart, Body, DocEnd, Done};
+    enum class ValueType {Unsigned, Negative, Float, Bool, Null, Text, Container};
+    struct Container
+    {
+        bool            isMap;
+        bool            indefinite;
+        std::uint64_t   remaining;
+        bool            expectKey;
+    };
+
+    std::vector<Container>  state;
+    Stage                   stage;
+
+    ValueType               valueType;      // Type of the last token (Container for MapStart/ArrayStart).
+    std::uint64_t           intValue;
+    double                  floatValue;
+    std::string             textValue;
+
+    int             readByte();
+    std::uint64_t   readArgument(int info);
+    void            readString(int major, int info, std::string& output);
+    ParserToken     readItem();
+    ParserToken     endContainer();
+
+    template<typename T>
+    T getSigned();
+    template<typename T>
+    T getUnsigned();
+    template<typename T>
+    T getFloat();
+    public:
+        CborParser(std::istream& stream, ParserConfig config = ParserConfig{});
+        virtual ParserToken getNextToken()                      override;
+        virtual std::string getKey()                            override;
+
+        virtual void    getValue(short int& value)              override;
+        virtual void    getValue(int& value)                    override;
+        virtual void    getValue(long int& value)               override;
+        virtual void    getValue(long long int& value)          override;
+
+        virtual void    getValue(unsigned short int& value)     override;
+        virtual void    getValue(unsigned int& value)           override;
+        virtual void    getValue(unsigned long int& value)      override;
+        virtual void    getValue(unsigned long long int& value) override;
+
+        virtual void    getValue(float& value)                  override;
+        virtual void    getValue(double& value)                 override;
+        virtual void    getValue(long double& value)            override;
+
+        virtual void    getValue(bool& value)                   override;
+
+        virtual void    getValue(std::string& value)            override;
+        using ParserInterface::getValue;                        // Overloads that are not virtual.
+
+        virtual bool    isValueNull()                           override;
+
+        virtual std::string getRawValue()                       override;
+
+        virtual bool    isBinary() const                        override {return true;}
+};
+
+    }
+}
+
+#if defined(HEADER_ONLY) && HEADER_ONLY == 1
+#include "CborParser.source"
+#endif
+
+#endif
@@ -0,0 +1,247 @@
+#include "SerializeConfig.h"
+#include "CborPrinter.h"
+#include <cstring>
+
+using namespace ThorsAnvil::Serialize;
+
+namespace
+{
+    // Major types (RFC 8949 section 3.1)
+    int const   cborUnsigned    = 0;
+    int const   cborNegative    = 1;
+    int const   cborText        = 3;
+    int const   cborArray       = 4;
+    int const   cborMap         = 5;
+
+    char const  cborMapIndefinite   = static_cast<char>(0xBF);
+    char const  cborBreak           = static_cast<char>(0xFF);
+    char const  cborFalse           = static_cast<char>(0xF4);
+    char const  cborTrue            = static_cast<char>(0xF5);
+    char const  cborNull            = static_cast<char>(0xF6);
+    char const  cborFloat32         = static_cast<char>(0xFA);
+    char const  cborFloat64         = static_cast<char>(0xFB);
+
+    std::size_t const   unknownSize = static_cast<std::size_t>(-1);
+
+    template<typename Int>
+    void writeBigEndian(std::ostream& output, Int value)
+    {
+        char    buffer[sizeof(Int)];
+        for (std::size_t loop = 0; loop < sizeof(Int); ++loop)
+        {
+            buffer[sizeof(Int) - 1 - loop] = static_cast<char>(value & 0xFF);
+            value >>= 8;
+        }
+        output.write(buffer, sizeof(Int));
+    }
+}
+
+HEADER_ONLY_INCLUDE
+CborPrinter::CborPrinter(std::ostream& output, PrinterConfig config)
+    : PrinterInterface(output, config)
+{}
+
+HEADER_ONLY_INCLUDE
+void CborPrinter::writeHead(int major, std::uint64_t value)
+{
+    char    type = static_cast<char>(major << 5);
+    if (value < 24)
+    {
+        output.put(static_cast<char>(type | value));
+    }
+    else if (value <= 0xFF)
+    {
+        output.put(static_cast<char>(type | 24));
+        writeBigEndian(output, static_cast<std::uint8_t>(value));
+    }
+    else if (value <= 0xFFFF)
+    {
+        output.put(static_cast<char>(type | 25));
+        writeBigEndian(output, static_cast<std::uint16_t>(value));
+    }
+    else if (value <= 0xFFFFFFFF)
+    {
+        output.put(static_cast<char>(type | 26));
+        writeBigEndian(output, static_cast<std::uint32_t>(value));
+    }
+    else
+    {
+        output.put(static_cast<char>(type | 27));
+        writeBigEndian(output, value);
+    }
+}
+HEADER_ONLY_INCLUDE
+void CborPrinter::writeString(int major, char const* value, std::size_t size)
+{
+    writeHead(major, size);
+    output.write(value, size);
+}
+HEADER_ONLY_INCLUDE
+void CborPrinter::writeSigned(std::int64_t value)
+{
+    addElement();
+    if (value < 0)
+    {
+        // Negative integers are encoded as -1 - value
+        writeHead(cborNegative, ~static_cast<std::uint64_t>(value));
+    }
+    else
+    {
+        writeHead(cborUnsigned, static_cast<std::uint64_t>(value));
+    }
+}
+HEADER_ONLY_INCLUDE
+void CborPrinter::writeUnsigned(std::uint64_t value)
+{
+    addElement();
+    writeHead(cborUnsigned, value);
+}
+HEADER_ONLY_INCLUDE
+void CborPrinter::writeFloat(float value)
+{
+    addElement();
+    std::uint32_t   bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    output.put(cborFloat32);
+    writeBigEndian(output, bits);
+}
+HEADER_ONLY_INCLUDE
+void CborPrinter::writeDouble(double value)
+{
+    addElement();
+    std::uint64_t   bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    output.put(cborFloat64);
+    writeBigEndian(output, bits);
+}
+HEADER_ONLY_INCLUDE
+void CborPrinter::addElement()
+{
+    if (!state.empty() && state.back().isArray)
+    {
+        ++state.back().count;
+    }
+}
+
+HEADER_ONLY_INCLUDE
+void CborPrinter::openDoc()
+{}
+HEADER_ONLY_INCLUDE
+void CborPrinter::closeDoc()
+{}
+
+HEADER_ONLY_INCLUDE
+void CborPrinter::openMap()
+{
+    // The number of members is not known until closeMap().
+    // So maps are always written with an indefinite length.
+    addElement();
+    output.put(cborMapIndefinite);
+    state.push_back(Container{false, unknownSize, 0});
+}
+HEADER_ONLY_INCLUDE
+void CborPrinter::closeMap()
+{
+    if (state.empty() || state.back().isArray)
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::CborPrinter: Invalid call to closeMap(): Currently not in a map");
+    }
+    state.pop_back();
+    output.put(cborBreak);
+}
+HEADER_ONLY_INCLUDE
+void CborPrinter::openArray(std::size_t size)
+{
+    addElement();
+    if (size == unknownSize)
+    {
+        output.put(static_cast<char>((cborArray << 5) | 31));
+    }
+    else
+    {
+        writeHead(cborArray, size);
+    }
+    state.push_back(Container{true, size, 0});
+}
+HEADER_ONLY_INCLUDE
+void CborPrinter::closeArray()
+{
+    if (state.empty() || !state.back().isArray)
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::CborPrinter: Invalid call to closeArray(): Currently not in an array");
+    }
+    Container   array = state.back();
+    state.pop_back();
+    if (array.expected == unknownSize)
+    {
+        output.put(cborBreak);
+    }
+    else if (array.expected != array.count)
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::CborPrinter: Invalid call to closeArray(): Number of elements does not match the size passed to openArray()");
+    }
+}
+
+HEADER_ONLY_INCLUDE
+void CborPrinter::addKey(std::string const& key)
+{
+    if (state.empty() || state.back().isArray)
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::CborPrinter: Invalid call to addKey(): Currently not in a map");
+    }
+    writeString(cborText, key.data(), key.size());
+}
+HEADER_ONLY_INCLUDE
+void CborPrinter::addKey(MemberKey const& key)
+{
+    if (state.empty() || state.back().isArray)
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::CborPrinter: Invalid call to addKey(): Currently not in a map");
+    }
+    writeString(cborText, key.name, std::strlen(key.name));
+}
+
+HEADER_ONLY_INCLUDE void CborPrinter::addValue(short value)                 {writeSigned(value);}
+HEADER_ONLY_INCLUDE void CborPrinter::addValue(int value)                   {writeSigned(value);}
+HEADER_ONLY_INCLUDE void CborPrinter::addValue(long value)                  {writeSigned(value);}
+HEADER_ONLY_INCLUDE void CborPrinter::addValue(long long value)             {writeSigned(value);}
+
+HEADER_ONLY_INCLUDE void CborPrinter::addValue(unsigned short value)        {writeUnsigned(value);}
+HEADER_ONLY_INCLUDE void CborPrinter::addValue(unsigned int value)          {writeUnsigned(value);}
+HEADER_ONLY_INCLUDE void CborPrinter::addValue(unsigned long value)         {writeUnsigned(value);}
+HEADER_ONLY_INCLUDE void CborPrinter::addValue(unsigned long long value)    {writeUnsigned(value);}
+
+HEADER_ONLY_INCLUDE void CborPrinter::addValue(float value)                 {writeFloat(value);}
+HEADER_ONLY_INCLUDE void CborPrinter::addValue(double value)                {writeDouble(value);}
+// CBOR has no extended precision type.
+HEADER_ONLY_INCLUDE void CborPrinter::addValue(long double value)           {writeDouble(static_cast<double>(value));}
+
+HEADER_ONLY_INCLUDE
+void CborPrinter::addValue(bool value)
+{
+    addElement();
+    output.put(value ? cborTrue : cborFalse);
+}
+
+HEADER_ONLY_INCLUDE
+void CborPrinter::addValue(std::string const& value)
+{
+    addElement();
+    writeString(cborText, value.data(), value.size());
+}
+
+HEADER_ONLY_INCLUDE
+void CborPrinter::addRawValue(std::string const& value)
+{
+    // Raw values are the text generated by operator<<
+    // So they are stored as text and handed back to operator>> by the parser.
+    addElement();
+    writeString(cborText, value.data(), value.size());
+}
+
+HEADER_ONLY_INCLUDE
+void CborPrinter::addNull()
+{
+    addElement();
+    output.put(cborNull);
+}
@@ -0,0 +1,80 @@
+#ifndef THORS_ANVIL_SERIALIZE_CBOR_PRINTER_H
+#define THORS_ANVIL_SERIALIZE_CBOR_PRINTER_H
+/*
+ * CborPrinter
+ *  See documentation in CborParser.h
+ */
+
+#include "Serialize.h"
+#include <vector>
+#include <cstdint>
+
+namespace ThorsAnvil
+{
+    namespace Serialize
+    {
+
+class CborPrinter: public PrinterInterface
+{
+    struct Container
+    {
+        bool            isArray;
+        std::size_t     expected;
+        std::size_t     count;
+    };
+    std::vector<Container>  state;
+
+    void writeHead(int major, std::uint64_t value);
+    void writeString(int major, char const* value, std::size_t size);
+    void writeSigned(std::int64_t value);
+    void writeUnsigned(std::uint64_t value);
+    void writeFloat(float value);
+    void writeDouble(double value);
+    void addElement();
+    public:
+        CborPrinter(std::ostream& output, PrinterConfig config = PrinterConfig{});
+        virtual void openDoc()                              override;
+        virtual void closeDoc()                             override;
+
+        virtual void openMap()                              override;
+        virtual void closeMap()                             override;
+        virtual void openArray(std::size_t size)            override;
+        virtual void closeArray()                           override;
+
+        virtual void addKey(std::string const& key)         override;
+        virtual void addKey(MemberKey const& key)           override;
+
+        virtual void addValue(short int value)              override;
+        virtual void addValue(int value)                    override;
+        virtual void addValue(long int value)               override;
+        virtual void addValue(long long int value)          override;
+
+        virtual void addValue(unsigned short int value)     override;
+        virtual void addValue(unsigned int value)           override;
+        virtual void addValue(unsigned long int value)      override;
+        virtual void addValue(unsigned long long int value) override;
+
+        virtual void addValue(float value)                  override;
+        virtual void addValue(double value)                 override;
+        virtual void addValue(long double value)            override;
+
+        virtual void addValue(bool value)                   override;
+
+        virtual void addValue(std::string const& value)     override;
+        using PrinterInterface::addValue;                    // Overloads that are not virtual.
+
+        virtual void addRawValue(std::string const& value)  override;
+
+        virtual void addNull()                              override;
+
+        virtual bool isBinary() const                       override {return true;}
+};
+
+    }
+}
+
+#if defined(HEADER_ONLY) && HEADER_ONLY == 1
+#include "CborPrinter.source"
+#endif
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef THORS_ANVIL_SERIALIZE_CBOR_H
+#define THORS_ANVIL_SERIALIZE_CBOR_H
+/*
+ * Defines the Cbor Serialization interface
+ *      ThorsAnvil::Serialize::Cbor
+ *      ThorsAnvil::Serialize::cborExport
+ *      ThorsAnvil::Serialize::cborImport
+ *
+ * Usage:
+ *      std::cout << cborExport(object); // converts object to Cbor on an output stream
+ *      std::cin  >> cborImport(object); // converts Cbor to a C++ object from an input stream
+ *
+ * Note: The streams should be opened in binary mode.
+ */
+
+#include "CborParser.h"
+#include "CborPrinter.h"
+#include "Exporter.h"
+#include "Importer.h"
+
+namespace ThorsAnvil
+{
+    namespace Serialize
+    {
+
+struct Cbor
+{
+    using Parser  = CborParser;
+    using Printer = CborPrinter;
+};
+
+// @function-api
+// @param value             The object to be serialized.
+// @param config            Printer configuration. The output type is ignored (Cbor has only one form).
+// @param catchExceptions   'false:    exceptions propogate.   'true':   parsing exceptions are stopped.
+// @return                  Object that can be passed to operator<< for serialization.
+template<typename T>
+Exporter<Cbor, T> cborExport(T const& value, PrinterInterface::PrinterConfig config = PrinterInterface::PrinterConfig{}, bool catchExceptions = false)
+{
+    return Exporter<Cbor, T>(value, config, catchExceptions);
+}
+// @function-api
+// @param value             The object to be de-serialized.
+// @param parseStrictness   'Weak':    ignore missing extra fields. 'Strict': Any missing or extra fields throws exception.
+// @param catchExceptions   'false:    exceptions propogate.        'true':   parsing exceptions are stopped.
+// @return                  Object that can be passed to operator>> for de-serialization.
+template<typename T>
+Importer<Cbor, T> cborImport(T& value, ParserInterface::ParserConfig config = ParserInterface::ParserConfig{}, bool catchExceptions = false)
+{
+    return Importer<Cbor, T>(value, config, catchExceptions);
+}
+    }
+}
+
+#endif
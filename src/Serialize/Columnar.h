@@ -0,0 +1,251 @@
+#ifndef THORS_ANVIL_SERIALIZE_COLUMNAR_H
+#define THORS_ANVIL_SERIALIZE_COLUMNAR_H
+/*
+ * Columnar<C> serializes a container of objects as a set of columns.
+ *
+ * Normally a container of objects is an array of maps where every
+ * element repeats every key:
+ *      [{"price": 1.5, "qty": 2}, {"price": 3.25, "qty": 7}]
+ *
+ * Wrapping the container in a Columnar object prints one array per member:
+ *      {"price": [1.5, 3.25], "qty": [2, 7]}
+ *
+ * The columns are generated from Traits<T>::getMembers() of the element type
+ * (including any parent types). Static members are not part of a column.
+ *
+ * When reading, each column is written into the elements that follow the ones
+ * already in the container when the Columnar object was created (so like a
+ * normal container the data is appended). The container is grown to fit the
+ * longest column. Keys that do not match a member are ignored.
+ *
+ * The container must support size(), resize() and operator[] (std::vector, std::deque).
+ *
+ * Usage:
+ *      std::cout << jsonExport(columnar(data));
+ *
+ *      auto    columns = columnar(data);
+ *      std::cin >> jsonImport(columns);
+ */
+
+#include "Traits.h"
+#include "Serialize.h"
+#include "SerUtil.h"
+#include <tuple>
+#include <string>
+#include <utility>
+#include <cstring>
+#include <type_traits>
+
+namespace ThorsAnvil
+{
+    namespace Serialize
+    {
+
+template<typename C>
+class Columnar
+{
+    C&              container;
+    std::size_t     base;
+    public:
+        Columnar(C& container)
+            : container(container)
+            , base(container.size())
+        {}
+        C&          getContainer() const    {return container;}
+        std::size_t getBase() const         {return base;}
+};
+
+// @function-api
+// @param container         The container of objects to be serialized as columns.
+// @return                  Object that can be passed to the Exporter/Importer of any format.
+template<typename C>
+Columnar<C> columnar(C& container)
+{
+    return Columnar<C>(container);
+}
+
+/* ------------ ColumnarMembers ------------------------- */
+/*
+ * Walks the members of the element type V (and its parents)
+ * printing or scanning one column for each member.
+ */
+template<typename V, TraitType type = Traits<V>::type>
+struct ColumnarMembers
+{
+    template<typename C>
+    static void print(PrinterInterface& printer, C const& container)
+    {
+        printMembers(printer, container, Traits<V>::getMembers(), std::make_index_sequence<std::tuple_size<typename Traits<V>::Members>::value>{});
+    }
+    template<typename C>
+    static bool scan(ParserInterface& parser, std::string const& key, C& container, std::size_t base)
+    {
+        return scanMembers(parser, key, container, base, Traits<V>::getMembers(), std::make_index_sequence<std::tuple_size<typename Traits<V>::Members>::value>{});
+    }
+
+    private:
+    template<typename C, typename Members, std::size_t... Seq>
+    static void printMembers(PrinterInterface& printer, C const& container, Members const& members, std::index_sequence<Seq...> const&)
+    {
+        auto discard = {1, (printColumn(printer, container, std::get<Seq>(members)), 1)...};
+        (void)discard;
+    }
+    template<typename C, typename Members, std::size_t... Seq>
+    static bool scanMembers(ParserInterface& parser, std::string const& key, C& container, std::size_t base, Members const& members, std::index_sequence<Seq...> const&)
+    {
+        bool found = false;
+        auto discard = {1, (found = found || scanColumn(parser, key, container, base, std::get<Seq>(members)), 1)...};
+        (void)discard;
+        return found;
+    }
+
+    template<typename C, typename M>
+    static void printColumn(PrinterInterface& printer, C const& container, std::pair<char const*, M V::*> const& memberInfo)
+    {
+        PutValueType<typename std::remove_cv<M>::type>  valuePutter(printer);
+
+        printer.addKey(memberInfo.first);
+        printer.openArray(container.size());
+        for (auto const& loop: container)
+        {
+            valuePutter.putValue(loop.*(memberInfo.second));
+        }
+        printer.closeArray();
+    }
+    template<typename C, typename M>
+    static void printColumn(PrinterInterface&, C const&, std::pair<char const*, M*> const&)
+    {
+        // Static members are not part of the objects.
+    }
+
+    template<typename C, typename M>
+    static bool scanColumn(ParserInterface& parser, std::string const& key, C& container, std::size_t base, std::pair<char const*, M V::*> const& memberInfo)
+    {
+        if (std::strcmp(key.c_str(), memberInfo.first) != 0)
+        {
+            return false;
+        }
+        if (parser.getToken() != ParserInterface::ParserToken::ArrayStart)
+        {   parser.parseError(ParserInterface::ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::ColumnarMembers::scanColumn: Expecting an array for each column");
+            return true;
+        }
+        for (std::size_t index = base;; ++index)
+        {
+            ParserInterface::ParserToken    tokenType = parser.getToken();
+            // Note: After an error (config.throwOnError false) the token is always Error.
+            if (tokenType == ParserInterface::ParserToken::ArrayEnd || parser.failed())
+            {
+                break;
+            }
+            if (index - base >= parser.config.maxElements)
+            {   parser.parseError(ParserInterface::ErrorCode::LimitExceeded, "ThorsAnvil::Serialize::ColumnarMembers::scanColumn: Exceeded ParserConfig::maxElements");
+                break;
+            }
+            parser.pushBackToken(tokenType);
+            if (index >= container.size())
+            {
+                container.resize(index + 1);
+            }
+            GetValueType<typename std::remove_cv<M>::type>  valueGetter(parser, container[index].*(memberInfo.second));
+        }
+        return true;
+    }
+    template<typename C, typename M>
+    static bool scanColumn(ParserInterface&, std::string const&, C&, std::size_t, std::pair<char const*, M*> const&)
+    {
+        return false;
+    }
+};
+
+template<typename V>
+struct ColumnarMembers<V, TraitType::Parent>
+{
+    template<typename C>
+    static void print(PrinterInterface& printer, C const& container)
+    {
+        printParent(printer, container, static_cast<typename Traits<V>::Parent*>(nullptr));
+        ColumnarMembers<V, TraitType::Map>::print(printer, container);
+    }
+    template<typename C>
+    static bool scan(ParserInterface& parser, std::string const& key, C& container, std::size_t base)
+    {
+        return scanParent(parser, key, container, base, static_cast<typename Traits<V>::Parent*>(nullptr))
+            || ColumnarMembers<V, TraitType::Map>::scan(parser, key, container, base);
+    }
+
+    private:
+    // The member pointers of a parent can be applied to V directly.
+    template<typename C, typename P>
+    static void printParent(PrinterInterface& printer, C const& container, P*)
+    {
+        ColumnarMembers<P>::print(printer, container);
+    }
+    template<typename C, typename... P>
+    static void printParent(PrinterInterface& printer, C const& container, Parents<P...>*)
+    {
+        auto discard = {1, (ColumnarMembers<P>::print(printer, container), 1)...};
+        (void)discard;
+    }
+    template<typename C, typename P>
+    static bool scanParent(ParserInterface& parser, std::string const& key, C& container, std::size_t base, P*)
+    {
+        return ColumnarMembers<P>::scan(parser, key, container, base);
+    }
+    template<typename C, typename... P>
+    static bool scanParent(ParserInterface& parser, std::string const& key, C& container, std::size_t base, Parents<P...>*)
+    {
+        bool found = false;
+        auto discard = {1, (found = found || ColumnarMembers<P>::scan(parser, key, container, base), 1)...};
+        (void)discard;
+        return found;
+    }
+};
+
+/* ------------------------------- Traits<Columnar<C>> ------------------------------- */
+template<typename C>
+class Traits<Columnar<C>>
+{
+    using Container = typename std::remove_cv<C>::type;
+    using Value     = typename Container::value_type;
+    static_assert(
+        Traits<Value>::type == TraitType::Map || Traits<Value>::type == TraitType::Parent,
+        "Columnar can only be used on containers of objects declared with ThorsAnvil_MakeTrait"
+    );
+    public:
+        static constexpr TraitType type = TraitType::Map;
+
+        class MemberExtractor
+        {
+            public:
+                constexpr MemberExtractor(){}
+                void operator()(PrinterInterface& printer, Columnar<C> const& object) const
+                {
+                    ColumnarMembers<Value>::print(printer, object.getContainer());
+                }
+                void operator()(ParserInterface& parser, std::string const& key, Columnar<C>& object) const
+                {
+                    if (!ColumnarMembers<Value>::scan(parser, key, object.getContainer(), object.getBase()))
+                    {
+                        parser.ignoreValue();
+                    }
+                }
+        };
+
+        static MemberExtractor const& getMembers()
+        {
+            static constexpr MemberExtractor    memberExtractor;
+            return memberExtractor;
+        }
+};
+
+template<typename C>
+struct HeedAllValues<Columnar<C>>
+{
+    // Columns are matched by the MemberExtractor above.
+    void operator()(ParserInterface& /*parser*/, std::map<std::string, bool> const& /*members*/) {}
+};
+
+    }
+}
+
+#endif
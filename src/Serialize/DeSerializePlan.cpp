@@ -0,0 +1,154 @@
+#include "SerializeConfig.h"
+#include "DeSerializePlan.h"
+
+using namespace ThorsAnvil::Serialize;
+
+using ParserToken = ParserInterface::ParserToken;
+
+HEADER_ONLY_INCLUDE
+void DeSerializePlan::parse(ParserInterface& parser, void* object) const
+{
+    std::streampos start = parser.config.stats ? parser.input.tellg() : std::streampos(-1);
+    if (parser.getToken() != ParserToken::DocStart)
+    {   parser.parseError(ParserInterface::ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::DeSerializePlan::parse: Invalid Doc Start");
+        return;
+    }
+
+    parseType(parser, 0, object);
+
+    if (parser.getToken() != ParserToken::DocEnd)
+    {   parser.parseError(ParserInterface::ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::DeSerializePlan::parse: Expected Doc End");
+        return;
+    }
+    if (parser.config.stats && start != std::streampos(-1))
+    {
+        std::streampos end = parser.input.tellg();
+        if (end != std::streampos(-1))
+        {
+            parser.config.stats->bytesRead += end - start;
+        }
+    }
+}
+
+HEADER_ONLY_INCLUDE
+void DeSerializePlan::parseType(ParserInterface& parser, std::size_t index, void* object) const
+{
+    PlanType const& type = types[index];
+    switch (type.op)
+    {
+        case PlanOpCode::Object:    parseObject(parser, type, static_cast<char*>(object));  return;
+        case PlanOpCode::Array:     parseArray(parser, type, object);                       return;
+        case PlanOpCode::Generic:   type.parse(parser, object);                             return;
+        default:
+            break;
+    }
+
+    if (parser.getToken() != ParserToken::Value)
+    {   parser.parseError(ParserInterface::ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::DeSerializePlan::parseType: Invalid Object. Expecting Value");
+        return;
+    }
+    switch (type.op)
+    {
+        case PlanOpCode::Short:     parser.getValue(*static_cast<short int*>(object));              break;
+        case PlanOpCode::Int:       parser.getValue(*static_cast<int*>(object));                    break;
+        case PlanOpCode::Long:      parser.getValue(*static_cast<long int*>(object));               break;
+        case PlanOpCode::LongLong:  parser.getValue(*static_cast<long long int*>(object));          break;
+        case PlanOpCode::UShort:    parser.getValue(*static_cast<unsigned short int*>(object));     break;
+        case PlanOpCode::UInt:      parser.getValue(*static_cast<unsigned int*>(object));           break;
+        case PlanOpCode::ULong:     parser.getValue(*static_cast<unsigned long int*>(object));      break;
+        case PlanOpCode::ULongLong: parser.getValue(*static_cast<unsigned long long int*>(object)); break;
+        case PlanOpCode::Float:     parser.getValue(*static_cast<float*>(object));                  break;
+        case PlanOpCode::Double:    parser.getValue(*static_cast<double*>(object));                 break;
+        case PlanOpCode::LongDouble:parser.getValue(*static_cast<long double*>(object));            break;
+        case PlanOpCode::Bool:      parser.getValue(*static_cast<bool*>(object));                   break;
+        case PlanOpCode::String:    parser.getValue(*static_cast<std::string*>(object));            break;
+        default:
+            throw std::runtime_error("ThorsAnvil::Serialize::DeSerializePlan::parseType: Invalid OpCode");
+    }
+}
+
+HEADER_ONLY_INCLUDE
+void DeSerializePlan::parseObject(ParserInterface& parser, PlanType const& type, char* object) const
+{
+    if (parser.getToken() != ParserToken::MapStart)
+    {   parser.parseError(ParserInterface::ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::DeSerializePlan::parseObject: Invalid Object Start");
+        return;
+    }
+
+    PlanMember const*   begin   = members.data() + type.firstMember;
+    PlanMember const*   end     = begin + type.memberCount;
+    bool                exact   = parser.config.parseStrictness == ParserInterface::ParseType::Exact;
+    std::vector<bool>   memberFound(exact ? type.memberCount : 0, false);
+    std::size_t         count   = 0;
+
+    // Note: After an error (config.throwOnError false) the token is always Error.
+    for (ParserToken token = parser.getToken(); token != ParserToken::MapEnd; token = parser.getToken())
+    {
+        if (token != ParserToken::Key)
+        {   parser.parseError(ParserInterface::ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::DeSerializePlan::parseObject: Expecting key token");
+            return;
+        }
+        if (++count > parser.config.maxElements)
+        {   parser.parseError(ParserInterface::ErrorCode::LimitExceeded, "ThorsAnvil::Serialize::DeSerializePlan::parseObject: Exceeded ParserConfig::maxElements");
+            return;
+        }
+        std::string         key     = parser.getKey();
+        PlanMember const*   find    = std::lower_bound(begin, end, key,
+                                                       [](PlanMember const& member, std::string const& key){return key.compare(member.name) > 0;}
+                                                      );
+        if (find == end || key.compare(find->name) != 0)
+        {
+            parser.ignoreValue();
+            continue;
+        }
+
+        void*   member  = find->address != nullptr ? find->address : object + find->offset;
+        parseType(parser, find->type, member);
+        if (exact)
+        {
+            memberFound[find - begin] = true;
+        }
+    }
+    if (parser.failed())
+    {
+        return;
+    }
+
+    for (std::size_t loop = 0; loop < memberFound.size(); ++loop)
+    {
+        if (!memberFound[loop])
+        {
+            parser.parseError(ParserInterface::ErrorCode::MissingMember, "ThorsAnvil::Serialize::DeSerializePlan::parseObject: Did not find: ", begin[loop].name);
+            return;
+        }
+    }
+}
+
+HEADER_ONLY_INCLUDE
+void DeSerializePlan::parseArray(ParserInterface& parser, PlanType const& type, void* object) const
+{
+    if (parser.getToken() != ParserToken::ArrayStart)
+    {   parser.parseError(ParserInterface::ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::DeSerializePlan::parseArray: Invalid Object Start");
+        return;
+    }
+
+    for (std::size_t index = 0;; ++index)
+    {
+        // Note: After an error (config.throwOnError false) the token is always Error.
+        ParserToken token = parser.getToken();
+        if (token == ParserToken::ArrayEnd)
+        {
+            break;
+        }
+        if (token == ParserToken::Error)
+        {   parser.parseError(ParserInterface::ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::DeSerializePlan::parseArray: Invalid Array Element");
+            return;
+        }
+        if (index >= parser.config.maxElements)
+        {   parser.parseError(ParserInterface::ErrorCode::LimitExceeded, "ThorsAnvil::Serialize::DeSerializePlan::parseArray: Exceeded ParserConfig::maxElements");
+            return;
+        }
+        parser.pushBackToken(token);
+        parseType(parser, type.element, type.getElement(object, index));
+    }
+}
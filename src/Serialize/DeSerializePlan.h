@@ -0,0 +1,392 @@
+#ifndef THORS_ANVIL_SERIALIZE_DESERIALIZE_PLAN_H
+#define THORS_ANVIL_SERIALIZE_DESERIALIZE_PLAN_H
+/*
+ * An alternative to the DeSerializer for reading objects.
+ *
+ * The DeSerializer works out what to do at each step by walking the templates
+ * generated from Traits<T> as it reads. A DeSerializePlan walks the Traits<T>
+ * hierarchy once (the first time the type is used) and compiles it into a
+ * flat table that is then run by a small interpreter loop over the tokens
+ * generated by the parser (see DeSerializePlan.cpp).
+ *
+ *      PlanType:       One entry for each type reachable from T.
+ *                          Value:      An opcode saying which getValue() to call.
+ *                          Object:     A range of members (sorted by name).
+ *                                      Members of parent types are flattened into the range.
+ *                          Array:      A function to get the n'th element of a sequence
+ *                                      container and the index of the element type.
+ *                          Generic:    Anything else (Enum/Pointer/Custom/Containers with keys)
+ *                                      is handed back to a normal DeSerializer.
+ *      PlanMember:     The name, offset from the start of the object, and type of a member.
+ *
+ * Only the Generic types instantiate the DeSerializer templates. So a schema
+ * built from objects, values and sequence containers generates a small
+ * builder function per type rather than the full DeSerializer template tree.
+ *
+ * Note: Members are located by offset (measured on a default constructed object when the
+ *       plan is built). So types with a virtual base class, or that can not be default
+ *       constructed, are Generic.
+ *
+ * Usage:
+ *      std::cin >> PlanImport<Json>(object);
+ */
+
+#include "Serialize.h"
+#include "SerUtil.h"
+#include <vector>
+#include <map>
+#include <typeindex>
+#include <type_traits>
+#include <memory>
+#include <cstring>
+#include <algorithm>
+
+namespace ThorsAnvil
+{
+    namespace Serialize
+    {
+
+enum class PlanOpCode: unsigned char {Short, Int, Long, LongLong,
+                                      UShort, UInt, ULong, ULongLong,
+                                      Float, Double, LongDouble,
+                                      Bool, String,
+                                      Object, Array, Generic
+                                     };
+
+using PlanElementGetter = void* (*)(void* container, std::size_t index);
+using PlanGenericParser = void  (*)(ParserInterface& parser, void* object);
+
+struct PlanMember
+{
+    char const*         name;
+    std::size_t         offset;         // Offset from the start of the object.
+    void*               address;        // Static members: The address of the member (offset is ignored).
+    std::size_t         type;           // Index into DeSerializePlan::types
+};
+
+struct PlanType
+{
+    PlanOpCode          op;
+    std::size_t         firstMember;    // Object:  The members are members[firstMember, firstMember + memberCount)
+    std::size_t         memberCount;
+    std::size_t         element;        // Array:   Index of the element type.
+    PlanElementGetter   getElement;     // Array:   Get (or create) the element at an index.
+    PlanGenericParser   parse;          // Generic: Parse the object with a normal DeSerializer.
+};
+
+class DeSerializePlan
+{
+    std::vector<PlanType>       types;
+    std::vector<PlanMember>     members;
+
+    friend class DeSerializePlanBuilder;
+
+    void parseType(ParserInterface& parser, std::size_t type, void* object) const;
+    void parseObject(ParserInterface& parser, PlanType const& type, char* object) const;
+    void parseArray(ParserInterface& parser, PlanType const& type, void* object) const;
+    public:
+        template<typename T>
+        static DeSerializePlan const& getPlan();
+
+        // Parses a whole document (DocStart .. DocEnd) into object.
+        // object must be of the type the plan was built for.
+        void parse(ParserInterface& parser, void* object) const;
+};
+
+/* ------------ Plan Functions ------------------------- */
+
+template<typename T>
+struct PlanValueOpCode                          {static constexpr PlanOpCode value = PlanOpCode::Generic;};
+template<> struct PlanValueOpCode<short int>                {static constexpr PlanOpCode value = PlanOpCode::Short;};
+template<> struct PlanValueOpCode<int>                      {static constexpr PlanOpCode value = PlanOpCode::Int;};
+template<> struct PlanValueOpCode<long int>                 {static constexpr PlanOpCode value = PlanOpCode::Long;};
+template<> struct PlanValueOpCode<long long int>            {static constexpr PlanOpCode value = PlanOpCode::LongLong;};
+template<> struct PlanValueOpCode<unsigned short int>       {static constexpr PlanOpCode value = PlanOpCode::UShort;};
+template<> struct PlanValueOpCode<unsigned int>             {static constexpr PlanOpCode value = PlanOpCode::UInt;};
+template<> struct PlanValueOpCode<unsigned long int>        {static constexpr PlanOpCode value = PlanOpCode::ULong;};
+template<> struct PlanValueOpCode<unsigned long long int>   {static constexpr PlanOpCode value = PlanOpCode::ULongLong;};
+template<> struct PlanValueOpCode<float>                    {static constexpr PlanOpCode value = PlanOpCode::Float;};
+template<> struct PlanValueOpCode<double>                   {static constexpr PlanOpCode value = PlanOpCode::Double;};
+template<> struct PlanValueOpCode<long double>              {static constexpr PlanOpCode value = PlanOpCode::LongDouble;};
+template<> struct PlanValueOpCode<bool>                     {static constexpr PlanOpCode value = PlanOpCode::Bool;};
+template<> struct PlanValueOpCode<std::string>              {static constexpr PlanOpCode value = PlanOpCode::String;};
+
+template<typename T>
+void planParseGeneric(ParserInterface& parser, void* object)
+{
+    DeSerializer    deSerializer(parser, false);
+    deSerializer.parse(*static_cast<T*>(object));
+}
+
+template<typename C>
+void* planGetElement(void* container, std::size_t index)
+{
+    MemberEmplacer<C>   emplacer(*static_cast<C*>(container));
+    return &emplacer.get(index);
+}
+
+/* ------------ DeSerializePlanBuilder ------------------------- */
+
+// P is a virtual base of T if a P* can not be static_cast to a T*.
+template<typename T, typename P, typename = void>
+struct IsVirtualBase: std::true_type {};
+template<typename T, typename P>
+struct IsVirtualBase<T, P, std::void_t<decltype(static_cast<T*>(std::declval<P*>()))>>: std::false_type {};
+
+class DeSerializePlanBuilder
+{
+    template<TraitType type>
+    using TraitTypeTag  = std::integral_constant<TraitType, type>;
+
+    DeSerializePlan&                        plan;
+    std::map<std::type_index, std::size_t>  known;
+
+    public:
+        DeSerializePlanBuilder(DeSerializePlan& plan)
+            : plan(plan)
+        {}
+
+        template<typename T>
+        std::size_t addType()
+        {
+            auto find = known.find(typeid(T));
+            if (find != known.end())
+            {
+                return find->second;
+            }
+            // Register the type before building it.
+            // So a type that (indirectly) contains itself refers back to this entry.
+            std::size_t index   = plan.types.size();
+            known[typeid(T)]    = index;
+            plan.types.push_back(genericType<T>());
+
+            PlanType    type    = buildType<T>(TraitTypeTag<Traits<T>::type>{});
+            plan.types[index]   = type;
+            return index;
+        }
+    private:
+        template<typename T>
+        static PlanType genericType(PlanOpCode op = PlanOpCode::Generic)
+        {
+            return PlanType{op, 0, 0, 0, nullptr, &planParseGeneric<T>};
+        }
+
+        // Types that are not Value/Map/Parent/Array are always Generic.
+        template<typename T, TraitType type>
+        PlanType buildType(TraitTypeTag<type> const&)                   {return genericType<T>();}
+        template<typename T>
+        PlanType buildType(TraitTypeTag<TraitType::Value> const&)       {return genericType<T>(PlanValueOpCode<T>::value);}
+        template<typename T>
+        PlanType buildType(TraitTypeTag<TraitType::Map> const&)         {return buildObject<T>(Traits<T>::getMembers());}
+        template<typename T>
+        PlanType buildType(TraitTypeTag<TraitType::Parent> const&)      {return buildObject<T>(Traits<T>::getMembers());}
+        template<typename T>
+        PlanType buildType(TraitTypeTag<TraitType::Array> const&)       {return buildArray<T>(Traits<T>::getMembers());}
+
+        // Map types that use an action rather than a list of members (std::map<std::string, V>)
+        template<typename T, typename Action>
+        PlanType buildObject(Action const&)
+        {
+            return genericType<T>();
+        }
+        template<typename T, typename... Members>
+        PlanType buildObject(std::tuple<Members...> const&)
+        {
+            if constexpr (!std::is_default_constructible<T>::value || !hasFixedLayout<T>())
+            {
+                return genericType<T>();
+            }
+            else
+            {
+                return buildObjectMembers<T>();
+            }
+        }
+        template<typename T>
+        PlanType buildObjectMembers()
+        {
+            // The offsets of the members are measured on an object built for the purpose
+            // (once per type when the plan is built). Address arithmetic is only done on a real object.
+            std::unique_ptr<T>          sample  = std::make_unique<T>();
+            std::vector<PlanMember>     objectMembers;
+            addMembers<T>(objectMembers, reinterpret_cast<char const*>(sample.get()), sample.get());
+            std::sort(std::begin(objectMembers), std::end(objectMembers),
+                      [](PlanMember const& lhs, PlanMember const& rhs){return std::strcmp(lhs.name, rhs.name) < 0;}
+                     );
+
+            std::size_t first   = plan.members.size();
+            plan.members.insert(std::end(plan.members), std::begin(objectMembers), std::end(objectMembers));
+            return PlanType{PlanOpCode::Object, first, objectMembers.size(), 0, nullptr, &planParseGeneric<T>};
+        }
+
+        // Containers where elements are created in place can be filled by the plan.
+        // All other containers are Generic.
+        template<typename T, typename Action>
+        PlanType buildArray(Action const&)
+        {
+            return genericType<T>();
+        }
+        template<typename T, typename V>
+        PlanType buildArray(ContainerMemberExtractorEmplacer<T, V> const&)
+        {
+            std::size_t element = addType<V>();
+            return PlanType{PlanOpCode::Array, 0, 0, element, &planGetElement<T>, &planParseGeneric<T>};
+        }
+
+        // Add the members of T (and its parents) to result.
+        // The offsets are measured on a real object: origin is the start of the
+        // object being built and object is its T sub-object.
+        template<typename T>
+        void addMembers(std::vector<PlanMember>& result, char const* origin, T const* object)
+        {
+            addParentMembers<T>(result, origin, object, TraitTypeTag<Traits<T>::type>{});
+            addTupleMembers<T>(result, origin, object, Traits<T>::getMembers());
+        }
+
+        template<typename T, TraitType type>
+        void addParentMembers(std::vector<PlanMember>&, char const*, T const*, TraitTypeTag<type> const&)
+        {}
+        template<typename T>
+        void addParentMembers(std::vector<PlanMember>& result, char const* origin, T const* object, TraitTypeTag<TraitType::Parent> const&)
+        {
+            addParent<T>(result, origin, object, static_cast<typename Traits<T>::Parent*>(nullptr));
+        }
+        template<typename T, typename P>
+        void addParent(std::vector<PlanMember>& result, char const* origin, T const* object, P*)
+        {
+            addMembers<P>(result, origin, static_cast<P const*>(object));
+        }
+        template<typename T, typename... P>
+        void addParent(std::vector<PlanMember>& result, char const* origin, T const* object, Parents<P...>*)
+        {
+            bool ignore[] = {true, (addMembers<P>(result, origin, static_cast<P const*>(object)), true)...};
+            (void)ignore;
+        }
+
+        template<typename T, typename Members>
+        void addTupleMembers(std::vector<PlanMember>& result, char const* origin, T const* object, Members const& members)
+        {
+            addEachMember<T>(result, origin, object, members, std::make_index_sequence<std::tuple_size<Members>::value>());
+        }
+        template<typename T, typename Members, std::size_t... Seq>
+        void addEachMember(std::vector<PlanMember>& result, char const* origin, T const* object, Members const& members, std::index_sequence<Seq...> const&)
+        {
+            bool ignore[] = {true, (addMember<T>(result, origin, object, std::get<Seq>(members)), true)...};
+            (void)ignore;
+        }
+        template<typename T, typename C, typename M>
+        void addMember(std::vector<PlanMember>& result, char const* origin, T const* object, std::pair<char const*, M C::*> const& memberInfo)
+        {
+            std::size_t type    = addType<typename std::remove_cv<M>::type>();
+            std::size_t offset  = reinterpret_cast<char const*>(&(object->*(memberInfo.second))) - origin;
+            result.push_back(PlanMember{memberInfo.first, offset, nullptr, type});
+        }
+        template<typename T, typename M>
+        void addMember(std::vector<PlanMember>& result, char const*, T const*, std::pair<char const*, M*> const& memberInfo)
+        {
+            std::size_t type    = addType<typename std::remove_cv<M>::type>();
+            result.push_back(PlanMember{memberInfo.first, 0, memberInfo.second, type});
+        }
+
+        // The location of a virtual base depends on the most derived type.
+        // So the members of a type with a virtual base (at any level) can not be located by offset.
+        template<typename T>
+        static constexpr bool hasFixedLayout()
+        {
+            if constexpr (Traits<T>::type == TraitType::Parent)
+            {
+                return parentsHaveFixedLayout<T>(static_cast<typename Traits<T>::Parent*>(nullptr));
+            }
+            else
+            {
+                return true;
+            }
+        }
+        template<typename T, typename P>
+        static constexpr bool parentsHaveFixedLayout(P*)
+        {
+            return !IsVirtualBase<T, P>::value && hasFixedLayout<P>();
+        }
+        template<typename T, typename... P>
+        static constexpr bool parentsHaveFixedLayout(Parents<P...>*)
+        {
+            return (... && (!IsVirtualBase<T, P>::value && hasFixedLayout<P>()));
+        }
+};
+
+template<typename T>
+inline DeSerializePlan const& DeSerializePlan::getPlan()
+{
+    static_assert(
+        Traits<T>::type == TraitType::Map || Traits<T>::type == TraitType::Parent,
+        "A DeSerializePlan can only be built for objects (types declared with ThorsAnvil_MakeTrait or ThorsAnvil_ExpandTrait)"
+    );
+    static DeSerializePlan const plan = []()
+    {
+        DeSerializePlan         result;
+        DeSerializePlanBuilder  builder(result);
+        builder.addType<T>();
+        return result;
+    }();
+    return plan;
+}
+
+/* ------------ PlanImporter ------------------------- */
+/*
+ * Like the Importer but uses a DeSerializePlan rather than a DeSerializer.
+ */
+template<typename Format, typename T>
+class PlanImporter
+{
+    using ParserConfig = ParserInterface::ParserConfig;
+    T&              value;
+    ParserConfig    config;
+    bool            catchException;
+    public:
+        PlanImporter(T& value, ParserConfig config = ParserConfig{}, bool catchException = false)
+            : value(value)
+            , config(config)
+            , catchException(catchException)
+        {}
+        friend std::istream& operator>>(std::istream& stream, PlanImporter const& data)
+        {
+            try
+            {
+                typename Format::Parser     parser(stream, data.config);
+                DeSerializePlan::getPlan<T>().parse(parser, &data.value);
+                if (parser.failed())
+                {
+                    // Only when config.throwOnError is false.
+                    stream.setstate(std::ios::failbit);
+                }
+            }
+            catch (...)
+            {
+                stream.setstate(std::ios::failbit);
+                if (!data.catchException)
+                {
+                    throw;
+                }
+            }
+            return stream;
+        }
+};
+
+// @function-api
+// @param value             The object to be de-serialized.
+// @param config            Parser configuration (strictness).
+// @param catchExceptions   If true exceptions are caught and the stream is marked as failed.
+// @return                  Object that can be passed to operator>> for de-serialization.
+template<typename Format, typename T>
+PlanImporter<Format, T> PlanImport(T& value, ParserInterface::ParserConfig config = ParserInterface::ParserConfig{}, bool catchExceptions = false)
+{
+    return PlanImporter<Format, T>(value, config, catchExceptions);
+}
+
+    }
+}
+
+#if defined(HEADER_ONLY) && HEADER_ONLY == 1
+#include "DeSerializePlan.source"
+#endif
+
+#endif
@@ -29,8 +29,11 @@ class Exporter
         {
             try
             {
-                typename Format::Printer    printer(stream, data.config);
-                Serializer                  serializer(printer);
+                // Serializer uses the concrete Printer type.
+                // So calls to the printer can be resolved at compile time.
+                using Printer = typename Format::Printer;
+                Printer                     printer(stream, data.config);
+                BasicSerializer<Printer>    serializer(printer);
 
                 serializer.print(data.value);
             }
@@ -3,6 +3,9 @@
 /*
  * The Importer simply wrap an object of type T so that when de-serialized
  * it creates an object of type DeSerializer and calls it appropriately.
+ *
+ * tryImport() de-serializes with ParserConfig::throwOnError false.
+ * So a bad document is reported as a ParseResult rather than an exception (see "Error Codes" in Serialize.h).
  */
 
 #include "Serialize.h"
@@ -29,10 +32,19 @@ class Importer
         {
             try
             {
-                typename Format::Parser     parser(stream, data.config);
-                DeSerializer                deSerializer(parser);
-
-                deSerializer.parse(data.value);
+                // DeSerializer uses the concrete Parser type.
+                // So calls to the parser can be resolved at compile time.
+                using Parser = typename Format::Parser;
+                Parser                      parser(stream, data.config);
+                {
+                    BasicDeSerializer<Parser>   deSerializer(parser);
+                    deSerializer.parse(data.value);
+                }
+                if (parser.failed())
+                {
+                    // Only when config.throwOnError is false.
+                    stream.setstate(std::ios::failbit);
+                }
             }
             catch (...)
             {
@@ -46,6 +58,41 @@ class Importer
         }
 };
 
+// @function-api
+// @param stream            The stream to read.
+// @param value             The object to be de-serialized.
+// @param config            Parser configuration. throwOnError is ignored (errors are returned).
+// @return                  The first error and the byte offset it was found at. Converts to true if there was no error.
+template<typename Format, typename T>
+ParserInterface::ParseResult tryImport(std::istream& stream, T& value, ParserInterface::ParserConfig config = ParserInterface::ParserConfig{})
+{
+    using ParseResult = ParserInterface::ParseResult;
+    using ErrorCode   = ParserInterface::ErrorCode;
+
+    config.throwOnError = false;
+    try
+    {
+        using Parser = typename Format::Parser;
+        Parser                      parser(stream, config);
+        {
+            BasicDeSerializer<Parser>   deSerializer(parser);
+            deSerializer.parse(value);
+        }
+        if (parser.failed())
+        {
+            stream.setstate(std::ios::failbit);
+        }
+        // Note: Through ParserInterface as a parser may have its own member called error (YamlParser).
+        return parser.ParserInterface::error;
+    }
+    catch (...)
+    {
+        // Parsers and checks that do not support error codes.
+        stream.setstate(std::ios::failbit);
+        return ParseResult{ErrorCode::Exception, static_cast<std::size_t>(-1)};
+    }
+}
+
 template<typename Format, typename T>
 Importer<Format, T> Import(T const& value, ParserInterface::ParserConfig config = ParserInterface::ParserConfig{})
 {
@@ -1,16 +1,23 @@
 #include "SerializeConfig.h"
 #include "JsonManualLexer.h"
 #include "JsonLexemes.h"
-#include "UnicodeIterator.h"
+#include "JsonStringDecoder.h"
+#include "Utf8Validator.h"
 
 #include <limits>
 #include <cstring>
+#include <algorithm>
 
 using namespace ThorsAnvil::Serialize;
 
 HEADER_ONLY_INCLUDE
-JsonManualLexer::JsonManualLexer(std::istream& str)
+JsonManualLexer::JsonManualLexer(std::istream& str, InSituStreamBuf* inSitu, ParserInterface* parser)
     : str(str)
+    , inSitu(inSitu)
+    , parser(parser)
+    , maxStringLength(parser ? parser->config.maxStringLength : ParserInterface::noLimit)
+    , maxNumberLength(parser ? parser->config.maxNumberLength : ParserInterface::noLimit)
+    , validateUtf8(parser ? parser->config.validateUtf8 : false)
     , lastNull(false)
 {}
 
@@ -36,19 +43,19 @@ int JsonManualLexer::yylex()
         {
             readTrue();
             lastBool = true;
-            return lastToken = ThorsAnvil::Serialize::JSON_TRUE;
+            return lastToken = failed() ? 0 : ThorsAnvil::Serialize::JSON_TRUE;
         }
         case 'f':
         {
             readFalse();
             lastBool = false;
-            return lastToken = ThorsAnvil::Serialize::JSON_FALSE;
+            return lastToken = failed() ? 0 : ThorsAnvil::Serialize::JSON_FALSE;
         }
         case 'n':
         {
             readNull();
             lastNull = true;
-            return lastToken = ThorsAnvil::Serialize::JSON_NULL;
+            return lastToken = failed() ? 0 : ThorsAnvil::Serialize::JSON_NULL;
         }
         case '"':
         {
@@ -57,9 +64,11 @@ int JsonManualLexer::yylex()
         }
         default:
         {
-            return lastToken = readNumber(next)
-                ? ThorsAnvil::Serialize::JSON_INTEGER
-                : ThorsAnvil::Serialize::JSON_FLOAT;
+            // Note: Token 0 is an error (only returned when errors are not thrown).
+            bool isInteger = readNumber(next);
+            return lastToken = failed()
+                ? 0
+                : isInteger ? ThorsAnvil::Serialize::JSON_INTEGER : ThorsAnvil::Serialize::JSON_FLOAT;
         }
     }
 }
@@ -87,18 +96,108 @@ void JsonManualLexer::ignoreRawValue()
 {
     if (lastToken == ThorsAnvil::Serialize::JSON_STRING)
     {
-        char last = str.get();  // Read the first Quote off the stream
-        int next = str.get();
-        while (next != EOF && !(next == '"' && last != '\\'))
+        str.get();              // Read the first Quote off the stream
+        if (inSitu)
         {
-            last = next;
-            next = str.get();
+            findRawString();
+            return;
         }
-        if (next == EOF)
+        readRawString();
+    }
+}
+
+HEADER_ONLY_INCLUDE
+std::pair<char*, char*> JsonManualLexer::findRawString()
+{
+    // In-situ version of readRawString().
+    // Finds the closing quote in the buffer and moves the stream past it.
+    char*   begin   = inSitu->current();
+    char*   last    = inSitu->last();
+    char*   next    = begin;
+    for (;;)
+    {
+        next = static_cast<char*>(std::memchr(next, '"', last - next));
+        if (next == nullptr)
         {
             error();
+            return {begin, begin};
+        }
+        char*   slash = next;
+        for (; slash != begin && slash[-1] == '\\'; --slash)
+        {}
+        if ((next - slash) % 2 == 0)
+        {
+            break;
+        }
+        ++next;
+    }
+    inSitu->moveTo(next + 1);
+    if (static_cast<std::size_t>(next - begin) > maxStringLength)
+    {
+        error(ParserInterface::ErrorCode::LimitExceeded, "ThorsAnvil::Serialize::JsonManualLexer::findRawString: Exceeded ParserConfig::maxStringLength");
+        return {begin, begin};
+    }
+    checkUtf8(begin, next);
+    return {begin, next};
+}
+
+HEADER_ONLY_INCLUDE
+void JsonManualLexer::readRawString()
+{
+    // Reads up to the closing quote (the opening quote has been read).
+    // The text is read in blocks up to each quote. A quote preceded by an odd
+    // number of back slashes is escaped and part of the string.
+    auto isEscaped = [](std::string const& text)
+    {
+        std::size_t last = text.find_last_not_of('\\');
+        std::size_t count = text.size() - (last == std::string::npos ? 0 : last + 1);
+        return count % 2 == 1;
+    };
+
+    readSegment(rawString, 0);
+    while (str && !failed() && isEscaped(rawString))
+    {
+        rawString.push_back('"');
+        readSegment(rawSegment, rawString.size());
+        rawString += rawSegment;
+    }
+    if (!str || str.eof())
+    {
+        error();
+        return;
+    }
+    checkUtf8(rawString.data(), rawString.data() + rawString.size());
+}
+
+HEADER_ONLY_INCLUDE
+void JsonManualLexer::readSegment(std::string& segment, std::size_t used)
+{
+    // Reads up to the next quote (the quote is removed from the stream).
+    // used: The part of the string already read.
+    if (maxStringLength == ParserInterface::noLimit)
+    {
+        std::getline(str, segment, '"');
+        return;
+    }
+    // With a limit the string is read a character at a time.
+    // So reading stops at the limit (before the memory is used).
+    segment.clear();
+    std::size_t         limit   = maxStringLength - std::min(used, maxStringLength);
+    std::streambuf*     source  = str.rdbuf();
+    for (int next = source->sbumpc(); next != EOF; next = source->sbumpc())
+    {
+        if (next == '"')
+        {
+            return;
         }
+        if (segment.size() == limit)
+        {
+            error(ParserInterface::ErrorCode::LimitExceeded, "ThorsAnvil::Serialize::JsonManualLexer::readRawString: Exceeded ParserConfig::maxStringLength");
+            return;
+        }
+        segment.push_back(next);
     }
+    str.setstate(std::ios::eofbit | std::ios::failbit);
 }
 
 HEADER_ONLY_INCLUDE
@@ -129,9 +228,15 @@ std::string JsonManualLexer::getRawString()
             int next = str.get();
             while (next != EOF && !(next == '"' && last != '\\'))
             {
+                if (result.size() > maxStringLength)
+                {
+                    error(ParserInterface::ErrorCode::LimitExceeded, "ThorsAnvil::Serialize::JsonManualLexer::getRawString: Exceeded ParserConfig::maxStringLength");
+                    return result;
+                }
                 if (next < 0x20)
                 {
-                    throw std::runtime_error("X");
+                    error(ParserInterface::ErrorCode::InvalidString, "ThorsAnvil::Serialize::JsonManualLexer::getRawString: input character can not be smaller than 0x20");
+                    return result;
                 }
                 result.push_back(next);
                 last = next;
@@ -140,13 +245,16 @@ std::string JsonManualLexer::getRawString()
             if (next == EOF)
             {
                 error();
+                return result;
             }
+            checkUtf8(result.data() + 1, result.data() + result.size());
             result.push_back('"');
             return result;
         }
         default:
         {
-            throw std::runtime_error("Not Supported: Unexpected");
+            error(ParserInterface::ErrorCode::UnexpectedToken, "Not Supported: Unexpected");
+            return "";
         }
     }
 }
@@ -154,7 +262,76 @@ std::string JsonManualLexer::getRawString()
 HEADER_ONLY_INCLUDE
 std::string JsonManualLexer::getString()
 {
-    return std::string(make_UnicodeWrapperIterator(std::istreambuf_iterator<char>(str)), make_EndUnicodeWrapperIterator(std::istreambuf_iterator<char>(str)));
+    if (inSitu)
+    {
+        // One exact size copy of the string decoded in place.
+        return std::string(getStringView());
+    }
+    std::string result;
+    if (str.get() != '"')
+    {
+        error(ParserInterface::ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::JsonManualLexer::getString: String does not start with a \" character");
+        return result;
+    }
+    readRawString();
+    if (failed())
+    {
+        return result;
+    }
+
+    char const* message = nullptr;
+    if (!decodeJsonString(rawString.data(), rawString.data() + rawString.size(), result, message))
+    {
+        error(ParserInterface::ErrorCode::InvalidString, message);
+        return result;
+    }
+    if (validateUtf8 && rawString.find('\\') != std::string::npos)
+    {
+        // The raw text was checked by readRawString(). Only a \u escape can add invalid UTF-8.
+        checkUtf8(result.data(), result.data() + result.size());
+    }
+    return result;
+}
+
+HEADER_ONLY_INCLUDE
+std::string_view JsonManualLexer::getStringView()
+{
+    if (inSitu == nullptr)
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::JsonManualLexer::getStringView: Only supported by the in-situ parser");
+    }
+    if (str.get() != '"')
+    {
+        error(ParserInterface::ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::JsonManualLexer::getStringView: String does not start with a \" character");
+        return std::string_view{};
+    }
+    // The decoded string is never longer than the input.
+    // So it is written over the input and the view refers to the buffer.
+    auto        raw     = findRawString();
+    bool        escaped = validateUtf8 && std::memchr(raw.first, '\\', raw.second - raw.first) != nullptr;
+    char const* message = nullptr;
+    char*       end     = decodeJsonString(raw.first, raw.second, raw.first, message);
+    if (end == nullptr)
+    {
+        error(ParserInterface::ErrorCode::InvalidString, message);
+        return std::string_view{};
+    }
+    if (escaped)
+    {
+        // The raw text was checked by findRawString(). Only a \u escape can add invalid UTF-8.
+        checkUtf8(raw.first, end);
+    }
+    return std::string_view(raw.first, end - raw.first);
+}
+
+HEADER_ONLY_INCLUDE
+void JsonManualLexer::checkUtf8(char const* begin, char const* end) const
+{
+    // Every string span scanned (read, skipped or copied raw) is checked here.
+    if (validateUtf8 && !isValidUtf8(begin, end - begin))
+    {
+        error(ParserInterface::ErrorCode::InvalidString, "ThorsAnvil::Serialize::JsonManualLexer::checkUtf8: Invalid UTF-8");
+    }
 }
 
 HEADER_ONLY_INCLUDE
@@ -164,10 +341,8 @@ bool JsonManualLexer::getLastBool() const
     {
         return lastBool;
     }
-    else
-    {
-        throw std::runtime_error("ThorsAnvil::Serialize::JsonParser::getValue(): Not a bool");
-    }
+    error(ParserInterface::ErrorCode::InvalidValue, "ThorsAnvil::Serialize::JsonParser::getValue(): Not a bool");
+    return false;
 }
 
 HEADER_ONLY_INCLUDE
@@ -176,6 +351,22 @@ bool JsonManualLexer::isLastNull() const
     return lastNull;
 }
 
+HEADER_ONLY_INCLUDE
+ParserInterface::ValueType JsonManualLexer::getValueType() const
+{
+    using ValueType = ParserInterface::ValueType;
+    switch (lastToken)
+    {
+        case ThorsAnvil::Serialize::JSON_TRUE:      return ValueType::Bool;
+        case ThorsAnvil::Serialize::JSON_FALSE:     return ValueType::Bool;
+        case ThorsAnvil::Serialize::JSON_NULL:      return ValueType::Null;
+        case ThorsAnvil::Serialize::JSON_INTEGER:   return ValueType::Integer;
+        case ThorsAnvil::Serialize::JSON_FLOAT:     return ValueType::Float;
+        case ThorsAnvil::Serialize::JSON_STRING:    return ValueType::String;
+        default:                                    return ValueType::Unknown;
+    }
+}
+
 HEADER_ONLY_INCLUDE
 char JsonManualLexer::readDigits(char next)
 {
@@ -185,6 +376,11 @@ char JsonManualLexer::readDigits(char next)
     }
     while (std::isdigit(next))
     {
+        if (buffer.size() == maxNumberLength)
+        {
+            error(ParserInterface::ErrorCode::LimitExceeded, "ThorsAnvil::Serialize::JsonManualLexer::readNumber: Exceeded ParserConfig::maxNumberLength");
+            return next;
+        }
         buffer.push_back(next);
         next = str.get();
     }
@@ -262,7 +458,24 @@ void JsonManualLexer::checkFixed(char const* check, std::size_t size)
 }
 
 HEADER_ONLY_INCLUDE
-void JsonManualLexer::error()
+void JsonManualLexer::error() const
+{
+    error(ParserInterface::ErrorCode::InvalidCharacter, "ThorsAnvil::Serialize::JsonLexer: Invalid Character in Lexer");
+}
+
+HEADER_ONLY_INCLUDE
+void JsonManualLexer::error(ParserInterface::ErrorCode code, char const* message) const
+{
+    if (parser == nullptr)
+    {
+        throw std::runtime_error(message);
+    }
+    // Throws unless ParserConfig::throwOnError is false.
+    parser->parseError(code, message);
+}
+
+HEADER_ONLY_INCLUDE
+bool JsonManualLexer::failed() const
 {
-    throw std::runtime_error("ThorsAnvil::Serialize::JsonLexer: Invalid Character in Lexer");
+    return parser != nullptr && parser->failed();
 }
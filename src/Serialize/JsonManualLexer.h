@@ -3,28 +3,66 @@
 
 #include "Serialize.h"
 #include <istream>
+#include <streambuf>
+#include <string_view>
 
 namespace ThorsAnvil
 {
     namespace Serialize
     {
 
+/*
+ * A stream buffer over a mutable block of memory owned by the caller.
+ * Used by the in-situ parser (see JsonInSituParser) so the lexer can decode
+ * strings in the input buffer itself and hand out views of the result.
+ */
+class InSituStreamBuf: public std::streambuf
+{
+    public:
+        InSituStreamBuf(char* data, std::size_t size)
+        {
+            setg(data, data, data + size);
+        }
+        char*   current() const         {return gptr();}
+        char*   last() const            {return egptr();}
+        void    moveTo(char* position)  {setg(eback(), position, egptr());}
+    protected:
+        // Only reports the current position (used for the offset of a parse error).
+        virtual pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode) override
+        {
+            if (off != 0 || dir != std::ios_base::cur)
+            {
+                return pos_type(off_type(-1));
+            }
+            return pos_type(gptr() - eback());
+        }
+};
+
 class JsonManualLexer
 {
     std::istream&       str;
+    InSituStreamBuf*    inSitu;         // Not null when strings are decoded in place.
+    ParserInterface*    parser;         // Errors are reported to the parser (throws std::runtime_error if null).
+    std::size_t         maxStringLength;// Limits from the parser config (see "Limits" in Serialize.h).
+    std::size_t         maxNumberLength;
+    bool                validateUtf8;   // Check every string read is valid UTF-8 (see ParserConfig::validateUtf8).
     std::string         buffer;
+    std::string         rawString;      // Text of the last string (escapes not decoded).
+    std::string         rawSegment;
     int                 lastToken;
     bool                lastBool;
     bool                lastNull;
     public:
-        JsonManualLexer(std::istream& str);
+        JsonManualLexer(std::istream& str, InSituStreamBuf* inSitu = nullptr, ParserInterface* parser = nullptr);
         int yylex();
 
         void        ignoreRawValue();
         std::string getRawString();
         std::string getString();
+        std::string_view getStringView();
         bool        getLastBool() const;
         bool        isLastNull() const;
+        ParserInterface::ValueType getValueType() const;
         template<typename T>
         T scan() const;
     private:
@@ -32,10 +70,16 @@ class JsonManualLexer
         void readFalse();
         void readNull();
         bool readNumber(int next);
+        void readRawString();
+        void readSegment(std::string& segment, std::size_t used);
+        std::pair<char*, char*> findRawString();
 
         void checkFixed(char const* check, std::size_t size);
         char readDigits(char next);
-        void error();
+        void error() const;
+        void error(ParserInterface::ErrorCode code, char const* message) const;
+        void checkUtf8(char const* begin, char const* end) const;
+        bool failed() const;
 };
 
 template<typename T>
@@ -45,7 +89,7 @@ inline T JsonManualLexer::scan() const
     T value = scanValue<T>(&buffer[0], &end);
     if (buffer.size() == 0 || &buffer[0] + buffer.size() != end)
     {
-        throw std::runtime_error("ThorsAnvil::Serialize::JsonParser: Not an integer");
+        error(ParserInterface::ErrorCode::InvalidValue, "ThorsAnvil::Serialize::JsonParser: Not an integer");
     }
     return value;
 }
@@ -1,7 +1,6 @@
 #include "SerializeConfig.h"
 #include "JsonParser.h"
 #include "JsonLexemes.h"
-#include "UnicodeIterator.h"
 #include <map>
 #include <cstdlib>
 #include <cstring>
@@ -13,7 +12,16 @@ using ParserToken = ParserInterface::ParserToken;
 HEADER_ONLY_INCLUDE
 JsonParser::JsonParser(std::istream& stream, ParserConfig config)
     : ParserInterface(stream, config)
-    , lexer(stream)
+    , lexer(stream, nullptr, this)
+    , currentEnd(Done)
+    , currentState(Init)
+    , started(false)
+{}
+
+HEADER_ONLY_INCLUDE
+JsonParser::JsonParser(std::istream& stream, InSituStreamBuf& buffer, ParserConfig config)
+    : ParserInterface(stream, config)
+    , lexer(stream, &buffer, this)
     , currentEnd(Done)
     , currentState(Init)
     , started(false)
@@ -191,12 +199,24 @@ void JsonParser::getValue(std::string& value)
     value = getString();
 }
 
+HEADER_ONLY_INCLUDE
+void JsonParser::getValue(std::string_view& value)
+{
+    value = lexer.getStringView();
+}
+
 HEADER_ONLY_INCLUDE
 bool JsonParser::isValueNull()
 {
     return lexer.isLastNull();
 }
 
+HEADER_ONLY_INCLUDE
+ParserInterface::ValueType JsonParser::getValueType() const
+{
+    return lexer.getValueType();
+}
+
 HEADER_ONLY_INCLUDE
 std::string JsonParser::getRawValue()
 {
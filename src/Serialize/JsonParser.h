@@ -43,34 +43,70 @@ class JsonParser: public ParserInterface
 
     template<typename T>
     T scan();
+    protected:
+        JsonParser(std::istream& stream, InSituStreamBuf& buffer, ParserConfig config);
     public:
+        // The overrides are final so calls through a JsonParser (see Importer)
+        // can be resolved at compile time.
         JsonParser(std::istream& stream, ParserConfig config = ParserConfig{});
-        virtual ParserToken getNextToken()                      override;
-        virtual std::string getKey()                            override;
+        virtual ParserToken getNextToken()                      override final;
+        virtual std::string getKey()                            override final;
 
-        virtual void    ignoreDataValue()                       override;
+        virtual void    ignoreDataValue()                       override final;
 
-        virtual void    getValue(short int& value)              override;
-        virtual void    getValue(int& value)                    override;
-        virtual void    getValue(long int& value)               override;
-        virtual void    getValue(long long int& value)          override;
+        virtual void    getValue(short int& value)              override final;
+        virtual void    getValue(int& value)                    override final;
+        virtual void    getValue(long int& value)               override final;
+        virtual void    getValue(long long int& value)          override final;
 
-        virtual void    getValue(unsigned short int& value)     override;
-        virtual void    getValue(unsigned int& value)           override;
-        virtual void    getValue(unsigned long int& value)      override;
-        virtual void    getValue(unsigned long long int& value) override;
+        virtual void    getValue(unsigned short int& value)     override final;
+        virtual void    getValue(unsigned int& value)           override final;
+        virtual void    getValue(unsigned long int& value)      override final;
+        virtual void    getValue(unsigned long long int& value) override final;
 
-        virtual void    getValue(float& value)                  override;
-        virtual void    getValue(double& value)                 override;
-        virtual void    getValue(long double& value)            override;
+        virtual void    getValue(float& value)                  override final;
+        virtual void    getValue(double& value)                 override final;
+        virtual void    getValue(long double& value)            override final;
 
-        virtual void    getValue(bool& value)                   override;
+        virtual void    getValue(bool& value)                   override final;
 
-        virtual void    getValue(std::string& value)            override;
+        virtual void    getValue(std::string& value)            override final;
+        virtual void    getValue(std::string_view& value)       override final;
+        using ParserInterface::getValue;                        // Overloads that are not virtual.
 
-        virtual bool    isValueNull()                           override;
+        virtual bool    isValueNull()                           override final;
+        virtual ValueType getValueType() const                  override final;
 
-        virtual std::string getRawValue()                       override;
+        virtual std::string getRawValue()                       override final;
+};
+
+/*
+ * In-situ (destructive) parsing.
+ *      Parses Json held in a mutable buffer owned by the caller.
+ *      Strings and keys are decoded in the buffer itself. So:
+ *          std::string_view members refer to the buffer (no allocation).
+ *          std::string members are one exact size copy.
+ *
+ *      The buffer is modified and must outlive any std::string_view read from it.
+ */
+struct JsonInSituInput
+{
+    InSituStreamBuf     buffer;
+    std::istream        stream;
+
+    JsonInSituInput(char* data, std::size_t size)
+        : buffer(data, size)
+        , stream(&buffer)
+    {}
+};
+
+class JsonInSituParser: private JsonInSituInput, public JsonParser
+{
+    public:
+        JsonInSituParser(char* data, std::size_t size, ParserConfig config = ParserConfig{})
+            : JsonInSituInput(data, size)
+            , JsonParser(JsonInSituInput::stream, JsonInSituInput::buffer, config)
+        {}
 };
     }
 }
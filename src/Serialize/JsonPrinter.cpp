@@ -25,9 +25,13 @@ namespace
             {}
             void printSeporator(std::ostream& stream, bool key) const
             {
-                char const*(&seporator)[] = (!key && state.second == TraitType::Map)
-                                            ? colon
-                                            : (state.first != 0) ? comma : space;
+                if (!key && state.second == TraitType::Map)
+                {
+                    // A value in a map follows a key.
+                    // The colon is printed as part of the key.
+                    return;
+                }
+                char const*(&seporator)[] = (state.first != 0) ? comma : space;
                 stream << seporator[static_cast<int>(characteristics)];
             }
     };
@@ -156,6 +160,27 @@ void JsonPrinter::closeArray()
     state.pop_back();
     output << PrefixArrayClose(config.characteristics, state.size(), state.back()) << "]";
 }
+HEADER_ONLY_INCLUDE
+void JsonPrinter::openArrayChunk(std::size_t index)
+{
+    // Put the printer in the same state as it would be after printing
+    // the open bracket and the first `index` elements of the top level array.
+    // So the separator in front of the first element is correct.
+    if (state.size() != 1)
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::JsonPrinter: Invalid call to openArrayChunk(): Chunks can only be printed at the top level");
+    }
+    state.emplace_back(index, TraitType::Array);
+}
+HEADER_ONLY_INCLUDE
+void JsonPrinter::closeArrayChunk()
+{
+    if (state.size() != 2 || state.back().second != TraitType::Array)
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::JsonPrinter: Invalid call to closeArrayChunk(): Currently not in an array chunk");
+    }
+    state.pop_back();
+}
 
 HEADER_ONLY_INCLUDE
 void JsonPrinter::addKey(std::string const& key)
@@ -164,7 +189,20 @@ void JsonPrinter::addKey(std::string const& key)
     {
         throw std::runtime_error("ThorsAnvil::Serialize::JsonPrinter: Invalid call to addKey(): Currently not in a map");
     }
-    output << PrefixKey(config.characteristics, state.size(), state.back()) << '"' << key << '"';
+    output << PrefixKey(config.characteristics, state.size(), state.back()) << '"' << key << '"' << Prefix::colon[static_cast<int>(config.characteristics)];
+}
+HEADER_ONLY_INCLUDE
+void JsonPrinter::addKey(MemberKey const& key)
+{
+    if (state.back().second != TraitType::Map)
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::JsonPrinter: Invalid call to addKey(): Currently not in a map");
+    }
+    // The key token is: "<name>": (with a trailing space)
+    // The Stream format does not use the trailing space.
+    std::size_t size = key.quoted.size() - (config.characteristics == OutputType::Stream ? 1 : 0);
+    output << PrefixKey(config.characteristics, state.size(), state.back());
+    output.write(key.quoted.data(), size);
 }
 
 template<typename T>
@@ -13,7 +13,7 @@ namespace ThorsAnvil
     namespace Serialize
     {
 
-class JsonPrinter: public PrinterInterface
+class JsonPrinter final: public PrinterInterface
 {
     std::vector<std::pair<int, TraitType>> state;
     public:
@@ -27,6 +27,7 @@ class JsonPrinter: public PrinterInterface
         virtual void closeArray()                           override;
 
         virtual void addKey(std::string const& key)         override;
+        virtual void addKey(MemberKey const& key)           override;
 
         virtual void addValue(short int value)              override;
         virtual void addValue(int value)                    override;
@@ -45,10 +46,15 @@ class JsonPrinter: public PrinterInterface
         virtual void addValue(bool value)                   override;
 
         virtual void addValue(std::string const& value)     override;
+        using PrinterInterface::addValue;                    // Overloads that are not virtual.
 
         virtual void addRawValue(std::string const& value)  override;
 
         virtual void addNull()                              override;
+
+        virtual bool canPrintArrayChunk() const             override    {return true;}
+        virtual void openArrayChunk(std::size_t index)      override;
+        virtual void closeArrayChunk()                      override;
 };
 
     }
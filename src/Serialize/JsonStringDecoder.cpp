@@ -0,0 +1,254 @@
+#include "SerializeConfig.h"
+#include "JsonStringDecoder.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+using namespace ThorsAnvil::Serialize;
+
+namespace
+{
+using Byte  = unsigned char;
+using Table = std::array<Byte, 256>;
+
+constexpr Byte invalidHex       = 0xFF;
+constexpr Byte invalidEscape    = 0x00;
+
+// Value of a hex digit or invalidHex.
+constexpr Table buildHexTable()
+{
+    Table result{};
+    for (std::size_t loop = 0; loop < result.size(); ++loop)
+    {
+        result[loop] = invalidHex;
+    }
+    for (Byte loop = 0; loop < 10; ++loop)
+    {
+        result['0' + loop] = loop;
+    }
+    for (Byte loop = 0; loop < 6; ++loop)
+    {
+        result['A' + loop] = 10 + loop;
+        result['a' + loop] = 10 + loop;
+    }
+    return result;
+}
+
+// The character represented by "\<x>" or invalidEscape.
+// Note: 'u' is handled separately.
+constexpr Table buildEscapeTable()
+{
+    Table result{};
+    result['"']     = '"';
+    result['\\']    = '\\';
+    result['/']     = '/';
+    result['b']     = '\b';
+    result['f']     = '\f';
+    result['n']     = '\n';
+    result['r']     = '\r';
+    result['t']     = '\t';
+    return result;
+}
+
+// Characters that end a run that can be copied as is.
+constexpr Table buildStopTable()
+{
+    Table result{};
+    for (std::size_t loop = 0; loop < 0x20; ++loop)
+    {
+        result[loop] = 1;
+    }
+    result['\\']    = 1;
+    return result;
+}
+
+constexpr Table hexTable    = buildHexTable();
+constexpr Table escapeTable = buildEscapeTable();
+constexpr Table stopTable   = buildStopTable();
+
+constexpr std::uint32_t invalidCode = 0xFFFFFFFF;
+
+char const* const badHex        = "ThorsAnvil::Serialize::decodeJsonString: Invalid Hex Digit in unicode string";
+char const* const badSurrogate  = "ThorsAnvil::Serialize::decodeJsonString: Surrogate pair: \\uD8xx Must be followed by \\uDCxx";
+char const* const badControl    = "ThorsAnvil::Serialize::decodeJsonString: input character can not be smaller than 0x20";
+char const* const badEscape     = "ThorsAnvil::Serialize::decodeJsonString: Escaped character must be one of [\"\\/bfnrtu]";
+
+// Reads the 4 hex digits after "\u".
+// Returns invalidCode on error.
+inline std::uint32_t decodeHex(Byte const* next, Byte const* end)
+{
+    if (end - next < 4)
+    {
+        return invalidCode;
+    }
+    Byte d0 = hexTable[next[0]];
+    Byte d1 = hexTable[next[1]];
+    Byte d2 = hexTable[next[2]];
+    Byte d3 = hexTable[next[3]];
+    if ((d0 | d1 | d2 | d3) & 0xF0)
+    {
+        return invalidCode;
+    }
+    return (std::uint32_t{d0} << 12) | (std::uint32_t{d1} << 8) | (std::uint32_t{d2} << 4) | std::uint32_t{d3};
+}
+
+inline char* encodeUtf8(std::uint32_t value, char* out)
+{
+    if (value <= 0x7F)
+    {
+        *out++ = static_cast<char>(value);
+    }
+    else if (value <= 0x7FF)
+    {
+        *out++ = static_cast<char>(0xC0 | (value >>  6));
+        *out++ = static_cast<char>(0x80 | (value & 0x3F));
+    }
+    else if (value <= 0xFFFF)
+    {
+        *out++ = static_cast<char>(0xE0 | (value >> 12));
+        *out++ = static_cast<char>(0x80 | ((value >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (value & 0x3F));
+    }
+    else
+    {
+        *out++ = static_cast<char>(0xF0 | (value >> 18));
+        *out++ = static_cast<char>(0x80 | ((value >> 12) & 0x3F));
+        *out++ = static_cast<char>(0x80 | ((value >>  6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (value & 0x3F));
+    }
+    return out;
+}
+
+// next points after "\u".
+// Returns the position after the escape sequence (nullptr on error).
+inline Byte const* decodeUnicode(Byte const* next, Byte const* end, char*& out, char const*& error)
+{
+    std::uint32_t value = decodeHex(next, end);
+    if (value == invalidCode)
+    {
+        error = badHex;
+        return nullptr;
+    }
+    next += 4;
+    if ((value & 0xFC00) == 0xD800)
+    {
+        // First part of a surrogate pair.
+        // Must be followed by "\uDCxx".
+        if (end - next < 2 || next[0] != '\\' || next[1] != 'u')
+        {
+            error = badSurrogate;
+            return nullptr;
+        }
+        std::uint32_t low = decodeHex(next + 2, end);
+        if (low == invalidCode)
+        {
+            error = badHex;
+            return nullptr;
+        }
+        if ((low & 0xFC00) != 0xDC00)
+        {
+            error = badSurrogate;
+            return nullptr;
+        }
+        next += 6;
+        value = 0x00010000 + ((value & 0x03FF) << 10) + (low & 0x03FF);
+    }
+    out = encodeUtf8(value, out);
+    return next;
+}
+}
+
+HEADER_ONLY_INCLUDE
+char* ThorsAnvil::Serialize::decodeJsonString(char const* begin, char const* end, char* out, char const*& error)
+{
+    Byte const*     next    = reinterpret_cast<Byte const*>(begin);
+    Byte const*     last    = reinterpret_cast<Byte const*>(end);
+
+    while (next != last)
+    {
+        // Copy the run up to the next escape as a block.
+        // Note: memmove as out and next are in the same buffer when decoding in place.
+        Byte const* run = next;
+        for (; next != last && !stopTable[*next]; ++next)
+        {}
+        if (out != reinterpret_cast<char const*>(run))
+        {
+            std::memmove(out, run, next - run);
+        }
+        out += next - run;
+
+        if (next == last)
+        {
+            break;
+        }
+        if (*next != '\\')
+        {
+            error = badControl;
+            return nullptr;
+        }
+        ++next;
+        if (next == last)
+        {
+            error = badEscape;
+            return nullptr;
+        }
+        if (*next == 'u')
+        {
+            next = decodeUnicode(next + 1, last, out, error);
+            if (next == nullptr)
+            {
+                return nullptr;
+            }
+            continue;
+        }
+        Byte escape = escapeTable[*next];
+        if (escape == invalidEscape)
+        {
+            error = badEscape;
+            return nullptr;
+        }
+        *out++ = static_cast<char>(escape);
+        ++next;
+    }
+    return out;
+}
+
+HEADER_ONLY_INCLUDE
+bool ThorsAnvil::Serialize::decodeJsonString(char const* begin, char const* end, std::string& output, char const*& error)
+{
+    // Every escape sequence is at least as long as the UTF-8 it produces.
+    std::size_t     start   = output.size();
+    output.resize(start + (end - begin));
+
+    char*           out     = decodeJsonString(begin, end, &output[0] + start, error);
+    if (out == nullptr)
+    {
+        output.resize(start);
+        return false;
+    }
+    output.resize(out - output.data());
+    return true;
+}
+
+HEADER_ONLY_INCLUDE
+char* ThorsAnvil::Serialize::decodeJsonString(char const* begin, char const* end, char* output)
+{
+    char const*     error   = nullptr;
+    char*           out     = decodeJsonString(begin, end, output, error);
+    if (out == nullptr)
+    {
+        throw std::runtime_error(error);
+    }
+    return out;
+}
+
+HEADER_ONLY_INCLUDE
+void ThorsAnvil::Serialize::decodeJsonString(char const* begin, char const* end, std::string& output)
+{
+    char const*     error   = nullptr;
+    if (!decodeJsonString(begin, end, output, error))
+    {
+        throw std::runtime_error(error);
+    }
+}
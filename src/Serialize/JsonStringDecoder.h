@@ -0,0 +1,46 @@
+#ifndef THORS_ANVIL_SERIALIZE_JSON_STRING_DECODER_H
+#define THORS_ANVIL_SERIALIZE_JSON_STRING_DECODER_H
+/*
+ * Decodes the text between the quotes of a Json string.
+ *      Escape sequences are converted to the character they represent.
+ *      \uXXXX (including surrogate pairs) is converted to UTF-8.
+ *
+ * Runs of characters without escapes are copied as a block directly into the
+ * destination. Escapes and hex digits are decoded with lookup tables.
+ *
+ * The decoded text is never longer than the encoded text. So the destination
+ * is sized once and written in place. For the same reason the text can be
+ * decoded over itself (used by the in-situ Json parser).
+ *
+ * Used by the JsonManualLexer (the UnicodeWrapperIterator reads one character at a time).
+ */
+
+#include <string>
+
+namespace ThorsAnvil
+{
+    namespace Serialize
+    {
+
+// Writes the decoded form of [begin, end) to output and returns the end of the decoded text.
+// output must have space for (end - begin) characters and may be begin.
+// Throws std::runtime_error on an invalid escape or a control character.
+char* decodeJsonString(char const* begin, char const* end, char* output);
+
+// Appends the decoded form of [begin, end) to output.
+// Throws std::runtime_error on an invalid escape or a control character.
+void decodeJsonString(char const* begin, char const* end, std::string& output);
+
+// Versions that do not throw (used when ParserConfig::throwOnError is false).
+// On an invalid escape or a control character these return nullptr/false and set error to a description of the problem.
+char* decodeJsonString(char const* begin, char const* end, char* output, char const*& error);
+bool  decodeJsonString(char const* begin, char const* end, std::string& output, char const*& error);
+
+    }
+}
+
+#if defined(HEADER_ONLY) && HEADER_ONLY == 1
+#include "JsonStringDecoder.source"
+#endif
+
+#endif
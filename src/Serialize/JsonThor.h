@@ -5,16 +5,23 @@
  *      ThorsAnvil::Serialize::Json
  *      ThorsAnvil::Serialize::jsonExport
  *      ThorsAnvil::Serialize::jsonImport
+ *      ThorsAnvil::Serialize::jsonValidate
+ *      ThorsAnvil::Serialize::jsonImportInSitu
+ *      ThorsAnvil::Serialize::jsonTryImport
  *
  * Usage:
  *      std::cout << jsonExport(object); // converts object to Json on an output stream
  *      std::cin  >> jsonImport(object); // converts Json to a C++ object from an input stream
+ *      jsonValidate<T>(std::cin);       // checks Json conforms to T without building an object
+ *      jsonImportInSitu(buffer, size, object); // converts Json in a mutable buffer (decoding strings in place, returns the error code and offset)
+ *      if (!jsonTryImport(std::cin, object)) {} // converts Json without throwing (returns the error code and offset)
  */
 
 #include "JsonParser.h"
 #include "JsonPrinter.h"
 #include "Exporter.h"
 #include "Importer.h"
+#include "Validator.h"
 
 namespace ThorsAnvil
 {
@@ -46,6 +53,41 @@ template<typename T>
 Importer<Json, T> jsonImport(T& value, ParserInterface::ParserConfig config = ParserInterface::ParserConfig{}, bool catchExceptions = false)
 {
     return Importer<Json, T>(value, config, catchExceptions);
+}
+// @function-api
+// @param stream            The stream to read.
+// @param value             The object to be de-serialized.
+// @param config            Parser configuration. throwOnError is ignored: errors are returned not thrown.
+// @return                  The first error and the byte offset it was found at. Converts to true if there was no error.
+template<typename T>
+ParserInterface::ParseResult jsonTryImport(std::istream& stream, T& value, ParserInterface::ParserConfig config = ParserInterface::ParserConfig{})
+{
+    return tryImport<Json>(stream, value, config);
+}
+// @function-api
+// @param stream            The stream to validate.
+// @param parseStrictness   'Weak':    ignore extra fields. 'Strict': Any extra fields are invalid. 'Exact': Any missing fields are also invalid.
+// @return                  true if the stream conforms to Traits<T> (see Validator.h).
+template<typename T>
+bool jsonValidate(std::istream& stream, ParserInterface::ParserConfig config = ParserInterface::ParserConfig{})
+{
+    return validate<Json, T>(stream, config);
+}
+// @function-api
+// @param data              Mutable buffer holding the Json. Strings are decoded in place (the buffer is modified).
+// @param size              The size of the Json in data.
+// @param value             The object to be de-serialized. std::string_view members refer to data.
+// @param parseStrictness   'Weak':    ignore missing extra fields. 'Strict': Any missing or extra fields throws exception.
+// @return                  The first error and the byte offset it was found at (only set when config.throwOnError is false).
+template<typename T>
+ParserInterface::ParseResult jsonImportInSitu(char* data, std::size_t size, T& value, ParserInterface::ParserConfig config = ParserInterface::ParserConfig{})
+{
+    JsonInSituParser    parser(data, size, config);
+    {
+        BasicDeSerializer<JsonInSituParser> deSerializer(parser);
+        deSerializer.parse(value);
+    }
+    return parser.error;
 }
     }
 }
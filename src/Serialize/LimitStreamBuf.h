@@ -0,0 +1,101 @@
+#ifndef THORS_ANVIL_SERIALIZE_LIMIT_STREAM_BUF_H
+#define THORS_ANVIL_SERIALIZE_LIMIT_STREAM_BUF_H
+/*
+ * A stream buffer that reads from another stream buffer but stops after a fixed number of bytes.
+ * Used by the ParserInterface to enforce ParserConfig::maxBytes.
+ *
+ * There is no buffer: each read goes to the source. So no bytes after the
+ * document are taken from the source and the stream can be given its
+ * source back when the parser is done.
+ */
+
+#include <streambuf>
+#include <ios>
+#include <algorithm>
+#include <cstddef>
+
+namespace ThorsAnvil
+{
+    namespace Serialize
+    {
+
+class LimitStreamBuf: public std::streambuf
+{
+    std::streambuf*     source;
+    std::size_t         remaining;
+    bool                exceeded;
+    public:
+        LimitStreamBuf(std::streambuf* source, std::size_t limit)
+            : source(source)
+            , remaining(limit)
+            , exceeded(false)
+        {}
+        std::streambuf* getSource() const       {return source;}
+        // The number of bytes that can still be read before the limit.
+        std::size_t     getRemaining() const    {return remaining;}
+        // true if a read was stopped by the limit (and the source had more data).
+        bool            limitExceeded() const   {return exceeded;}
+    protected:
+        virtual int_type underflow() override
+        {
+            if (remaining == 0)
+            {
+                return atLimit();
+            }
+            return source->sgetc();
+        }
+        virtual int_type uflow() override
+        {
+            if (remaining == 0)
+            {
+                return atLimit();
+            }
+            int_type result = source->sbumpc();
+            if (!traits_type::eq_int_type(result, traits_type::eof()))
+            {
+                --remaining;
+            }
+            return result;
+        }
+        virtual int_type pbackfail(int_type) override
+        {
+            int_type result = source->sungetc();
+            if (!traits_type::eq_int_type(result, traits_type::eof()))
+            {
+                ++remaining;
+            }
+            return result;
+        }
+        virtual std::streamsize xsgetn(char* data, std::streamsize count) override
+        {
+            std::streamsize available   = static_cast<std::streamsize>(std::min(static_cast<std::size_t>(count), remaining));
+            std::streamsize result      = source->sgetn(data, available);
+            remaining -= result;
+            if (result == available && available < count)
+            {
+                atLimit();
+            }
+            return result;
+        }
+        // Only reports the current position (used by SerializeStats and the offset of a parse error).
+        virtual pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+        {
+            if (off != 0 || dir != std::ios_base::cur)
+            {
+                return pos_type(off_type(-1));
+            }
+            return source->pubseekoff(0, std::ios_base::cur, which);
+        }
+    private:
+        int_type atLimit()
+        {
+            // Reaching the limit at the end of the input is not an error.
+            exceeded = exceeded || !traits_type::eq_int_type(source->sgetc(), traits_type::eof());
+            return traits_type::eof();
+        }
+};
+
+    }
+}
+
+#endif
@@ -0,0 +1,370 @@
+#include "SerializeConfig.h"
+#include "MsgPackParser.h"
+#include <sstream>
+#include <limits>
+#include <cstring>
+
+using namespace ThorsAnvil::Serialize;
+using ParserToken = ParserInterface::ParserToken;
+
+HEADER_ONLY_INCLUDE
+MsgPackParser::MsgPackParser(std::istream& stream, ParserConfig config)
+    : ParserInterface(stream, config)
+    , stage(Stage::DocStart)
+    , valueType(ValueType::Null)
+    , intValue(0)
+    , floatValue(0)
+    , textPending(0)
+{}
+
+HEADER_ONLY_INCLUDE
+int MsgPackParser::readByte()
+{
+    int result = input.get();
+    if (result == std::char_traits<char>::eof())
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::MsgPackParser::readByte: Unexpected end of input");
+    }
+    return result;
+}
+
+HEADER_ONLY_INCLUDE
+std::uint64_t MsgPackParser::readBigEndian(int size)
+{
+    std::uint64_t   result = 0;
+    for (int loop = 0; loop < size; ++loop)
+    {
+        result = (result << 8) | readByte();
+    }
+    return result;
+}
+
+HEADER_ONLY_INCLUDE
+void MsgPackParser::readText()
+{
+    // Note: textValue keeps its capacity so this only allocates
+    //       when a string is larger than any previous string.
+    if (textPending == 0 || !checkStringLength(textPending))
+    {
+        return;
+    }
+    textValue.resize(textPending);
+    if (!input.read(&textValue[0], textPending))
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::MsgPackParser::readText: Unexpected end of input");
+    }
+    textPending = 0;
+}
+
+HEADER_ONLY_INCLUDE
+void MsgPackParser::skipText()
+{
+    if (textPending != 0)
+    {
+        input.ignore(textPending);
+        textPending = 0;
+    }
+}
+
+HEADER_ONLY_INCLUDE
+void MsgPackParser::setSigned(std::int64_t value)
+{
+    if (value >= 0)
+    {
+        valueType   = ValueType::Unsigned;
+        intValue    = static_cast<std::uint64_t>(value);
+    }
+    else
+    {
+        // Stored as -1 - value so the full range fits in an unsigned value.
+        valueType   = ValueType::Negative;
+        intValue    = ~static_cast<std::uint64_t>(value);
+    }
+}
+
+HEADER_ONLY_INCLUDE
+ParserToken MsgPackParser::readItem()
+{
+    int initial = readByte();
+    textValue.clear();
+
+    if (initial <= 0x7F)
+    {
+        valueType   = ValueType::Unsigned;
+        intValue    = initial;
+        return ParserToken::Value;
+    }
+    if (initial >= 0xE0)
+    {
+        setSigned(static_cast<std::int8_t>(initial));
+        return ParserToken::Value;
+    }
+    if ((initial & 0xF0) == 0x80 || (initial & 0xF0) == 0x90)
+    {
+        return startContainer((initial & 0xF0) == 0x80, initial & 0x0F);
+    }
+    if ((initial & 0xE0) == 0xA0)
+    {
+        valueType   = ValueType::Text;
+        textPending = initial & 0x1F;
+        return ParserToken::Value;
+    }
+
+    switch (initial)
+    {
+        case 0xC0:  valueType = ValueType::Null;                        return ParserToken::Value;
+        case 0xC2:  valueType = ValueType::Bool;    intValue = 0;       return ParserToken::Value;
+        case 0xC3:  valueType = ValueType::Bool;    intValue = 1;       return ParserToken::Value;
+
+        case 0xCC:  valueType = ValueType::Unsigned;intValue = readBigEndian(1);    return ParserToken::Value;
+        case 0xCD:  valueType = ValueType::Unsigned;intValue = readBigEndian(2);    return ParserToken::Value;
+        case 0xCE:  valueType = ValueType::Unsigned;intValue = readBigEndian(4);    return ParserToken::Value;
+        case 0xCF:  valueType = ValueType::Unsigned;intValue = readBigEndian(8);    return ParserToken::Value;
+
+        case 0xD0:  setSigned(static_cast<std::int8_t>(readBigEndian(1)));          return ParserToken::Value;
+        case 0xD1:  setSigned(static_cast<std::int16_t>(readBigEndian(2)));         return ParserToken::Value;
+        case 0xD2:  setSigned(static_cast<std::int32_t>(readBigEndian(4)));         return ParserToken::Value;
+        case 0xD3:  setSigned(static_cast<std::int64_t>(readBigEndian(8)));         return ParserToken::Value;
+
+        case 0xCA:
+        {
+            std::uint32_t   bits = static_cast<std::uint32_t>(readBigEndian(4));
+            float           value;
+            std::memcpy(&value, &bits, sizeof(value));
+            valueType   = ValueType::Float;
+            floatValue  = value;
+            return ParserToken::Value;
+        }
+        case 0xCB:
+        {
+            std::uint64_t   bits = readBigEndian(8);
+            std::memcpy(&floatValue, &bits, sizeof(floatValue));
+            valueType   = ValueType::Float;
+            return ParserToken::Value;
+        }
+
+        // str 8/16/32 and bin 8/16/32
+        case 0xD9: case 0xC4:   valueType = ValueType::Text;    textPending = readBigEndian(1);     return ParserToken::Value;
+        case 0xDA: case 0xC5:   valueType = ValueType::Text;    textPending = readBigEndian(2);     return ParserToken::Value;
+        case 0xDB: case 0xC6:   valueType = ValueType::Text;    textPending = readBigEndian(4);     return ParserToken::Value;
+
+        // fixext 1/2/4/8/16 and ext 8/16/32: The type byte follows the size.
+        case 0xD4:  textPending = 1;                    readByte(); valueType = ValueType::Text;    return ParserToken::Value;
+        case 0xD5:  textPending = 2;                    readByte(); valueType = ValueType::Text;    return ParserToken::Value;
+        case 0xD6:  textPending = 4;                    readByte(); valueType = ValueType::Text;    return ParserToken::Value;
+        case 0xD7:  textPending = 8;                    readByte(); valueType = ValueType::Text;    return ParserToken::Value;
+        case 0xD8:  textPending = 16;                   readByte(); valueType = ValueType::Text;    return ParserToken::Value;
+        case 0xC7:  textPending = readBigEndian(1);     readByte(); valueType = ValueType::Text;    return ParserToken::Value;
+        case 0xC8:  textPending = readBigEndian(2);     readByte(); valueType = ValueType::Text;    return ParserToken::Value;
+        case 0xC9:  textPending = readBigEndian(4);     readByte(); valueType = ValueType::Text;    return ParserToken::Value;
+
+        case 0xDC:  return startContainer(false, readBigEndian(2));
+        case 0xDD:  return startContainer(false, readBigEndian(4));
+        case 0xDE:  return startContainer(true,  readBigEndian(2));
+        case 0xDF:  return startContainer(true,  readBigEndian(4));
+    }
+    throw std::runtime_error("ThorsAnvil::Serialize::MsgPackParser::readItem: Invalid type byte (0xC1)");
+}
+
+HEADER_ONLY_INCLUDE
+ParserToken MsgPackParser::startContainer(bool isMap, std::uint64_t size)
+{
+    // Note: Set the value type so isValueNull() is not left over from the previous value.
+    state.push_back(Container{isMap, size, isMap});
+    valueType   = ValueType::Container;
+    return isMap ? ParserToken::MapStart : ParserToken::ArrayStart;
+}
+
+HEADER_ONLY_INCLUDE
+ParserToken MsgPackParser::endContainer()
+{
+    bool isMap = state.back().isMap;
+    state.pop_back();
+    if (state.empty())
+    {
+        stage = Stage::DocEnd;
+    }
+    return isMap ? ParserToken::MapEnd : ParserToken::ArrayEnd;
+}
+
+HEADER_ONLY_INCLUDE
+ParserToken MsgPackParser::getNextToken()
+{
+    switch (stage)
+    {
+        case Stage::DocStart:
+            stage = Stage::Body;
+            return ParserToken::DocStart;
+        case Stage::DocEnd:
+            skipText();
+            stage = Stage::Done;
+            return ParserToken::DocEnd;
+        case Stage::Done:
+            return ParserToken::Error;
+        case Stage::Body:
+            break;
+    }
+
+    // If the previous value was not used skip over it.
+    skipText();
+
+    if (state.empty())
+    {
+        // The root item.
+        ParserToken result = readItem();
+        if (result == ParserToken::Value)
+        {
+            stage = Stage::DocEnd;
+        }
+        return result;
+    }
+
+    Container&  top = state.back();
+    if ((!top.isMap || top.expectKey) && top.remaining == 0)
+    {
+        return endContainer();
+    }
+    if (top.isMap && top.expectKey)
+    {
+        if (readItem() != ParserToken::Value || valueType != ValueType::Text)
+        {
+            throw std::runtime_error("ThorsAnvil::Serialize::MsgPackParser::getNextToken: Map keys must be strings");
+        }
+        readText();
+        top.expectKey   = false;
+        return ParserToken::Key;
+    }
+
+    // Note: Count the element before reading it as reading may push a new container.
+    if (top.isMap)
+    {
+        top.expectKey = true;
+    }
+    --top.remaining;
+    return readItem();
+}
+
+HEADER_ONLY_INCLUDE
+std::string MsgPackParser::getKey()
+{
+    return textValue;
+}
+
+HEADER_ONLY_INCLUDE
+void MsgPackParser::ignoreDataValue()
+{
+    skipText();
+}
+
+template<typename T>
+inline T MsgPackParser::getSigned()
+{
+    using Limit = std::numeric_limits<T>;
+    if (valueType == ValueType::Unsigned && intValue <= static_cast<std::uint64_t>(Limit::max()))
+    {
+        return static_cast<T>(intValue);
+    }
+    if (valueType == ValueType::Negative && intValue <= static_cast<std::uint64_t>(Limit::max()))
+    {
+        return static_cast<T>(-1 - static_cast<T>(intValue));
+    }
+    throw std::runtime_error("ThorsAnvil::Serialize::MsgPackParser::getValue: Value is not an integer in range");
+}
+template<typename T>
+inline T MsgPackParser::getUnsigned()
+{
+    if (valueType == ValueType::Unsigned && intValue <= std::numeric_limits<T>::max())
+    {
+        return static_cast<T>(intValue);
+    }
+    throw std::runtime_error("ThorsAnvil::Serialize::MsgPackParser::getValue: Value is not an unsigned integer in range");
+}
+template<typename T>
+inline T MsgPackParser::getFloat()
+{
+    switch (valueType)
+    {
+        case ValueType::Float:      return static_cast<T>(floatValue);
+        case ValueType::Unsigned:   return static_cast<T>(intValue);
+        case ValueType::Negative:   return -1 - static_cast<T>(intValue);
+        default:
+            break;
+    }
+    throw std::runtime_error("ThorsAnvil::Serialize::MsgPackParser::getValue: Value is not a number");
+}
+
+HEADER_ONLY_INCLUDE void MsgPackParser::getValue(short& value)                      {value = getSigned<short>();}
+HEADER_ONLY_INCLUDE void MsgPackParser::getValue(int& value)                        {value = getSigned<int>();}
+HEADER_ONLY_INCLUDE void MsgPackParser::getValue(long& value)                       {value = getSigned<long>();}
+HEADER_ONLY_INCLUDE void MsgPackParser::getValue(long long& value)                  {value = getSigned<long long>();}
+
+HEADER_ONLY_INCLUDE void MsgPackParser::getValue(unsigned short& value)             {value = getUnsigned<unsigned short>();}
+HEADER_ONLY_INCLUDE void MsgPackParser::getValue(unsigned int& value)               {value = getUnsigned<unsigned int>();}
+HEADER_ONLY_INCLUDE void MsgPackParser::getValue(unsigned long& value)              {value = getUnsigned<unsigned long>();}
+HEADER_ONLY_INCLUDE void MsgPackParser::getValue(unsigned long long& value)         {value = getUnsigned<unsigned long long>();}
+
+HEADER_ONLY_INCLUDE void MsgPackParser::getValue(float& value)                      {value = getFloat<float>();}
+HEADER_ONLY_INCLUDE void MsgPackParser::getValue(double& value)                     {value = getFloat<double>();}
+HEADER_ONLY_INCLUDE void MsgPackParser::getValue(long double& value)                {value = getFloat<long double>();}
+
+HEADER_ONLY_INCLUDE
+void MsgPackParser::getValue(bool& value)
+{
+    if (valueType != ValueType::Bool)
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::MsgPackParser::getValue: Value is not a bool");
+    }
+    value = intValue != 0;
+}
+
+HEADER_ONLY_INCLUDE
+void MsgPackParser::getValue(std::string& value)
+{
+    std::string_view    view = getStringView();
+    value.assign(view.data(), view.size());
+}
+
+HEADER_ONLY_INCLUDE
+std::string_view MsgPackParser::getStringView()
+{
+    if (valueType != ValueType::Text)
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::MsgPackParser::getStringView: Value is not a string");
+    }
+    readText();
+    return std::string_view(textValue);
+}
+
+HEADER_ONLY_INCLUDE
+bool MsgPackParser::isValueNull()
+{
+    return valueType == ValueType::Null;
+}
+
+HEADER_ONLY_INCLUDE
+std::string MsgPackParser::getRawValue()
+{
+    switch (valueType)
+    {
+        case ValueType::Text:       readText(); return textValue;
+        case ValueType::Bool:       return intValue ? "true" : "false";
+        case ValueType::Null:       return "null";
+        case ValueType::Unsigned:   return std::to_string(intValue);
+        case ValueType::Negative:
+            if (intValue == std::numeric_limits<std::uint64_t>::max())
+            {
+                return "-18446744073709551616";
+            }
+            return "-" + std::to_string(intValue + 1);
+        case ValueType::Float:
+        {
+            std::stringstream   buffer;
+            buffer.precision(std::numeric_limits<double>::max_digits10);
+            buffer << floatValue;
+            return buffer.str();
+        }
+        case ValueType::Container:
+            break;
+    }
+    throw std::runtime_error("ThorsAnvil::Serialize::MsgPackParser::getRawValue: Unknown value type");
+}
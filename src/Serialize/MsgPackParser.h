@@ -0,0 +1,119 @@
+#ifndef THORS_ANVIL_SERIALIZE_MSGPACK_PARSER_H
+#define THORS_ANVIL_SERIALIZE_MSGPACK_PARSER_H
+/*
+ * MsgPackParser
+ *      This is used in conjunction with MsgPackPrinter
+ *
+ *      Together these provide an implementation of:
+ *          the ParserInterface
+ *          and PrinterInterface
+ *      for MessagePack (https://github.com/msgpack/msgpack/blob/master/spec.md)
+ *
+ *      Encoding choices made by the printer:
+ *          Integers:       Smallest encoding that holds the value (fixint when possible).
+ *          float/double:   float 32/float 64 (long double is written as double).
+ *          Strings/Keys:   str family (fixstr when possible).
+ *          Arrays:         Size passed to openArray() (fixarray when possible).
+ *          Maps:           Size counted and inserted when the map is closed (fixmap when possible).
+ *                          While a map is open its content is buffered in the printer.
+ *          Raw values:     String of the value as generated by operator<<
+ *
+ *      The parser accepts any MessagePack document where map keys are strings.
+ *      bin and ext values are read as strings (the ext type is ignored).
+ *
+ *      Strings are not copied out of the stream until they are used:
+ *          A value that is ignored is skipped without being read into memory.
+ *          getStringView() gives access to the current value without a copy.
+ *          The view is valid until the next token is read.
+ */
+
+#include "Serialize.h"
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+namespace ThorsAnvil
+{
+    namespace Serialize
+    {
+
+class MsgPackParser: public ParserInterface
+{
+    enum class Stage     {DocStart, Body, DocEnd, Done};
+    enum class ValueType {Unsigned, Negative, Float, Bool, Null, Text, Container};
+    struct Container
+    {
+        bool            isMap;
+        std::uint64_t   remaining;
+        bool            expectKey;
+    };
+
+    std::vector<Container>  state;
+    Stage                   stage;
+
+    ValueType               valueType;      // Type of the last token (Container for MapStart/ArrayStart).
+    std::uint64_t           intValue;
+    double                  floatValue;
+    std::string             textValue;
+    std::size_t             textPending;    // Bytes of the current string not yet read.
+
+    int             readByte();
+    std::uint64_t   readBigEndian(int size);
+    void            readText();
+    void            skipText();
+    void            setSigned(std::int64_t value);
+    ParserToken     readItem();
+    ParserToken     startContainer(bool isMap, std::uint64_t size);
+    ParserToken     endContainer();
+
+    template<typename T>
+    T getSigned();
+    template<typename T>
+    T getUnsigned();
+    template<typename T>
+    T getFloat();
+    public:
+        MsgPackParser(std::istream& stream, ParserConfig config = ParserConfig{});
+        virtual ParserToken getNextToken()                      override;
+        virtual std::string getKey()                            override;
+
+        virtual void    ignoreDataValue()                       override;
+
+        virtual void    getValue(short int& value)              override;
+        virtual void    getValue(int& value)                    override;
+        virtual void    getValue(long int& value)               override;
+        virtual void    getValue(long long int& value)          override;
+
+        virtual void    getValue(unsigned short int& value)     override;
+        virtual void    getValue(unsigned int& value)           override;
+        virtual void    getValue(unsigned long int& value)      override;
+        virtual void    getValue(unsigned long long int& value) override;
+
+        virtual void    getValue(float& value)                  override;
+        virtual void    getValue(double& value)                 override;
+        virtual void    getValue(long double& value)            override;
+
+        virtual void    getValue(bool& value)                   override;
+
+        virtual void    getValue(std::string& value)            override;
+        using ParserInterface::getValue;                        // Overloads that are not virtual.
+
+        virtual bool    isValueNull()                           override;
+
+        virtual std::string getRawValue()                       override;
+
+        virtual bool    isBinary() const                        override {return true;}
+
+        std::string_view    getStringView();
+};
+
+    }
+}
+
+#if defined(HEADER_ONLY) && HEADER_ONLY == 1
+#include "MsgPackParser.source"
+#endif
+
+#endif
@@ -0,0 +1,277 @@
+#include "SerializeConfig.h"
+#include "MsgPackPrinter.h"
+#include <cstring>
+
+using namespace ThorsAnvil::Serialize;
+
+namespace
+{
+    std::size_t const   unknownSize = static_cast<std::size_t>(-1);
+
+    template<typename Int>
+    void toBigEndian(char (&buffer)[sizeof(Int)], Int value)
+    {
+        for (std::size_t loop = 0; loop < sizeof(Int); ++loop)
+        {
+            buffer[sizeof(Int) - 1 - loop] = static_cast<char>(value & 0xFF);
+            value >>= 8;
+        }
+    }
+
+    // Smallest header for a map/array with size elements.
+    std::string containerHeader(bool isArray, std::size_t size)
+    {
+        std::string     result;
+        if (size <= 15)
+        {
+            result.push_back(static_cast<char>((isArray ? 0x90 : 0x80) | size));
+        }
+        else if (size <= 0xFFFF)
+        {
+            char    value[2];
+            toBigEndian(value, static_cast<std::uint16_t>(size));
+            result.push_back(static_cast<char>(isArray ? 0xDC : 0xDE));
+            result.append(value, 2);
+        }
+        else
+        {
+            char    value[4];
+            toBigEndian(value, static_cast<std::uint32_t>(size));
+            result.push_back(static_cast<char>(isArray ? 0xDD : 0xDF));
+            result.append(value, 4);
+        }
+        return result;
+    }
+}
+
+HEADER_ONLY_INCLUDE
+MsgPackPrinter::MsgPackPrinter(std::ostream& output, PrinterConfig config)
+    : PrinterInterface(output, config)
+    , pending(0)
+{}
+
+HEADER_ONLY_INCLUDE
+void MsgPackPrinter::write(char const* data, std::size_t size)
+{
+    // While a container header still needs to be inserted the output is
+    // held in the buffer. Otherwise it goes straight to the stream.
+    if (pending == 0)
+    {
+        output.write(data, size);
+    }
+    else
+    {
+        buffer.append(data, size);
+    }
+}
+HEADER_ONLY_INCLUDE
+void MsgPackPrinter::writeByte(int value)
+{
+    char    data = static_cast<char>(value);
+    write(&data, 1);
+}
+template<typename Int>
+inline void MsgPackPrinter::writeInt(int marker, Int value)
+{
+    char    data[sizeof(Int)];
+    toBigEndian(data, value);
+    writeByte(marker);
+    write(data, sizeof(Int));
+}
+HEADER_ONLY_INCLUDE
+void MsgPackPrinter::writeSigned(std::int64_t value)
+{
+    if (value >= 0)
+    {
+        writeUnsigned(static_cast<std::uint64_t>(value));
+        return;
+    }
+    addElement();
+    if (value >= -32)                       {writeByte(static_cast<int>(value) & 0xFF);}        // negative fixint
+    else if (value >= INT8_MIN)             {writeInt(0xD0, static_cast<std::uint8_t>(value));}
+    else if (value >= INT16_MIN)            {writeInt(0xD1, static_cast<std::uint16_t>(value));}
+    else if (value >= INT32_MIN)            {writeInt(0xD2, static_cast<std::uint32_t>(value));}
+    else                                    {writeInt(0xD3, static_cast<std::uint64_t>(value));}
+}
+HEADER_ONLY_INCLUDE
+void MsgPackPrinter::writeUnsigned(std::uint64_t value)
+{
+    addElement();
+    if (value <= 0x7F)                      {writeByte(static_cast<int>(value));}               // positive fixint
+    else if (value <= 0xFF)                 {writeInt(0xCC, static_cast<std::uint8_t>(value));}
+    else if (value <= 0xFFFF)               {writeInt(0xCD, static_cast<std::uint16_t>(value));}
+    else if (value <= 0xFFFFFFFF)           {writeInt(0xCE, static_cast<std::uint32_t>(value));}
+    else                                    {writeInt(0xCF, value);}
+}
+HEADER_ONLY_INCLUDE
+void MsgPackPrinter::writeString(char const* value, std::size_t size)
+{
+    if (size <= 31)                         {writeByte(0xA0 | static_cast<int>(size));}         // fixstr
+    else if (size <= 0xFF)                  {writeInt(0xD9, static_cast<std::uint8_t>(size));}
+    else if (size <= 0xFFFF)                {writeInt(0xDA, static_cast<std::uint16_t>(size));}
+    else                                    {writeInt(0xDB, static_cast<std::uint32_t>(size));}
+    write(value, size);
+}
+HEADER_ONLY_INCLUDE
+void MsgPackPrinter::addElement()
+{
+    if (!state.empty() && state.back().isArray)
+    {
+        ++state.back().count;
+    }
+}
+HEADER_ONLY_INCLUDE
+void MsgPackPrinter::openContainer(bool isArray, std::size_t size)
+{
+    addElement();
+    if (size != unknownSize)
+    {
+        std::string header = containerHeader(isArray, size);
+        write(header.data(), header.size());
+        state.push_back(Container{isArray, false, 0, size, 0});
+    }
+    else
+    {
+        ++pending;
+        state.push_back(Container{isArray, true, buffer.size(), size, 0});
+    }
+}
+HEADER_ONLY_INCLUDE
+void MsgPackPrinter::closeContainer(bool isArray)
+{
+    Container   container = state.back();
+    state.pop_back();
+    if (!container.patch)
+    {
+        if (container.expected != container.count)
+        {
+            throw std::runtime_error("ThorsAnvil::Serialize::MsgPackPrinter: Invalid call to closeArray(): Number of elements does not match the size passed to openArray()");
+        }
+        return;
+    }
+    buffer.insert(container.offset, containerHeader(isArray, container.count));
+    --pending;
+    if (pending == 0)
+    {
+        output.write(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+}
+
+HEADER_ONLY_INCLUDE
+void MsgPackPrinter::openDoc()
+{}
+HEADER_ONLY_INCLUDE
+void MsgPackPrinter::closeDoc()
+{}
+
+HEADER_ONLY_INCLUDE
+void MsgPackPrinter::openMap()
+{
+    // The number of members is not known until closeMap().
+    // So the header is inserted when the map is closed.
+    openContainer(false, unknownSize);
+}
+HEADER_ONLY_INCLUDE
+void MsgPackPrinter::closeMap()
+{
+    if (state.empty() || state.back().isArray)
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::MsgPackPrinter: Invalid call to closeMap(): Currently not in a map");
+    }
+    closeContainer(false);
+}
+HEADER_ONLY_INCLUDE
+void MsgPackPrinter::openArray(std::size_t size)
+{
+    openContainer(true, size);
+}
+HEADER_ONLY_INCLUDE
+void MsgPackPrinter::closeArray()
+{
+    if (state.empty() || !state.back().isArray)
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::MsgPackPrinter: Invalid call to closeArray(): Currently not in an array");
+    }
+    closeContainer(true);
+}
+
+HEADER_ONLY_INCLUDE
+void MsgPackPrinter::addKey(std::string const& key)
+{
+    if (state.empty() || state.back().isArray)
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::MsgPackPrinter: Invalid call to addKey(): Currently not in a map");
+    }
+    ++state.back().count;
+    writeString(key.data(), key.size());
+}
+HEADER_ONLY_INCLUDE
+void MsgPackPrinter::addKey(MemberKey const& key)
+{
+    if (state.empty() || state.back().isArray)
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::MsgPackPrinter: Invalid call to addKey(): Currently not in a map");
+    }
+    ++state.back().count;
+    writeString(key.name, std::strlen(key.name));
+}
+
+HEADER_ONLY_INCLUDE void MsgPackPrinter::addValue(short value)                 {writeSigned(value);}
+HEADER_ONLY_INCLUDE void MsgPackPrinter::addValue(int value)                   {writeSigned(value);}
+HEADER_ONLY_INCLUDE void MsgPackPrinter::addValue(long value)                  {writeSigned(value);}
+HEADER_ONLY_INCLUDE void MsgPackPrinter::addValue(long long value)             {writeSigned(value);}
+
+HEADER_ONLY_INCLUDE void MsgPackPrinter::addValue(unsigned short value)        {writeUnsigned(value);}
+HEADER_ONLY_INCLUDE void MsgPackPrinter::addValue(unsigned int value)          {writeUnsigned(value);}
+HEADER_ONLY_INCLUDE void MsgPackPrinter::addValue(unsigned long value)         {writeUnsigned(value);}
+HEADER_ONLY_INCLUDE void MsgPackPrinter::addValue(unsigned long long value)    {writeUnsigned(value);}
+
+HEADER_ONLY_INCLUDE
+void MsgPackPrinter::addValue(float value)
+{
+    addElement();
+    std::uint32_t   bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeInt(0xCA, bits);
+}
+HEADER_ONLY_INCLUDE
+void MsgPackPrinter::addValue(double value)
+{
+    addElement();
+    std::uint64_t   bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeInt(0xCB, bits);
+}
+// MessagePack has no extended precision type.
+HEADER_ONLY_INCLUDE void MsgPackPrinter::addValue(long double value)           {addValue(static_cast<double>(value));}
+
+HEADER_ONLY_INCLUDE
+void MsgPackPrinter::addValue(bool value)
+{
+    addElement();
+    writeByte(value ? 0xC3 : 0xC2);
+}
+
+HEADER_ONLY_INCLUDE
+void MsgPackPrinter::addValue(std::string const& value)
+{
+    addElement();
+    writeString(value.data(), value.size());
+}
+
+HEADER_ONLY_INCLUDE
+void MsgPackPrinter::addRawValue(std::string const& value)
+{
+    // Raw values are the text generated by operator<<
+    // So they are stored as a string and handed back to operator>> by the parser.
+    addElement();
+    writeString(value.data(), value.size());
+}
+
+HEADER_ONLY_INCLUDE
+void MsgPackPrinter::addNull()
+{
+    addElement();
+    writeByte(0xC0);
+}
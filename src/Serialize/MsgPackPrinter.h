@@ -0,0 +1,88 @@
+#ifndef THORS_ANVIL_SERIALIZE_MSGPACK_PRINTER_H
+#define THORS_ANVIL_SERIALIZE_MSGPACK_PRINTER_H
+/*
+ * MsgPackPrinter
+ *  See documentation in MsgPackParser.h
+ */
+
+#include "Serialize.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace ThorsAnvil
+{
+    namespace Serialize
+    {
+
+class MsgPackPrinter: public PrinterInterface
+{
+    struct Container
+    {
+        bool            isArray;
+        bool            patch;      // Header is inserted at offset when the container is closed.
+        std::size_t     offset;
+        std::size_t     expected;
+        std::size_t     count;
+    };
+    std::vector<Container>  state;
+    std::string             buffer;
+    std::size_t             pending;
+
+    void write(char const* data, std::size_t size);
+    void writeByte(int value);
+    template<typename Int>
+    void writeInt(int marker, Int value);
+    void writeSigned(std::int64_t value);
+    void writeUnsigned(std::uint64_t value);
+    void writeString(char const* value, std::size_t size);
+    void addElement();
+    void openContainer(bool isArray, std::size_t size);
+    void closeContainer(bool isArray);
+    public:
+        MsgPackPrinter(std::ostream& output, PrinterConfig config = PrinterConfig{});
+        virtual void openDoc()                              override;
+        virtual void closeDoc()                             override;
+
+        virtual void openMap()                              override;
+        virtual void closeMap()                             override;
+        virtual void openArray(std::size_t size)            override;
+        virtual void closeArray()                           override;
+
+        virtual void addKey(std::string const& key)         override;
+        virtual void addKey(MemberKey const& key)           override;
+
+        virtual void addValue(short int value)              override;
+        virtual void addValue(int value)                    override;
+        virtual void addValue(long int value)               override;
+        virtual void addValue(long long int value)          override;
+
+        virtual void addValue(unsigned short int value)     override;
+        virtual void addValue(unsigned int value)           override;
+        virtual void addValue(unsigned long int value)      override;
+        virtual void addValue(unsigned long long int value) override;
+
+        virtual void addValue(float value)                  override;
+        virtual void addValue(double value)                 override;
+        virtual void addValue(long double value)            override;
+
+        virtual void addValue(bool value)                   override;
+
+        virtual void addValue(std::string const& value)     override;
+        using PrinterInterface::addValue;                    // Overloads that are not virtual.
+
+        virtual void addRawValue(std::string const& value)  override;
+
+        virtual void addNull()                              override;
+
+        virtual bool isBinary() const                       override {return true;}
+};
+
+    }
+}
+
+#if defined(HEADER_ONLY) && HEADER_ONLY == 1
+#include "MsgPackPrinter.source"
+#endif
+
+#endif
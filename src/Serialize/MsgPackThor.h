@@ -0,0 +1,55 @@
+#ifndef THORS_ANVIL_SERIALIZE_MSGPACK_H
+#define THORS_ANVIL_SERIALIZE_MSGPACK_H
+/*
+ * Defines the MsgPack Serialization interface
+ *      ThorsAnvil::Serialize::MsgPack
+ *      ThorsAnvil::Serialize::msgpackExport
+ *      ThorsAnvil::Serialize::msgpackImport
+ *
+ * Usage:
+ *      std::cout << msgpackExport(object); // converts object to MsgPack on an output stream
+ *      std::cin  >> msgpackImport(object); // converts MsgPack to a C++ object from an input stream
+ *
+ * Note: The streams should be opened in binary mode.
+ */
+
+#include "MsgPackParser.h"
+#include "MsgPackPrinter.h"
+#include "Exporter.h"
+#include "Importer.h"
+
+namespace ThorsAnvil
+{
+    namespace Serialize
+    {
+
+struct MsgPack
+{
+    using Parser  = MsgPackParser;
+    using Printer = MsgPackPrinter;
+};
+
+// @function-api
+// @param value             The object to be serialized.
+// @param config            Printer configuration. The output type is ignored (MsgPack has only one form).
+// @param catchExceptions   'false:    exceptions propogate.   'true':   parsing exceptions are stopped.
+// @return                  Object that can be passed to operator<< for serialization.
+template<typename T>
+Exporter<MsgPack, T> msgpackExport(T const& value, PrinterInterface::PrinterConfig config = PrinterInterface::PrinterConfig{}, bool catchExceptions = false)
+{
+    return Exporter<MsgPack, T>(value, config, catchExceptions);
+}
+// @function-api
+// @param value             The object to be de-serialized.
+// @param parseStrictness   'Weak':    ignore missing extra fields. 'Strict': Any missing or extra fields throws exception.
+// @param catchExceptions   'false:    exceptions propogate.        'true':   parsing exceptions are stopped.
+// @return                  Object that can be passed to operator>> for de-serialization.
+template<typename T>
+Importer<MsgPack, T> msgpackImport(T& value, ParserInterface::ParserConfig config = ParserInterface::ParserConfig{}, bool catchExceptions = false)
+{
+    return Importer<MsgPack, T>(value, config, catchExceptions);
+}
+    }
+}
+
+#endif
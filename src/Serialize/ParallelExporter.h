@@ -0,0 +1,157 @@
+#ifndef THORS_ANVIL_SERIALIZE_PARALLEL_EXPORTER_H
+#define THORS_ANVIL_SERIALIZE_PARALLEL_EXPORTER_H
+/*
+ * The ParallelExporter is an Exporter for large top level arrays.
+ *
+ * The container is split into (roughly) equal runs of elements. Each run is
+ * printed on its own thread into a separate buffer by its own printer.
+ * The buffers are then written to the output stream in order between the
+ * open and close of the array.
+ *
+ * When PrinterConfig::stats is set each chunk collects its own stats (SerializeStats
+ * is not thread safe). They are merged into config.stats once all chunks are done.
+ *
+ * The printer must support this (see PrinterInterface::canPrintArrayChunk()).
+ * If it does not (or there is not enough work to split) the container is
+ * printed exactly as the normal Exporter would print it.
+ *
+ * Usage:
+ *      std::cout << ParallelExport<Json>(bigVector);
+ *      std::cout << ParallelExport<Json>(bigVector, 4);    // Use 4 threads.
+ */
+
+#include "Serialize.h"
+#include "SerUtil.h"
+#include <sstream>
+#include <string>
+#include <vector>
+#include <future>
+#include <thread>
+#include <iterator>
+#include <algorithm>
+
+namespace ThorsAnvil
+{
+    namespace Serialize
+    {
+
+template<typename Format, typename T>
+class ParallelExporter
+{
+    static_assert(
+        Traits<T>::type == TraitType::Array,
+        "ParallelExporter can only be used on containers that are serialized as an Array"
+    );
+
+    using PrinterConfig = PrinterInterface::PrinterConfig;
+    using Iterator      = typename T::const_iterator;
+    using ValueType     = typename T::value_type;
+
+    T const&        value;
+    std::size_t     threadCount;
+    PrinterConfig   config;
+    bool            catchException;
+    public:
+        ParallelExporter(T const& value, std::size_t threadCount, PrinterConfig config, bool catchException = false)
+            : value(value)
+            , threadCount(threadCount)
+            , config(config)
+            , catchException(catchException)
+        {}
+        friend std::ostream& operator<<(std::ostream& stream, ParallelExporter const& data)
+        {
+            try
+            {
+                data.print(stream);
+            }
+            catch (...)
+            {
+                stream.setstate(std::ios::failbit);
+                if (!data.catchException)
+                {
+                    throw;
+                }
+            }
+
+            return stream;
+        }
+    private:
+        void print(std::ostream& stream) const
+        {
+            typename Format::Printer    printer(stream, config);
+            Serializer                  serializer(printer);
+
+            std::size_t size    = std::distance(std::begin(value), std::end(value));
+            std::size_t chunks  = std::min(threadCount, size);
+            // Shared objects are identified across the whole document.
+            // So they can not be printed in independent chunks.
+            if (chunks < 2 || !printer.canPrintArrayChunk() || config.preserveSharedPtr)
+            {
+                serializer.print(value);
+                return;
+            }
+
+            std::vector<std::future<std::string>>   results;
+            std::vector<SerializeStats>             chunkStats(config.stats ? chunks : 0);
+            results.reserve(chunks);
+
+            Iterator    begin   = std::begin(value);
+            std::size_t index   = 0;
+            for (std::size_t loop = 0; loop < chunks; ++loop)
+            {
+                std::size_t count   = size / chunks + (loop < size % chunks ? 1 : 0);
+                Iterator    end     = std::next(begin, count);
+                SerializeStats* stats   = config.stats ? &chunkStats[loop] : nullptr;
+                results.emplace_back(std::async(std::launch::async, &ParallelExporter::printChunk, this, begin, end, index, stats));
+
+                begin   = end;
+                index  += count;
+            }
+
+            printer.openArray(size);
+            for (auto& result: results)
+            {
+                // Note: get() re-throws any exception thrown while printing the chunk.
+                std::string chunk = result.get();
+                stream.write(chunk.data(), chunk.size());
+            }
+            printer.closeArray();
+            for (auto const& stats: chunkStats)
+            {
+                config.stats->merge(stats);
+            }
+        }
+        std::string printChunk(Iterator begin, Iterator end, std::size_t index, SerializeStats* stats) const
+        {
+            PrinterConfig               chunkConfig(config);
+            chunkConfig.stats = stats;
+
+            std::stringstream           buffer;
+            typename Format::Printer    printer(buffer, chunkConfig);
+            printer.openArrayChunk(index);
+            {
+                PutValueType<ValueType>     valuePutter(printer);
+                for (; begin != end; ++begin)
+                {
+                    valuePutter.putValue(*begin);
+                }
+            }
+            printer.closeArrayChunk();
+            return buffer.str();
+        }
+};
+
+// @function-api
+// @param value             The container to be serialized.
+// @param threadCount       The maximum number of threads used to print the container.
+// @return                  Object that can be passed to operator<< for serialization.
+template<typename Format, typename T>
+ParallelExporter<Format, T> ParallelExport(T const& value, std::size_t threadCount = std::thread::hardware_concurrency(), PrinterInterface::PrinterConfig config = PrinterInterface::PrinterConfig{}, bool catchExceptions = false)
+{
+    return ParallelExporter<Format, T>(value, threadCount, config, catchExceptions);
+}
+
+    }
+}
+
+#endif
@@ -0,0 +1,122 @@
+#include "SerializeConfig.h"
+#include "RawNumber.h"
+#include <stdexcept>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+
+using namespace ThorsAnvil::Serialize;
+
+HEADER_ONLY_INCLUDE
+RawNumber::RawNumber(std::string_view text)
+    : length(text.size())
+{
+    if (!isValid(text))
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::RawNumber::RawNumber: Not a number: " + std::string(text));
+    }
+    if (length <= localSize)
+    {
+        std::memcpy(local, text.data(), length);
+    }
+    else
+    {
+        overflow.assign(text.data(), length);
+    }
+}
+
+HEADER_ONLY_INCLUDE
+bool RawNumber::isValid(std::string_view text)
+{
+    // Json number: -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+    auto        loop    = std::begin(text);
+    auto        end     = std::end(text);
+    auto digits = [&loop, end]()
+    {
+        auto start = loop;
+        while (loop != end && *loop >= '0' && *loop <= '9')
+        {
+            ++loop;
+        }
+        return loop - start;
+    };
+
+    if (loop != end && *loop == '-')
+    {
+        ++loop;
+    }
+    if (loop != end && *loop == '0')
+    {
+        ++loop;
+    }
+    else if (digits() == 0)
+    {
+        return false;
+    }
+    if (loop != end && *loop == '.')
+    {
+        ++loop;
+        if (digits() == 0)
+        {
+            return false;
+        }
+    }
+    if (loop != end && (*loop == 'e' || *loop == 'E'))
+    {
+        ++loop;
+        if (loop != end && (*loop == '+' || *loop == '-'))
+        {
+            ++loop;
+        }
+        if (digits() == 0)
+        {
+            return false;
+        }
+    }
+    return loop == end;
+}
+
+HEADER_ONLY_INCLUDE
+bool RawNumber::isInteger() const
+{
+    return !empty() && text().find_first_of(".eE") == std::string_view::npos;
+}
+
+HEADER_ONLY_INCLUDE
+long long int RawNumber::asInteger() const
+{
+    if (!hasInteger)
+    {
+        if (!isInteger())
+        {
+            throw std::runtime_error("ThorsAnvil::Serialize::RawNumber::asInteger: Not an integer: " + std::string(text()));
+        }
+        // The text is a valid number so strtoll() uses all of it.
+        // But it may not be null terminated (local buffer is full).
+        std::string     value(text());
+        errno           = 0;
+        integerValue    = std::strtoll(value.c_str(), nullptr, 10);
+        if (errno == ERANGE)
+        {
+            throw std::runtime_error("ThorsAnvil::Serialize::RawNumber::asInteger: Out of range: " + value);
+        }
+        hasInteger      = true;
+    }
+    return integerValue;
+}
+
+HEADER_ONLY_INCLUDE
+double RawNumber::asDouble() const
+{
+    if (!hasDouble)
+    {
+        if (empty())
+        {
+            throw std::runtime_error("ThorsAnvil::Serialize::RawNumber::asDouble: No value");
+        }
+        std::string     value(text());
+        doubleValue     = std::strtod(value.c_str(), nullptr);
+        hasDouble       = true;
+    }
+    return doubleValue;
+}
@@ -0,0 +1,81 @@
+#ifndef THORS_ANVIL_SERIALIZE_RAW_NUMBER_H
+#define THORS_ANVIL_SERIALIZE_RAW_NUMBER_H
+
+/*
+ * A number that keeps the text it was parsed from.
+ *
+ * Usage:
+ *      struct Order
+ *      {
+ *          RawNumber   id;         // Forwarded: never converted.
+ *          RawNumber   price;
+ *      };
+ *      ThorsAnvil_MakeTrait(Order, id, price);
+ *
+ *      stream >> jsonImport(order);
+ *      double price = order.price.asDouble();     // Converted (once) when used.
+ *      std::cout << jsonExport(order);             // Printed with the original text.
+ *
+ * Parsing a RawNumber only copies the text of the number (short numbers are held
+ * in the object itself). The conversion happens on first access and the result
+ * is cached. When printed the original text is written unchanged, so integers that
+ * do not fit in any integer type keep their exact value.
+ *
+ * Only supported by text formats (Json/Yaml). Binary formats throw.
+ * A default constructed RawNumber has no value: converting or printing it throws.
+ */
+
+#include "Traits.h"
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+namespace ThorsAnvil
+{
+    namespace Serialize
+    {
+
+class RawNumber
+{
+    static constexpr std::size_t localSize = 24;
+
+    std::size_t                 length      = 0;
+    char                        local[localSize];
+    std::string                 overflow;           // Only used for text longer than localSize.
+
+    mutable bool                hasInteger  = false;
+    mutable bool                hasDouble   = false;
+    mutable long long int       integerValue;
+    mutable double              doubleValue;
+
+    public:
+        RawNumber() = default;
+        // Throws std::runtime_error if text is not a number.
+        explicit RawNumber(std::string_view text);
+
+        std::string_view    text() const    {return std::string_view(length <= localSize ? local : overflow.data(), length);}
+        bool                empty() const   {return length == 0;}
+        // True if the text has no fraction or exponent.
+        bool                isInteger() const;
+
+        // Converted on first use and cached.
+        // asInteger() throws if the text is not an integer or does not fit in a long long.
+        long long int       asInteger() const;
+        double              asDouble() const;
+
+        static bool         isValid(std::string_view text);
+
+        friend bool operator==(RawNumber const& lhs, RawNumber const& rhs) {return lhs.text() == rhs.text();}
+        friend bool operator!=(RawNumber const& lhs, RawNumber const& rhs) {return lhs.text() != rhs.text();}
+};
+
+template<> class Traits<RawNumber>              {public: static constexpr TraitType type = TraitType::Value;};
+
+    }
+}
+
+#if defined(HEADER_ONLY) && HEADER_ONLY == 1
+#include "RawNumber.source"
+#endif
+
+#endif
@@ -35,6 +35,7 @@
  * Traits<std::multiset<K>>
  * Traits<std::map<K,V>>
  *      Traits<std::map<std::string,V>>
+ *      Traits<std::map<InternedString,V>>
  * Traits<std::multimap<K,V>>
  *      Traits<std::multimap<std::string,V>>
  *
@@ -44,6 +45,7 @@
  * Traits<std::unordered_multiset<K>>
  * Traits<std::unordered_map<K,V>>
  *      Traits<std::unordered_map<std::string,V>>
+ *      Traits<std::unordered_map<InternedString,V>>
  * Traits<std::unordered_multimap<K,V>>
  *      Traits<std::unordered_multimap<std::string,V>>
  * Traits<std::initializer_list<T>>
@@ -66,9 +68,10 @@ template<typename V, TraitType type = Traits<V>::type>
 class GetValueType
 {
     public:
-        GetValueType(ParserInterface& parser, V& value)
+        template<typename Parser>
+        GetValueType(Parser& parser, V& value)
         {
-            DeSerializer            deSerializer(parser, false);
+            BasicDeSerializer<Parser>   deSerializer(parser, false);
             deSerializer.parse(value);
         }
 };
@@ -77,10 +80,12 @@ template<typename V>
 class GetValueType<V, TraitType::Value>
 {
     public:
-        GetValueType(ParserInterface& parser, V& value)
+        template<typename Parser>
+        GetValueType(Parser& parser, V& value)
         {
             if (parser.getToken() != ThorsAnvil::Serialize::ParserInterface::ParserToken::Value)
-            {   throw std::runtime_error("ThorsAnvil::Serializer::SerMap::GetValueType::GetValueType<Value>: Expecting a normal value after the key");
+            {   parser.parseError(ThorsAnvil::Serialize::ParserInterface::ErrorCode::UnexpectedToken, "ThorsAnvil::Serializer::SerMap::GetValueType::GetValueType<Value>: Expecting a normal value after the key");
+                return;
             }
             parser.getValue(value);
         }
@@ -92,12 +97,12 @@ class GetValueType<V, TraitType::Value>
  * A normal value is put directly onto the stream (via the printer object).
  * A compound type Map/Array is printed to the stream using a Serializer.
  */
-template<typename V, TraitType type = Traits<V>::type>
+template<typename V, TraitType type = Traits<V>::type, typename Printer = PrinterInterface>
 class PutValueType
 {
-    Serializer      serializer;
+    BasicSerializer<Printer>    serializer;
     public:
-        PutValueType(PrinterInterface& printer)
+        PutValueType(Printer& printer)
             : serializer(printer, false)
         {}
         void putValue(V const& value)
@@ -106,12 +111,12 @@ class PutValueType
         }
 };
 
-template<typename V>
-class PutValueType<V, TraitType::Value>
+template<typename V, typename Printer>
+class PutValueType<V, TraitType::Value, Printer>
 {
-    PrinterInterface&   printer;
+    Printer&            printer;
     public:
-        PutValueType(PrinterInterface& printer)
+        PutValueType(Printer& printer)
             : printer(printer)
         {}
 
@@ -152,19 +157,21 @@ class ContainerMemberExtractorInserter
 {
     public:
         constexpr ContainerMemberExtractorInserter() {}
-        constexpr std::size_t getHash(std::size_t start) const
+        constexpr THash getHash(THash start) const
         {
             return thash<C>(start);
         }
-        void operator()(PrinterInterface& printer, C const& object) const
+        template<typename Printer>
+        void operator()(Printer& printer, C const& object) const
         {
-            PutValueType<V>     valuePutter(printer);
+            PutValueType<V, Traits<V>::type, Printer>     valuePutter(printer);
             for (auto const& loop: object)
             {
                 valuePutter.putValue(loop);
             }
         }
-        void operator()(ParserInterface& parser, std::size_t const& index, C& object) const
+        template<typename Parser>
+        void operator()(Parser& parser, std::size_t const& index, C& object) const
         {
             V                   data{};
             GetValueType<V>     valueGetter(parser, data);
@@ -178,19 +185,21 @@ class ContainerMemberExtractorEmplacer
 {
     public:
         constexpr ContainerMemberExtractorEmplacer() {}
-        constexpr std::size_t getHash(std::size_t start) const
+        constexpr THash getHash(THash start) const
         {
             return thash<C>(start);
         }
-        void operator()(PrinterInterface& printer, C const& object) const
+        template<typename Printer>
+        void operator()(Printer& printer, C const& object) const
         {
-            PutValueType<V>     valuePutter(printer);
+            PutValueType<V, Traits<V>::type, Printer>     valuePutter(printer);
             for (auto const& loop: object)
             {
                 valuePutter.putValue(loop);
             }
         }
-        void operator()(ParserInterface& parser, std::size_t const& index, C& object) const
+        template<typename Parser>
+        void operator()(Parser& parser, std::size_t const& index, C& object) const
         {
             MemberEmplacer<C>   extractor(object);
             V&                  data = extractor.get(index);
@@ -208,9 +217,9 @@ class Traits<std::pair<F, S>>
 
         using Members = std::tuple< REP_N(THOR_TYPEACTION, 00, Self, first, second, 1) >;
 
-        static Members const& getMembers()
+        static constexpr Members members{ REP_N(THOR_VALUEACTION, 00, Self, first, second, 1) };
+        static constexpr Members const& getMembers()
         {
-            static constexpr Members members{ REP_N(THOR_VALUEACTION, 00, Self, first, second, 1) };
             return members;
         }
 };
@@ -394,7 +403,10 @@ class MemberInserter<std::set<Key, Compare, Allocator>>
         {}
         void add(std::size_t const&, Key&& value)
         {
-            container.insert(std::forward<Key>(value));
+            // Printers write ordered containers in order. So the end hint makes
+            // loading them amortized constant time per element. Unsorted input
+            // is still inserted correctly (at the normal logarithmic cost).
+            container.insert(std::end(container), std::forward<Key>(value));
         }
 };
 
@@ -450,7 +462,8 @@ class MemberInserter<std::multiset<Key, Compare, Allocator>>
         {}
         void add(std::size_t const&, Key&& value)
         {
-            container.insert(std::forward<Key>(value));
+            // End hint: see MemberInserter<std::set<Key>>
+            container.insert(std::end(container), std::forward<Key>(value));
         }
 };
 
@@ -506,7 +519,8 @@ class MemberInserter<std::map<Key, T, Compare, Allocator>>
         {}
         void add(std::size_t const&, std::pair<Key, T>&& value)
         {
-            container.insert(std::forward<std::pair<Key, T>>(value));
+            // End hint: see MemberInserter<std::set<Key>>
+            container.insert(std::end(container), std::forward<std::pair<Key, T>>(value));
         }
 };
 
@@ -537,18 +551,61 @@ class Traits<std::map<std::string, Value>>
         {
             public:
                 constexpr MemberExtractor(){}
-                void operator()(PrinterInterface& printer, std::map<std::string, Value> const& object) const
+                template<typename Printer>
+                void operator()(Printer& printer, std::map<std::string, Value> const& object) const
                 {
-                    PutValueType<Value>     valuePutter(printer);
+                    PutValueType<Value, Traits<Value>::type, Printer>     valuePutter(printer);
                     for (auto const& loop: object)
                     {
                         printer.addKey(loop.first);
                         valuePutter.putValue(loop.second);
                     }
                 }
-                void operator()(ParserInterface& parser, std::string const& key, std::map<std::string, Value>& object) const
+                template<typename Parser>
+                void operator()(Parser& parser, std::string const& key, std::map<std::string, Value>& object) const
+                {
+                    // End hint: see MemberInserter<std::set<Key>>
+                    Value&                  data = object.try_emplace(std::end(object), key)->second;
+                    GetValueType<Value>     valueGetter(parser, data);
+                }
+        };
+
+        static MemberExtractor const& getMembers()
+        {
+            static constexpr MemberExtractor    memberExtractor;
+            return memberExtractor;
+        }
+};
+
+/*
+ * std::map<> with an InternedString key is also represented by a Json Map object.
+ * The keys are interned in ParserConfig::stringPool (see StringPool.h).
+ */
+template<typename Value>
+class Traits<std::map<InternedString, Value>>
+{
+    public:
+        static constexpr TraitType type = TraitType::Map;
+
+        class MemberExtractor
+        {
+            public:
+                constexpr MemberExtractor(){}
+                template<typename Printer>
+                void operator()(Printer& printer, std::map<InternedString, Value> const& object) const
+                {
+                    PutValueType<Value, Traits<Value>::type, Printer>     valuePutter(printer);
+                    for (auto const& loop: object)
+                    {
+                        printer.addKey(loop.first.str());
+                        valuePutter.putValue(loop.second);
+                    }
+                }
+                template<typename Parser>
+                void operator()(Parser& parser, std::string const& key, std::map<InternedString, Value>& object) const
                 {
-                    Value&                  data = object[key];
+                    // End hint: see MemberInserter<std::set<Key>>
+                    Value&                  data = object.try_emplace(std::end(object), parser.intern(key))->second;
                     GetValueType<Value>     valueGetter(parser, data);
                 }
         };
@@ -602,16 +659,18 @@ class Traits<std::unordered_map<std::string, Value>>
         {
             public:
                 constexpr MemberExtractor(){}
-                void operator()(PrinterInterface& printer, std::unordered_map<std::string, Value> const& object) const
+                template<typename Printer>
+                void operator()(Printer& printer, std::unordered_map<std::string, Value> const& object) const
                 {
-                    PutValueType<Value>     valuePutter(printer);
+                    PutValueType<Value, Traits<Value>::type, Printer>     valuePutter(printer);
                     for (auto const& loop: object)
                     {
                         printer.addKey(loop.first);
                         valuePutter.putValue(loop.second);
                     }
                 }
-                void operator()(ParserInterface& parser, std::string const& key, std::unordered_map<std::string, Value>& object) const
+                template<typename Parser>
+                void operator()(Parser& parser, std::string const& key, std::unordered_map<std::string, Value>& object) const
                 {
                     Value                   data{};
                     GetValueType<Value>     valueGetter(parser, data);
@@ -626,6 +685,46 @@ class Traits<std::unordered_map<std::string, Value>>
         }
 };
 
+/*
+ * std::unordered_map<> with an InternedString key is also represented by a Json Map object.
+ * The keys are interned in ParserConfig::stringPool (see StringPool.h).
+ */
+template<typename Value>
+class Traits<std::unordered_map<InternedString, Value>>
+{
+    public:
+        static constexpr TraitType type = TraitType::Map;
+
+        class MemberExtractor
+        {
+            public:
+                constexpr MemberExtractor(){}
+                template<typename Printer>
+                void operator()(Printer& printer, std::unordered_map<InternedString, Value> const& object) const
+                {
+                    PutValueType<Value, Traits<Value>::type, Printer>     valuePutter(printer);
+                    for (auto const& loop: object)
+                    {
+                        printer.addKey(loop.first.str());
+                        valuePutter.putValue(loop.second);
+                    }
+                }
+                template<typename Parser>
+                void operator()(Parser& parser, std::string const& key, std::unordered_map<InternedString, Value>& object) const
+                {
+                    Value                   data{};
+                    GetValueType<Value>     valueGetter(parser, data);
+                    object.insert(std::make_pair(parser.intern(key), std::move(data)));
+                }
+        };
+
+        static MemberExtractor const& getMembers()
+        {
+            static constexpr MemberExtractor    memberExtractor;
+            return memberExtractor;
+        }
+};
+
 /* ------------------------------- Traits<std::unordered_multimap<Key, Value>> ------------------------------- */
 template<typename Key,typename T, typename Hash, typename KeyEqual, typename Allocator>
 class MemberInserter<std::unordered_multimap<Key, T, Hash, KeyEqual, Allocator>>
@@ -664,16 +763,18 @@ class Traits<std::unordered_multimap<std::string, Value>>
         {
             public:
                 constexpr MemberExtractor(){}
-                void operator()(PrinterInterface& printer, std::unordered_multimap<std::string, Value> const& object) const
+                template<typename Printer>
+                void operator()(Printer& printer, std::unordered_multimap<std::string, Value> const& object) const
                 {
-                    PutValueType<Value>     valuePutter(printer);
+                    PutValueType<Value, Traits<Value>::type, Printer>     valuePutter(printer);
                     for (auto const& loop: object)
                     {
                         printer.addKey(loop.first);
                         valuePutter.putValue(loop.second);
                     }
                 }
-                void operator()(ParserInterface& parser, std::string const& key, std::unordered_multimap<std::string, Value>& object) const
+                template<typename Parser>
+                void operator()(Parser& parser, std::string const& key, std::unordered_multimap<std::string, Value>& object) const
                 {
                     Value                   data{};
                     GetValueType<Value>     valueGetter(parser, data);
@@ -699,7 +800,8 @@ class MemberInserter<std::multimap<Key, T, Compare, Allocator>>
         {}
         void add(std::size_t const&, std::pair<Key, T>&& value)
         {
-            container.insert(std::forward<std::pair<Key, T>>(value));
+            // End hint: see MemberInserter<std::set<Key>>
+            container.insert(std::end(container), std::forward<std::pair<Key, T>>(value));
         }
 };
 
@@ -726,20 +828,23 @@ class Traits<std::multimap<std::string, Value>>
         {
             public:
                 constexpr MemberExtractor(){}
-                void operator()(PrinterInterface& printer, std::multimap<std::string, Value> const& object) const
+                template<typename Printer>
+                void operator()(Printer& printer, std::multimap<std::string, Value> const& object) const
                 {
-                    PutValueType<Value>     valuePutter(printer);
+                    PutValueType<Value, Traits<Value>::type, Printer>     valuePutter(printer);
                     for (auto const& loop: object)
                     {
                         printer.addKey(loop.first);
                         valuePutter.putValue(loop.second);
                     }
                 }
-                void operator()(ParserInterface& parser, std::string const& key, std::multimap<std::string, Value>& object) const
+                template<typename Parser>
+                void operator()(Parser& parser, std::string const& key, std::multimap<std::string, Value>& object) const
                 {
                     Value                   data{};
                     GetValueType<Value>     valueGetter(parser, data);
-                    object.insert(std::make_pair(std::move(key), std::move(data)));
+                    // End hint: see MemberInserter<std::set<Key>>
+                    object.insert(std::end(object), std::make_pair(std::move(key), std::move(data)));
                 }
         };
 
@@ -773,44 +878,46 @@ class ContainerTuppleExtractor
 {
         using C = std::tuple<Args...>;
 
-        template<std::size_t index, typename V>
-        void printTupleValue(PrinterInterface& printer, C const& object) const
+        template<std::size_t index, typename V, typename Printer>
+        void printTupleValue(Printer& printer, C const& object) const
         {
-            PutValueType<V>     valuePutter(printer);
+            PutValueType<V, Traits<V>::type, Printer>     valuePutter(printer);
             valuePutter.putValue(std::get<index>(object));
         }
-        template<std::size_t... index>
-        void printTupleValues(PrinterInterface& printer, C const& object, std::index_sequence<index...> const&) const
+        template<typename Printer, std::size_t... index>
+        void printTupleValues(Printer& printer, C const& object, std::index_sequence<index...> const&) const
         {
-            auto discard = {(printTupleValue<index, typename std::tuple_element_t<index, C>>(printer, object),1)...};
+            auto discard = {(printTupleValue<index, typename std::tuple_element_t<index, C>, Printer>(printer, object),1)...};
             (void)discard;
         }
-        template<std::size_t index, typename V>
-        void parseTupleValue(ParserInterface& parser, C& object) const
+        template<std::size_t index, typename V, typename Parser>
+        void parseTupleValue(Parser& parser, C& object) const
         {
             V&                  data(std::get<index>(object));
             GetValueType<V>     valueGetter(parser, data);
         }
-        template<std::size_t... index>
-        void parseTupleValues(ParserInterface& parser, std::size_t const& id, C& object,  std::index_sequence<index...> const&) const
+        template<typename Parser, std::size_t... index>
+        void parseTupleValues(Parser& parser, std::size_t const& id, C& object,  std::index_sequence<index...> const&) const
         {
-            using MemberDecoder = decltype(&ContainerTuppleExtractor::parseTupleValue<0, typename std::tuple_element_t<0, C>>);
-            static std::initializer_list<MemberDecoder> parseTuppleValue = {&ContainerTuppleExtractor::parseTupleValue<index, typename std::tuple_element_t<index, C>>...};
+            using MemberDecoder = decltype(&ContainerTuppleExtractor::parseTupleValue<0, typename std::tuple_element_t<0, C>, Parser>);
+            static std::initializer_list<MemberDecoder> parseTuppleValue = {&ContainerTuppleExtractor::parseTupleValue<index, typename std::tuple_element_t<index, C>, Parser>...};
             auto iteratorToFunction = parseTuppleValue.begin() + id;
             auto function = *iteratorToFunction;
             (this->*function)(parser, object);
         }
     public:
         constexpr ContainerTuppleExtractor() {}
-        constexpr std::size_t getHash(std::size_t start) const
+        constexpr THash getHash(THash start) const
         {
             return thash<int>(start);
         }
-        void operator()(PrinterInterface& printer, C const& object) const
+        template<typename Printer>
+        void operator()(Printer& printer, C const& object) const
         {
             printTupleValues(printer, object, std::make_index_sequence<sizeof...(Args)>());
         }
-        void operator()(ParserInterface& parser, std::size_t const& index, C& object) const
+        template<typename Parser>
+        void operator()(Parser& parser, std::size_t const& index, C& object) const
         {
             parseTupleValues(parser, index, object, std::make_index_sequence<sizeof...(Args)>());
         }
@@ -2,49 +2,199 @@
 #include "Serialize.h"
 
 using ThorsAnvil::Serialize::ParserInterface;
+using ThorsAnvil::Serialize::PrinterInterface;
+using ThorsAnvil::Serialize::InternedString;
+using ThorsAnvil::Serialize::RawNumber;
 
 HEADER_ONLY_INCLUDE
 void ParserInterface::ignoreValue()
 {
     if (config.parseStrictness != ParseType::Weak)
-    {   throw std::runtime_error("ThorsAnvil::Serialize::ParserInterface::ignoreValue: In Strict parser mode not allowed to ignore values.");
+    {
+        parseError(ErrorCode::UnknownKey, "ThorsAnvil::Serialize::ParserInterface::ignoreValue: In Strict parser mode not allowed to ignore values.");
+        return;
+    }
+    if (config.stats)
+    {
+        ++config.stats->keysIgnored;
     }
 
     ignoreTheValue();
 }
 
+HEADER_ONLY_INCLUDE
+void ParserInterface::parseError(ErrorCode code, char const* message)
+{
+    if (config.throwOnError)
+    {
+        if (byteLimit && byteLimit->limitExceeded())
+        {
+            throw std::runtime_error("ThorsAnvil::Serialize::ParserInterface::parseError: Exceeded ParserConfig::maxBytes");
+        }
+        throw std::runtime_error(message);
+    }
+    if (failed())
+    {
+        // Only the first error is kept.
+        // Errors after it are a result of the parser stopping.
+        return;
+    }
+    if (byteLimit && byteLimit->limitExceeded())
+    {
+        // The input was cut short by config.maxBytes.
+        code    = ErrorCode::LimitExceeded;
+    }
+    // Note: The stream may be in a failed state (e.g. end of file).
+    //       So the position is asked for from the buffer.
+    std::streamoff  position = input.rdbuf()->pubseekoff(0, std::ios_base::cur, std::ios_base::in);
+    error.code      = code;
+    error.offset    = position < 0 ? static_cast<std::size_t>(-1) : static_cast<std::size_t>(position);
+}
+
+HEADER_ONLY_INCLUDE
+void ParserInterface::parseError(ErrorCode code, char const* message, char const* detail)
+{
+    if (config.throwOnError && !(byteLimit && byteLimit->limitExceeded()))
+    {
+        throw std::runtime_error(std::string(message) + detail);
+    }
+    parseError(code, message);
+}
+
+HEADER_ONLY_INCLUDE
+void ParserInterface::limitInput()
+{
+    byteLimit = std::make_unique<LimitStreamBuf>(input.rdbuf(), config.maxBytes);
+    std::ios::iostate   state = input.rdstate();
+    input.rdbuf(byteLimit.get());
+    input.setstate(state);
+}
+
+HEADER_ONLY_INCLUDE
+void ParserInterface::restoreInput()
+{
+    // Note: rdbuf() resets the state of the stream.
+    std::ios::iostate   state = input.rdstate();
+    input.rdbuf(byteLimit->getSource());
+    input.setstate(state);
+}
+
+HEADER_ONLY_INCLUDE
+void ParserInterface::getValue(std::string_view&)
+{
+    throw std::runtime_error("ThorsAnvil::Serialize::ParserInterface::getValue: std::string_view is only supported by an in-situ parser");
+}
+
+HEADER_ONLY_INCLUDE
+void ParserInterface::getValue(InternedString& value)
+{
+    std::string text;
+    getValue(text);
+    value = intern(text);
+}
+
+HEADER_ONLY_INCLUDE
+InternedString ParserInterface::intern(std::string_view value)
+{
+    if (config.stringPool == nullptr)
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::ParserInterface::intern: InternedString requires ParserConfig::stringPool");
+    }
+    return config.stringPool->intern(value);
+}
+
+HEADER_ONLY_INCLUDE
+void ParserInterface::getValue(RawNumber& value)
+{
+    if (isBinary())
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::ParserInterface::getValue: RawNumber is only supported by text formats");
+    }
+    ValueType type = getValueType();
+    if (type != ValueType::Unknown && type != ValueType::Integer && type != ValueType::Float)
+    {
+        parseError(ErrorCode::InvalidValue, "ThorsAnvil::Serialize::ParserInterface::getValue: RawNumber: Value is not a number");
+        return;
+    }
+    std::string text = getRawValue();
+    // The parser does not know the type: Check the text here (the constructor would throw).
+    if (type == ValueType::Unknown && !RawNumber::isValid(text))
+    {
+        parseError(ErrorCode::InvalidValue, "ThorsAnvil::Serialize::ParserInterface::getValue: RawNumber: Value is not a number");
+        return;
+    }
+    value = RawNumber(text);
+}
+
+HEADER_ONLY_INCLUDE
+void PrinterInterface::addValue(RawNumber const& value)
+{
+    if (isBinary())
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::PrinterInterface::addValue: RawNumber is only supported by text formats");
+    }
+    if (value.empty())
+    {
+        // A default constructed RawNumber has no value (printing the empty text would generate invalid output).
+        throw std::runtime_error("ThorsAnvil::Serialize::PrinterInterface::addValue: RawNumber: No value");
+    }
+    addRawValue(std::string(value.text()));
+}
+
 HEADER_ONLY_INCLUDE
 void ParserInterface::ignoreTheMap()
 {
+    // The MapStart was read by ignoreTheValue()/ignoreTheArray() (not getToken()).
+    if (!openContainer())
+    {
+        return;
+    }
     for (ParserToken token = getNextToken(); token != ParserToken::MapEnd; token = getNextToken())
     {
         ignoreDataValue();
         if (token != ParserToken::Key)
-        {   throw std::runtime_error("ThorsAnvil::Serialize::ParserInterface::ignoreTheMap: Invalid token found. (Expecting Key)");
+        {
+            parseError(ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::ParserInterface::ignoreTheMap: Invalid token found. (Expecting Key)");
+            return;
         }
         ignoreTheValue();
+        if (failed())
+        {
+            return;
+        }
     }
+    --depth;
 }
 
 HEADER_ONLY_INCLUDE
 void ParserInterface::ignoreTheArray()
 {
+    if (!openContainer())
+    {
+        return;
+    }
     ParserToken token = getNextToken();
     while (token != ParserToken::ArrayEnd)
     {
         switch (token)
         {
-            case ParserToken::Error:     throw std::runtime_error("ThorsAnvil::Serialize::ParserInterface::ignoreTheArray: Invalid token found: Error");
-            case ParserToken::Key:       throw std::runtime_error("ThorsAnvil::Serialize::ParserInterface::ignoreTheArray: Invalid token found: Key");
-            case ParserToken::MapEnd:    throw std::runtime_error("ThorsAnvil::Serialize::ParserInterface::ignoreTheArray: Invalid token found: MapEnd");
+            case ParserToken::Error:     parseError(ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::ParserInterface::ignoreTheArray: Invalid token found: Error");   return;
+            case ParserToken::Key:       parseError(ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::ParserInterface::ignoreTheArray: Invalid token found: Key");     return;
+            case ParserToken::MapEnd:    parseError(ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::ParserInterface::ignoreTheArray: Invalid token found: MapEnd");  return;
             case ParserToken::Value:     ignoreDataValue(); break;
             case ParserToken::MapStart:  ignoreTheMap();    break;
             case ParserToken::ArrayStart:ignoreTheArray();  break;
             default:
-                throw std::runtime_error("ThorsAnvil::Serialize::ParserInterface::ignoreTheArray: Invalid token found: Unknown");
+                parseError(ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::ParserInterface::ignoreTheArray: Invalid token found: Unknown");
+                return;
+        }
+        if (failed())
+        {
+            return;
         }
         token = getNextToken();
     }
+    --depth;
 }
 
 HEADER_ONLY_INCLUDE
@@ -53,15 +203,15 @@ void ParserInterface::ignoreTheValue()
     ParserToken token = getNextToken();
     switch (token)
     {
-        case ParserToken::Error:     throw std::runtime_error("ThorsAnvil::Serialize::ParserInterface::ignoreTheValue: Invalid token found: Error");
-        case ParserToken::Key:       throw std::runtime_error("ThorsAnvil::Serialize::ParserInterface::ignoreTheValue: Invalid token found: Key");
-        case ParserToken::MapEnd:    throw std::runtime_error("ThorsAnvil::Serialize::ParserInterface::ignoreTheValue: Invalid token found: MapEnd");
-        case ParserToken::ArrayEnd:  throw std::runtime_error("ThorsAnvil::Serialize::ParserInterface::ignoreTheValue: Invalid token found: ArrayEnd");
+        case ParserToken::Error:     parseError(ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::ParserInterface::ignoreTheValue: Invalid token found: Error");     break;
+        case ParserToken::Key:       parseError(ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::ParserInterface::ignoreTheValue: Invalid token found: Key");       break;
+        case ParserToken::MapEnd:    parseError(ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::ParserInterface::ignoreTheValue: Invalid token found: MapEnd");    break;
+        case ParserToken::ArrayEnd:  parseError(ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::ParserInterface::ignoreTheValue: Invalid token found: ArrayEnd");  break;
         case ParserToken::Value:     ignoreDataValue(); break;
         case ParserToken::MapStart:  ignoreTheMap();    break;
         case ParserToken::ArrayStart:ignoreTheArray();  break;
         default:
-            throw std::runtime_error("ThorsAnvil::Serialize::ParserInterface::ignoreTheValue: Invalid token found: Unknown");
+            parseError(ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::ParserInterface::ignoreTheValue: Invalid token found: Unknown");
     }
 }
 
@@ -173,5 +323,54 @@ template void ThorsAnvil::Serialize::Serializer::print<std::unique_ptr<SmartPtrT
 template void ThorsAnvil::Serialize::DeSerializer::parse<std::shared_ptr<SmartPtrTest::Object>>(std::shared_ptr<SmartPtrTest::Object>&);
 template void ThorsAnvil::Serialize::Serializer::print<std::shared_ptr<SmartPtrTest::Object>>(std::shared_ptr<SmartPtrTest::Object> const&);
 
+// Used by jsonExport()/jsonImport() (see Exporter.h/Importer.h).
+template void ThorsAnvil::Serialize::BasicSerializer<ThorsAnvil::Serialize::JsonPrinter>::print<BinaryParserTest::Base>(BinaryParserTest::Base const&);
+template void ThorsAnvil::Serialize::BasicSerializer<ThorsAnvil::Serialize::JsonPrinter>::print<BinaryParserTest::Derived>(BinaryParserTest::Derived const&);
+template void ThorsAnvil::Serialize::BasicSerializer<ThorsAnvil::Serialize::JsonPrinter>::print<int>(int const&);
+template void ThorsAnvil::Serialize::BasicSerializer<ThorsAnvil::Serialize::JsonPrinter>::print<std::array<int, 12ul>>(std::array<int, 12ul> const&);
+template void ThorsAnvil::Serialize::BasicSerializer<ThorsAnvil::Serialize::JsonPrinter>::print<std::pair<int, double>>(std::pair<int, double> const&);
+template void ThorsAnvil::Serialize::BasicSerializer<ThorsAnvil::Serialize::JsonPrinter>::print<std::deque<int>>(std::deque<int> const&);
+template void ThorsAnvil::Serialize::BasicSerializer<ThorsAnvil::Serialize::JsonPrinter>::print<std::set<int>>(std::set<int> const&);
+template void ThorsAnvil::Serialize::BasicSerializer<ThorsAnvil::Serialize::JsonPrinter>::print<std::multiset<int>>(std::multiset<int> const&);
+template void ThorsAnvil::Serialize::BasicSerializer<ThorsAnvil::Serialize::JsonPrinter>::print<std::map<int, double>>(std::map<int, double> const&);
+template void ThorsAnvil::Serialize::BasicSerializer<ThorsAnvil::Serialize::JsonPrinter>::print<std::multimap<int, double>>(std::multimap<int, double> const&);
+template void ThorsAnvil::Serialize::BasicSerializer<ThorsAnvil::Serialize::JsonPrinter>::print<std::map<std::string, double>>(std::map<std::string, double> const&);
+template void ThorsAnvil::Serialize::BasicSerializer<ThorsAnvil::Serialize::JsonPrinter>::print<std::multimap<std::string, double>>(std::multimap<std::string, double> const&);
+template void ThorsAnvil::Serialize::BasicSerializer<ThorsAnvil::Serialize::JsonPrinter>::print<std::tuple<int, double>>(std::tuple<int, double> const&);
+template void ThorsAnvil::Serialize::BasicSerializer<ThorsAnvil::Serialize::JsonPrinter>::print<std::unordered_set<int>>(std::unordered_set<int> const&);
+template void ThorsAnvil::Serialize::BasicSerializer<ThorsAnvil::Serialize::JsonPrinter>::print<std::unordered_map<std::string, double>>(std::unordered_map<std::string, double> const&);
+template void ThorsAnvil::Serialize::BasicSerializer<ThorsAnvil::Serialize::JsonPrinter>::print<std::unordered_map<int, double>>(std::unordered_map<int, double> const&);
+template void ThorsAnvil::Serialize::BasicSerializer<ThorsAnvil::Serialize::JsonPrinter>::print<std::unordered_multiset<int>>(std::unordered_multiset<int> const&);
+template void ThorsAnvil::Serialize::BasicSerializer<ThorsAnvil::Serialize::JsonPrinter>::print<std::unordered_multimap<std::string, double>>(std::unordered_multimap<std::string, double> const&);
+template void ThorsAnvil::Serialize::BasicSerializer<ThorsAnvil::Serialize::JsonPrinter>::print<std::unordered_multimap<int, double>>(std::unordered_multimap<int, double> const&);
+template void ThorsAnvil::Serialize::BasicSerializer<ThorsAnvil::Serialize::JsonPrinter>::print<std::initializer_list<int>>(std::initializer_list<int> const&);
+template void ThorsAnvil::Serialize::BasicSerializer<ThorsAnvil::Serialize::JsonPrinter>::print<IgnoreUneededData::Thing>(IgnoreUneededData::Thing const&);
+template void ThorsAnvil::Serialize::BasicSerializer<ThorsAnvil::Serialize::JsonPrinter>::print<ExceptionTest::ThrowablePrint>(ExceptionTest::ThrowablePrint const&);
+template void ThorsAnvil::Serialize::BasicSerializer<ThorsAnvil::Serialize::JsonPrinter>::print<std::string>(std::string const&);
+
+template void ThorsAnvil::Serialize::BasicDeSerializer<ThorsAnvil::Serialize::JsonParser>::parse<BinaryParserTest::Base>(BinaryParserTest::Base&);
+template void ThorsAnvil::Serialize::BasicDeSerializer<ThorsAnvil::Serialize::JsonParser>::parse<BinaryParserTest::Derived>(BinaryParserTest::Derived&);
+template void ThorsAnvil::Serialize::BasicDeSerializer<ThorsAnvil::Serialize::JsonParser>::parse<int>(int&);
+template void ThorsAnvil::Serialize::BasicDeSerializer<ThorsAnvil::Serialize::JsonParser>::parse<std::array<int, 0ul>>(std::array<int, 0ul>&);
+template void ThorsAnvil::Serialize::BasicDeSerializer<ThorsAnvil::Serialize::JsonParser>::parse<std::array<int, 12ul>>(std::array<int, 12ul>&);
+template void ThorsAnvil::Serialize::BasicDeSerializer<ThorsAnvil::Serialize::JsonParser>::parse<std::pair<int, double>>(std::pair<int, double>&);
+template void ThorsAnvil::Serialize::BasicDeSerializer<ThorsAnvil::Serialize::JsonParser>::parse<std::deque<int>>(std::deque<int>&);
+template void ThorsAnvil::Serialize::BasicDeSerializer<ThorsAnvil::Serialize::JsonParser>::parse<std::set<int>>(std::set<int>&);
+template void ThorsAnvil::Serialize::BasicDeSerializer<ThorsAnvil::Serialize::JsonParser>::parse<std::multiset<int>>(std::multiset<int>&);
+template void ThorsAnvil::Serialize::BasicDeSerializer<ThorsAnvil::Serialize::JsonParser>::parse<std::map<int, double>>(std::map<int, double>&);
+template void ThorsAnvil::Serialize::BasicDeSerializer<ThorsAnvil::Serialize::JsonParser>::parse<std::multimap<int, double>>(std::multimap<int, double>&);
+template void ThorsAnvil::Serialize::BasicDeSerializer<ThorsAnvil::Serialize::JsonParser>::parse<std::map<std::string, bool>>(std::map<std::string, bool>&);
+template void ThorsAnvil::Serialize::BasicDeSerializer<ThorsAnvil::Serialize::JsonParser>::parse<std::multimap<std::string, bool>>(std::multimap<std::string, bool>&);
+template void ThorsAnvil::Serialize::BasicDeSerializer<ThorsAnvil::Serialize::JsonParser>::parse<std::tuple<int, double>>(std::tuple<int, double>&);
+template void ThorsAnvil::Serialize::BasicDeSerializer<ThorsAnvil::Serialize::JsonParser>::parse<std::unordered_set<int>>(std::unordered_set<int>&);
+template void ThorsAnvil::Serialize::BasicDeSerializer<ThorsAnvil::Serialize::JsonParser>::parse<std::unordered_map<std::string, bool>>(std::unordered_map<std::string, bool>&);
+template void ThorsAnvil::Serialize::BasicDeSerializer<ThorsAnvil::Serialize::JsonParser>::parse<std::unordered_map<int, double>>(std::unordered_map<int, double>&);
+template void ThorsAnvil::Serialize::BasicDeSerializer<ThorsAnvil::Serialize::JsonParser>::parse<std::unordered_multiset<int>>(std::unordered_multiset<int>&);
+template void ThorsAnvil::Serialize::BasicDeSerializer<ThorsAnvil::Serialize::JsonParser>::parse<std::unordered_multimap<std::string, bool>>(std::unordered_multimap<std::string, bool>&);
+template void ThorsAnvil::Serialize::BasicDeSerializer<ThorsAnvil::Serialize::JsonParser>::parse<std::unordered_multimap<int, double>>(std::unordered_multimap<int, double>&);
+template void ThorsAnvil::Serialize::BasicDeSerializer<ThorsAnvil::Serialize::JsonParser>::parse<IgnoreUneededData::ThingVersion>(IgnoreUneededData::ThingVersion&);
+template void ThorsAnvil::Serialize::BasicDeSerializer<ThorsAnvil::Serialize::JsonParser>::parse<ExceptionTest::ThrowablePrint>(ExceptionTest::ThrowablePrint&);
+template void ThorsAnvil::Serialize::BasicDeSerializer<ThorsAnvil::Serialize::JsonParser>::parse<std::string>(std::string&);
+
 #endif
 #endif
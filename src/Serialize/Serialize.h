@@ -29,11 +29,31 @@
  *                                                                          these into updates on the object.
  *      SerializeMember                     DeSerializeMember               Generated (at compile time) from the Traits<T> information
  *                                                                          for each member that needs to be printed/parsed
+ *
+ * Static dispatch:
+ *      BasicSerializer<Printer> and BasicDeSerializer<Parser> (and the blocks/members they
+ *      generate) are templated on the type of the Printer/Parser. Serializer/DeSerializer are
+ *      the versions that use PrinterInterface/ParserInterface (every call is virtual).
+ *      The Exporter/Importer use the concrete Printer/Parser of the format so calls on the
+ *      object can be resolved at compile time and inlined into the generated code.
+ *
+ *      Polymorphic objects (ThorsAnvil_PolyMorphicSerializer) and the Actions of hand written
+ *      Traits use PrinterInterface/ParserInterface. So these switch back to virtual calls.
  */
 
 #include "Traits.h"
+#include "SerializeStats.h"
+#include "StringPool.h"
+#include "RawNumber.h"
+#include "LimitStreamBuf.h"
 #include <iostream>
 #include <utility>
+#include <type_traits>
+#include <string_view>
+#include <map>
+#include <vector>
+#include <memory>
+#include <typeindex>
 
 namespace ThorsAnvil
 {
@@ -45,6 +65,20 @@ class ParserInterface
     public:
         enum class ParseType   {Weak, Strict, Exact};
         enum class ParserToken {Error, DocStart, DocEnd, MapStart, MapEnd, ArrayStart, ArrayEnd, Key, Value};
+        enum class ValueType   {Unknown, Null, Bool, Integer, Float, String};
+        enum class ErrorCode   {None, InvalidCharacter, InvalidString, InvalidValue, UnexpectedToken, UnknownKey, MissingMember, LimitExceeded, Exception};
+        static constexpr std::size_t noLimit = static_cast<std::size_t>(-1);
+        struct ParseResult
+        {
+            ErrorCode       code    = ErrorCode::None;
+            std::size_t     offset  = 0;                // Byte offset in the input (-1 if the stream can not report it).
+            explicit operator bool() const {return code == ErrorCode::None;}
+        };
+        struct SharedObject
+        {
+            std::shared_ptr<void>   object;             // null until the object has been allocated.
+            std::type_index         type;               // Element type of the std::shared_ptr it was read into.
+        };
         struct ParserConfig
         {
             ParserConfig(ParseType parseStrictness = ParseType::Weak, std::string const& polymorphicMarker = "__type")
@@ -57,18 +91,42 @@ class ParserInterface
             {}
             ParseType       parseStrictness;
             std::string     polymorphicMarker;
+            SerializeStats* stats   = nullptr;  // Optional: See SerializeStats.h
+            bool            preserveSharedPtr = false;  // Optional: See "Shared Pointers" below.
+            bool            validateUtf8      = false;  // Optional: Json/Yaml check strings and keys are valid UTF-8 (see Utf8Validator.h).
+            StringPool*     stringPool        = nullptr;// Optional: Pool used by InternedString (see StringPool.h).
+            bool            throwOnError      = true;   // Optional: false: Errors are recorded not thrown (see "Error Codes" below).
+            std::size_t     maxDepth          = noLimit;// Optional: Limits for untrusted input (see "Limits" below).
+            std::size_t     maxStringLength   = noLimit;
+            std::size_t     maxNumberLength   = noLimit;
+            std::size_t     maxElements       = noLimit;
+            std::size_t     maxBytes          = noLimit;
         };
 
         std::istream&   input;
         ParserToken     pushBack;
         ParserConfig    config;
+        std::vector<SharedObject>           sharedPtrObjects;   // Objects read by id (see "Shared Pointers").
+        ParseResult     error;                                  // First error found (see "Error Codes").
 
         ParserInterface(std::istream& input, ParserConfig  config = ParserConfig{})
             : input(input)
             , pushBack(ParserToken::Error)
             , config(config)
-        {}
-        virtual ~ParserInterface() {}
+            , depth(0)
+        {
+            if (this->config.maxBytes != noLimit)
+            {
+                limitInput();
+            }
+        }
+        virtual ~ParserInterface()
+        {
+            if (byteLimit)
+            {
+                restoreInput();
+            }
+        }
                 ParserToken     getToken();
                 void            pushBackToken(ParserToken token);
         virtual ParserToken     getNextToken()          = 0;
@@ -93,14 +151,51 @@ class ParserInterface
         virtual void    getValue(bool&)                  = 0;
 
         virtual void    getValue(std::string&)           = 0;
+        // Only supported by parsers that own their input (see JsonInSituParser).
+        virtual void    getValue(std::string_view&);
+        // Reads a string and interns it in config.stringPool (see StringPool.h).
+                void    getValue(InternedString& value);
+                InternedString intern(std::string_view value);
+        // Keeps the text of a number (text formats only, see RawNumber.h).
+                void    getValue(RawNumber& value);
 
         virtual bool    isValueNull()                    = 0;
 
         virtual std::string getRawValue()                = 0;
 
+        // Binary formats override this to return true.
+        // Used by types that have a more compact representation in a binary format (see ThorsAnvil_MakeEnumFlag).
+        virtual bool    isBinary() const                 {return false;}
+
+        // The type of the current Value token if the parser knows it without converting the value.
+        // Used by the SchemaValidator (see Validator.h) to check a value without reading it.
+        virtual ValueType getValueType() const           {return ValueType::Unknown;}
+
         void    ignoreValue();
+
+        // Throws std::runtime_error(message).
+        // Unless config.throwOnError is false: then the first error is recorded and getToken() returns Error from then on.
+        void    parseError(ErrorCode code, char const* message);
+        // As above: detail (e.g. a member name) is only appended to the message when it is thrown.
+        void    parseError(ErrorCode code, char const* message, char const* detail);
+        bool    failed() const                           {return error.code != ErrorCode::None;}
+        // Checks the size of a string before it is read (config.maxStringLength).
+        // A size declared by the input larger than the bytes left (config.maxBytes)
+        // is also rejected here, so a buffer is never sized for bytes that can not arrive.
+        // alreadyRead: The part of the same string that has been read (e.g. previous chunks).
+        // Returns false (after parseError()) if it is too long.
+        bool    checkStringLength(std::size_t size, std::size_t alreadyRead = 0);
+    protected:
+        // Formats that know the size of a value (e.g. Bson) can override
+        // this to skip it without generating the tokens inside it.
+        virtual void    ignoreTheValue();
     private:
-        void    ignoreTheValue();
+        std::size_t                     depth;          // Maps/Arrays currently open (config.maxDepth).
+        std::unique_ptr<LimitStreamBuf> byteLimit;      // Replaces the buffer of input (config.maxBytes).
+
+        bool    openContainer();
+        void    limitInput();
+        void    restoreInput();
         void    ignoreTheMap();
         void    ignoreTheArray();
 
@@ -121,13 +216,24 @@ class PrinterInterface
             {}
             OutputType      characteristics;
             std::string     polymorphicMarker;
+            SerializeStats* stats   = nullptr;  // Optional: See SerializeStats.h
+            bool            preserveSharedPtr = false;  // Optional: See "Shared Pointers" below.
         };
         // Default:     What ever the implementation likes.
         // Stream:      Compressed for over the wire protocol.
         // Config:      Human readable (potentially config file like)
 
+        // The key of a member declared with ThorsAnvil_MakeTrait.
+        // Both the name and the quoted form ("<name>": ) are compile time constants.
+        struct MemberKey
+        {
+            char const*         name;
+            std::string_view    quoted;
+        };
+
         std::ostream&   output;
         PrinterConfig   config;
+        std::map<void const*, std::size_t>  sharedPtrIds;   // Objects already printed (see "Shared Pointers").
 
         PrinterInterface(std::ostream& output, PrinterConfig config = PrinterConfig{})
             : output(output)
@@ -142,6 +248,7 @@ class PrinterInterface
         virtual void closeArray()                       = 0;
 
         virtual void    addKey(std::string const& key)  = 0;
+        virtual void    addKey(MemberKey const& key)    {addKey(std::string(key.name));}
 
         virtual void    addValue(short int)             = 0;
         virtual void    addValue(int)                   = 0;
@@ -160,11 +267,27 @@ class PrinterInterface
         virtual void    addValue(bool)                  = 0;
 
         virtual void    addValue(std::string const&)    = 0;
+        virtual void    addValue(std::string_view value){addValue(std::string(value));}
+        // Writes the original text of the number (text formats only, see RawNumber.h).
+                void    addValue(RawNumber const& value);
 
         virtual void    addRawValue(std::string const&) = 0;
 
         virtual void    addNull()                       = 0;
 
+        // Binary formats override this to return true.
+        // Used by types that have a more compact representation in a binary format (see ThorsAnvil_MakeEnumFlag).
+        virtual bool    isBinary() const                {return false;}
+
+        // Used by the ParallelExporter (see ParallelExporter.h).
+        // A printer that can print a run of elements from the top level array
+        // independently of the rest of the array overrides these. Each run is
+        // then printed on its own thread and the results are concatenated.
+        // index: The position of the first element of the run in the array.
+        virtual bool    canPrintArrayChunk() const      {return false;}
+        virtual void    openArrayChunk(std::size_t)     {}
+        virtual void    closeArrayChunk()               {}
+
         void addValue(void*)        = delete;
         void addValue(void const*)  = delete;
 };
@@ -186,23 +309,31 @@ template<>  inline float                   scanValue<float>(char const* buffer,
 template<>  inline double                  scanValue<double>(char const* buffer, char** end)                  {return std::strtod(buffer, end);}
 template<>  inline long double             scanValue<long double>(char const* buffer, char** end)             {return std::strtold(buffer, end);}
 
-class Serializer;
-class DeSerializer;
+template<typename Printer = PrinterInterface>
+class BasicSerializer;
+template<typename Parser = ParserInterface>
+class BasicDeSerializer;
+
+using Serializer    = BasicSerializer<PrinterInterface>;
+using DeSerializer  = BasicDeSerializer<ParserInterface>;
 
 template<TraitType type, typename T, typename I>
 class ApplyActionToParent
 {
     public:
         // Default do nothing.
-        void printParentMembers(Serializer&, T const&)            {}
-        bool scanParentMember(DeSerializer&, I const&, T&)        {return false;}
+        template<typename Printer>
+        void printParentMembers(BasicSerializer<Printer>&, T const&)          {}
+        template<typename Parser>
+        bool scanParentMember(BasicDeSerializer<Parser>&, I const&, T&)       {return false;}
 };
 
 template<typename T, typename M>
 class DeSerializeMemberContainer
 {
     public:
-        DeSerializeMemberContainer(DeSerializer&, ParserInterface& parser, std::string const& key, T& object, std::pair<char const*, M T::*> const& memberInfo);
+        template<typename Parser>
+        DeSerializeMemberContainer(BasicDeSerializer<Parser>&, Parser& parser, std::string const& key, T& object, std::pair<char const*, M T::*> const& memberInfo);
         explicit operator bool() const {return used;}
     private:
         bool used = false;
@@ -212,19 +343,24 @@ template<typename T, typename M, TraitType Type>
 class DeSerializeMemberValue
 {
     public:
-        DeSerializeMemberValue(DeSerializer& parent, ParserInterface& parser, std::string const& key, T& object, std::pair<char const*, M T::*> const& memberInfo);
-        DeSerializeMemberValue(DeSerializer& parent, ParserInterface& parser, std::string const& key, T&, std::pair<char const*, M*> const& memberInfo);
+        template<typename Parser>
+        DeSerializeMemberValue(BasicDeSerializer<Parser>& parent, Parser& parser, std::string const& key, T& object, std::pair<char const*, M T::*> const& memberInfo);
+        template<typename Parser>
+        DeSerializeMemberValue(BasicDeSerializer<Parser>& parent, Parser& parser, std::string const& key, T&, std::pair<char const*, M*> const& memberInfo);
         explicit operator bool() const {return used;}
     private:
         bool used = false;
-        void init(DeSerializer& parent, ParserInterface& parser, std::string const& key, char const* name, M& object);
+        template<typename Parser>
+        void init(BasicDeSerializer<Parser>& parent, Parser& parser, std::string const& key, char const* name, M& object);
 };
 
-class DeSerializer
+template<typename Parser>
+class BasicDeSerializer
 {
     using ParserToken = ParserInterface::ParserToken;
-    ParserInterface&    parser;
+    Parser&             parser;
     bool                root;
+    std::streampos      start;
 
     template<typename T, typename Members, std::size_t... Seq>
     bool scanEachMember(std::string const& key, T& object, Members const& member, std::index_sequence<Seq...> const&);
@@ -235,8 +371,8 @@ class DeSerializer
     template<typename T, typename I, typename Action>
     bool scanMembers(I const& key, T& object, Action action);
     public:
-        DeSerializer(ParserInterface& parser, bool root = true);
-        ~DeSerializer() noexcept(false);
+        BasicDeSerializer(Parser& parser, bool root = true);
+        ~BasicDeSerializer() noexcept(false);
 
         template<typename T>
         void parse(T& object);
@@ -249,23 +385,29 @@ template<typename T, typename M>
 class SerializeMemberContainer
 {
     public:
-        SerializeMemberContainer(Serializer&, PrinterInterface& printer, T const& object, std::pair<char const*, M T::*> const& memberInfo);
+        template<typename Printer>
+        SerializeMemberContainer(BasicSerializer<Printer>&, Printer& printer, T const& object, std::pair<char const*, M T::*> const& memberInfo);
 };
 
 template<typename T, typename M, TraitType Type>
 class SerializeMemberValue
 {
     public:
-        SerializeMemberValue(Serializer& parent, PrinterInterface& printer, T const& object, std::pair<char const*, M T::*> const& memberInfo);
-        SerializeMemberValue(Serializer& parent, PrinterInterface& printer, T const&, std::pair<char const*, M*> const& memberInfo);
+        template<typename Printer>
+        SerializeMemberValue(BasicSerializer<Printer>& parent, Printer& printer, T const& object, std::pair<char const*, M T::*> const& memberInfo);
+        template<typename Printer>
+        SerializeMemberValue(BasicSerializer<Printer>& parent, Printer& printer, T const&, std::pair<char const*, M*> const& memberInfo);
     private:
-        void init(Serializer& parent, PrinterInterface& printer, char const* member, M const& object);
+        template<typename Printer>
+        void init(BasicSerializer<Printer>& parent, Printer& printer, char const* member, M const& object);
 };
 
-class Serializer
+template<typename Printer>
+class BasicSerializer
 {
-    PrinterInterface& printer;
+    Printer&          printer;
     bool              root;
+    std::streampos    start;
 
     template<typename T, typename Members, std::size_t... Seq>
     void printEachMember(T const& object, Members const& member, std::index_sequence<Seq...> const&);
@@ -277,8 +419,8 @@ class Serializer
     void printMembers(T const& object, Action action);
 
     public:
-        Serializer(PrinterInterface& printer, bool root = true);
-        ~Serializer();
+        BasicSerializer(Printer& printer, bool root = true);
+        ~BasicSerializer();
 
         template<typename T>
         void print(T const& object);
@@ -286,6 +428,72 @@ class Serializer
         template<typename T>
         void printObjectMembers(T const& object);
 };
+/* ------------ Shared Pointers ------------------------- */
+/*
+ * By default each std::shared_ptr is printed in full. So an object that is shared
+ * is printed several times and de-serialized into separate objects.
+ *
+ * When PrinterConfig::preserveSharedPtr is set each object is printed once:
+ *      First time:     {"__id": <id>, "__value": <object>}
+ *      After that:     {"__ref": <id>}
+ * When ParserConfig::preserveSharedPtr is set the references are resolved
+ * back to the same object (so ownership is shared again).
+ *
+ * Ids are allocated in order (an object is given its id before its value is printed).
+ * The parser registers each object before its value is read, so a reference to an object
+ * that contains it (a cycle) is resolved (except for polymorphic objects, which are only
+ * registered once their value has been read). A reference through a different pointer type,
+ * or an id that is out of order, is an error.
+ *
+ * Note: The object must be referenced through the same pointer type each time.
+ *       Not supported by the positional binary format (BinaryParser<T>).
+ */
+static constexpr std::string_view   sharedPtrIdKey      = "__id";
+static constexpr std::string_view   sharedPtrValueKey   = "__value";
+static constexpr std::string_view   sharedPtrRefKey     = "__ref";
+
+template<typename T>
+struct IsSharedPtr: std::false_type {};
+template<typename T>
+struct IsSharedPtr<std::shared_ptr<T>>: std::true_type {};
+
+/* ------------ Error Codes ------------------------- */
+/*
+ * By default a parse error throws std::runtime_error (the message describes the problem).
+ *
+ * When ParserConfig::throwOnError is false the parser records the first error
+ * (ParserInterface::error: an ErrorCode and the byte offset it was found at) and
+ * getToken() returns ParserToken::Error from then on. The DeSerializer stops
+ * at the first Error token. So a bad document does not throw (or build a message).
+ *      tryImport<Format>(stream, object)   Returns the ParseResult.
+ *      stream >> Importer                  Sets the failbit.
+ *
+ * Supported by the JsonParser, the DeSerializer and the DeSerializePlan.
+ * The other parsers still throw (tryImport() reports these as ErrorCode::Exception).
+ * Errors in the use of the library (e.g. InternedString without a StringPool) always throw.
+ */
+
+/* ------------ Limits ------------------------- */
+/*
+ * By default there is no limit on the size of a document.
+ * For untrusted input ParserConfig can limit:
+ *      maxDepth:           The nesting of Maps/Arrays.
+ *                          Counted as the tokens are read (so it includes values that are ignored).
+ *      maxStringLength:    The length of a string or key (before escapes are decoded).
+ *                          Json stops reading the string at the limit. Binary formats check the
+ *                          size before the string is allocated.
+ *      maxNumberLength:    The number of digits in a Json number.
+ *      maxElements:        The number of elements in an array (or members of a map) being de-serialized.
+ *      maxBytes:           The number of bytes read from the stream.
+ *                          While the parser exists the stream reads through a LimitStreamBuf.
+ *                          This buffer reads one byte at a time, so only set it when it is needed.
+ *                          Binary formats reject a string whose declared size is larger than
+ *                          the bytes left before the string is allocated.
+ *
+ * Exceeding a limit is a parse error with ErrorCode::LimitExceeded.
+ * Note: A format that reports its own errors (e.g. end of input) may report that error for maxBytes.
+ */
+
 /* ------------ BaseTypeGetter Gets base type of pointer ------------------------- */
 template<typename P>
 struct BaseTypeGetter
@@ -294,6 +502,16 @@ struct BaseTypeGetter
     using type = typename std::remove_pointer<P>::type;
 };
 
+/* ------------ HasCustomChars ------------------------- */
+// True for Serialize types declared with ThorsAnvil_MakeTraitCustomChars()
+template<typename T, typename = void>
+struct HasCustomChars: std::false_type {};
+template<typename T>
+struct HasCustomChars<T, std::void_t<decltype(&Traits<T>::toChars), decltype(&Traits<T>::fromChars)>>: std::true_type {};
+
+// Largest text a ThorsAnvil_MakeTraitCustomChars() type can generate.
+static constexpr std::size_t customCharsMaxSize = 1024 * 1024;
+
 /* ------------ MetaTraits for Serialization/DeSerialization ------------------------- */
 
 template<typename T, typename M, TraitType Type>
@@ -330,6 +548,12 @@ struct TraitsInfo<T, M, TraitType::Enum>
     using SerializeMember       = SerializeMemberValue<T, M, TraitType::Enum>;
 };
 template<typename T, typename M>
+struct TraitsInfo<T, M, TraitType::EnumFlag>
+{
+    using DeSerializeMember     = DeSerializeMemberValue<T, M, TraitType::EnumFlag>;
+    using SerializeMember       = SerializeMemberValue<T, M, TraitType::EnumFlag>;
+};
+template<typename T, typename M>
 struct TraitsInfo<T, M, TraitType::Pointer>
 {
     using DeSerializeMember     = DeSerializeMemberValue<T, M, TraitType::Pointer>;
@@ -343,10 +567,19 @@ struct TraitsInfo<T, M, TraitType::Serialize>
 };
 
 /* ------------ ParserInterface ------------------------- */
+static_assert(
+    std::tuple_size<decltype(SerializeStats::tokens)>::value == static_cast<int>(ParserInterface::ParserToken::Value) + 1,
+    "SerializeStats::tokens must have one entry for each ParserToken"
+);
 inline ParserInterface::ParserToken ParserInterface::getToken()
 {
     ParserToken result  = ParserToken::Error;
 
+    if (failed())
+    {
+        pushBack = ParserToken::Error;
+        return result;
+    }
     if (pushBack != ParserToken::Error)
     {
         std::swap(pushBack, result);
@@ -354,9 +587,52 @@ inline ParserInterface::ParserToken ParserInterface::getToken()
     else
     {
         result = this->getNextToken();
+        if (config.stats)
+        {
+            ++config.stats->tokens[static_cast<int>(result)];
+        }
+        switch (result)
+        {
+            case ParserToken::MapStart:
+            case ParserToken::ArrayStart:
+                if (!openContainer())
+                {
+                    result = ParserToken::Error;
+                }
+                break;
+            case ParserToken::MapEnd:
+            case ParserToken::ArrayEnd:
+                --depth;
+                break;
+            default:
+                break;
+        }
     }
     return result;
 }
+inline bool ParserInterface::openContainer()
+{
+    if (++depth > config.maxDepth)
+    {
+        parseError(ErrorCode::LimitExceeded, "ThorsAnvil::Serialize::ParserInterface::openContainer: Exceeded ParserConfig::maxDepth");
+        return false;
+    }
+    return true;
+}
+inline bool ParserInterface::checkStringLength(std::size_t size, std::size_t alreadyRead)
+{
+    if (alreadyRead > config.maxStringLength || size > config.maxStringLength - alreadyRead)
+    {
+        parseError(ErrorCode::LimitExceeded, "ThorsAnvil::Serialize::ParserInterface::checkStringLength: Exceeded ParserConfig::maxStringLength");
+        return false;
+    }
+    if (byteLimit && size > byteLimit->getRemaining())
+    {
+        parseError(ErrorCode::LimitExceeded, "ThorsAnvil::Serialize::ParserInterface::checkStringLength: Exceeded ParserConfig::maxBytes");
+        return false;
+    }
+    return true;
+}
 inline void ParserInterface::pushBackToken(ParserToken token)
 {
     if (pushBack != ParserToken::Error)
@@ -367,12 +643,18 @@ inline void ParserInterface::pushBackToken(ParserToken token)
 }
 /* ------------ DeSerializer ------------------------- */
 
-inline DeSerializer::DeSerializer(ParserInterface& parser, bool root)
+template<typename Parser>
+inline BasicDeSerializer<Parser>::BasicDeSerializer(Parser& parser, bool root)
     : parser(parser)
     , root(root)
+    , start(-1)
 {
     if (root)
     {
+        if (parser.config.stats)
+        {
+            start = parser.input.tellg();
+        }
         // Note:
         //  Note: all "root" elements are going to have a DocStart/DocEnd pair
         //  Just the outer set. So that is something that we will need to deal with
@@ -380,36 +662,60 @@ inline DeSerializer::DeSerializer(ParserInterface& parser, bool root)
         //  Note: We also need to take care of arrays at the top level
         //  We will get that in the next version
         if (parser.getToken() != ParserToken::DocStart)
-        {   throw std::runtime_error("ThorsAnvil::Serialize::DeSerializer::DeSerializer: Invalid Doc Start");
+        {   parser.parseError(ParserInterface::ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::DeSerializer::DeSerializer: Invalid Doc Start");
         }
     }
 }
-inline DeSerializer::~DeSerializer() noexcept(false)
+template<typename Parser>
+inline BasicDeSerializer<Parser>::~BasicDeSerializer() noexcept(false)
 {
     if (root)
     {
         if (parser.getToken() != ParserToken::DocEnd)
-        {   throw std::runtime_error("ThorsAnvil::Serialize::DeSerializer::~DeSerializer: Expected Doc End");
+        {   parser.parseError(ParserInterface::ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::DeSerializer::~DeSerializer: Expected Doc End");
+        }
+        if (parser.config.stats && start != std::streampos(-1))
+        {
+            std::streampos end = parser.input.tellg();
+            if (end != std::streampos(-1))
+            {
+                parser.config.stats->bytesRead += end - start;
+            }
         }
     }
 }
 
 /* ------------ Serializer ------------------------- */
 
-inline Serializer::Serializer(PrinterInterface& printer, bool root)
+template<typename Printer>
+inline BasicSerializer<Printer>::BasicSerializer(Printer& printer, bool root)
     : printer(printer)
     , root(root)
+    , start(-1)
 {
     if (root)
     {
+        if (printer.config.stats)
+        {
+            start = printer.output.tellp();
+        }
         printer.openDoc();
     }
 }
-inline Serializer::~Serializer()
+template<typename Printer>
+inline BasicSerializer<Printer>::~BasicSerializer()
 {
     if (root)
     {
         printer.closeDoc();
+        if (printer.config.stats && start != std::streampos(-1))
+        {
+            std::streampos end = printer.output.tellp();
+            if (end != std::streampos(-1))
+            {
+                printer.config.stats->bytesWritten += end - start;
+            }
+        }
     }
 }
 
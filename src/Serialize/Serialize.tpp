@@ -19,11 +19,13 @@ template<typename P, typename T, typename I>
 class ApplyActionToAllParent
 {
     public:
-        void printParentMembers(Serializer& serializer, T const& object)
+        template<typename Printer>
+        void printParentMembers(BasicSerializer<Printer>& serializer, T const& object)
         {
             serializer.printObjectMembers(static_cast<P const&>(object));
         }
-        bool scanParentMember(DeSerializer& deSerializer, I const& key, T& object)
+        template<typename Parser>
+        bool scanParentMember(BasicDeSerializer<Parser>& deSerializer, I const& key, T& object)
         {
             return deSerializer.scanObjectMembers(key, static_cast<P&>(object));
         }
@@ -32,12 +34,14 @@ template<typename... Args, typename T, typename I>
 class ApplyActionToAllParent<Parents<Args...>, T, I>
 {
     public:
-        void printParentMembers(Serializer& serializer, T const& object)
+        template<typename Printer>
+        void printParentMembers(BasicSerializer<Printer>& serializer, T const& object)
         {
             bool ignore[] {true, (serializer.printObjectMembers(static_cast<Args const&>(object)), true)...};
             (void)ignore;
         }
-        bool scanParentMember(DeSerializer& deSerializer, I const& key, T& object)
+        template<typename Parser>
+        bool scanParentMember(BasicDeSerializer<Parser>& deSerializer, I const& key, T& object)
         {
             /*
              * See if the key is valid in one parent
@@ -54,11 +58,13 @@ class ApplyActionToParent<TraitType::Parent, T, I>
 {
     ApplyActionToAllParent<typename Traits<T>::Parent, T, I>  parentAction;
     public:
-        void printParentMembers(Serializer& serializer, T const& object)
+        template<typename Printer>
+        void printParentMembers(BasicSerializer<Printer>& serializer, T const& object)
         {
             parentAction.printParentMembers(serializer, object);
         }
-        bool scanParentMember(DeSerializer& deSerializer, I const& key, T& object)
+        template<typename Parser>
+        bool scanParentMember(BasicDeSerializer<Parser>& deSerializer, I const& key, T& object)
         {
             return parentAction.scanParentMember(deSerializer, key, object);
         }
@@ -77,87 +83,84 @@ struct HasParent<T, std::enable_if_t<(sizeof(typename Traits<T>::Parent) >= 0)>>
 
 template<typename T>
 typename std::enable_if<! HasParent<T>::value>::type
-heedAllParentMembers(std::map<std::string, bool> const& /*membersound*/)
+heedAllParentMembers(ParserInterface& /*parser*/, std::map<std::string, bool> const& /*membersound*/)
 {}
 
 template<typename T>
 typename std::enable_if<HasParent<T>::value>::type
-heedAllParentMembers(std::map<std::string, bool> const& membersFound)
+heedAllParentMembers(ParserInterface& parser, std::map<std::string, bool> const& membersFound)
 {
     HeedAllValues<typename Traits<T>::Parent>   heedParent;
-    heedParent(membersFound);
+    heedParent(parser, membersFound);
 }
 
 template<typename T>
 struct HeedAllValues
 {
     template<typename X>
-    int checkAMember(std::map<std::string, bool> const& membersFound, std::pair<char const*, X> const& member)
+    int checkAMember(ParserInterface& parser, std::map<std::string, bool> const& membersFound, std::pair<char const*, X> const& member)
     {
-        std::cerr << "CheckMember: " << member.first << "\n";
         if (membersFound.find(member.first) == std::end(membersFound))
         {
-            throw std::runtime_error(
-                Utility::buildErrorMessage("HeedAllValues::checkAMember: Did not fine: ",
-                                           member.first));
+            parser.parseError(ParserInterface::ErrorCode::MissingMember, "ThorsAnvil::Serialize::HeedAllValues::checkAMember: Did not find: ", member.first);
         }
         return 0;
     }
 
     template<typename Tuple, std::size_t... Index>
-    void checkEachMember(std::map<std::string, bool> const& membersFound, Tuple const& tuple, std::index_sequence<Index...> const&)
+    void checkEachMember(ParserInterface& parser, std::map<std::string, bool> const& membersFound, Tuple const& tuple, std::index_sequence<Index...> const&)
     {
-        std::initializer_list<int> ignore{1, checkAMember(membersFound, std::get<Index>(tuple))...};
+        std::initializer_list<int> ignore{1, checkAMember(parser, membersFound, std::get<Index>(tuple))...};
         (void)ignore;
-        heedAllParentMembers<T>(membersFound);
+        heedAllParentMembers<T>(parser, membersFound);
     }
 
     template<typename... Args>
-    void checkMemberFound(std::map<std::string, bool> const& membersFound, std::tuple<Args...> const& args)
+    void checkMemberFound(ParserInterface& parser, std::map<std::string, bool> const& membersFound, std::tuple<Args...> const& args)
     {
-        checkEachMember(membersFound, args, std::index_sequence_for<Args...>{});
+        checkEachMember(parser, membersFound, args, std::index_sequence_for<Args...>{});
     }
 
-    void operator()(std::map<std::string, bool> const& membersFound)
+    void operator()(ParserInterface& parser, std::map<std::string, bool> const& membersFound)
     {
-        checkMemberFound(membersFound, Traits<T>::getMembers());
+        checkMemberFound(parser, membersFound, Traits<T>::getMembers());
     }
 };
 template<typename... P>
 struct HeedAllValues<Parents<P...>>
 {
     template<typename ParentTupple, std::size_t... Index>
-    void checkEachParent(ParentTupple& parentsToHeed, std::map<std::string, bool> const& membersFound, std::index_sequence<Index...> const&)
+    void checkEachParent(ParentTupple& parentsToHeed, ParserInterface& parser, std::map<std::string, bool> const& membersFound, std::index_sequence<Index...> const&)
     {
-        bool ignore[] = {true, (std::get<Index>(parentsToHeed)(membersFound), true)...};
+        bool ignore[] = {true, (std::get<Index>(parentsToHeed)(parser, membersFound), true)...};
         (void)ignore;
     }
-    void operator()(std::map<std::string, bool> const& membersFound)
+    void operator()(ParserInterface& parser, std::map<std::string, bool> const& membersFound)
     {
         std::tuple<HeedAllValues<P>...>     parentsToHeed;
-        checkEachParent(parentsToHeed, membersFound, std::index_sequence_for<P...>{});
+        checkEachParent(parentsToHeed, parser, membersFound, std::index_sequence_for<P...>{});
     }
 };
 
 template<typename K, typename V>
 struct HeedAllValues<std::map<K, V>>
 {
-    void operator()(std::map<std::string, bool> const& /*members*/) {}
+    void operator()(ParserInterface& /*parser*/, std::map<std::string, bool> const& /*members*/) {}
 };
 template<typename K, typename V>
 struct HeedAllValues<std::multimap<K, V>>
 {
-    void operator()(std::map<std::string, bool> const& /*members*/) {}
+    void operator()(ParserInterface& /*parser*/, std::map<std::string, bool> const& /*members*/) {}
 };
 template<typename K, typename V>
 struct HeedAllValues<std::unordered_map<K, V>>
 {
-    void operator()(std::map<std::string, bool> const& /*members*/) {}
+    void operator()(ParserInterface& /*parser*/, std::map<std::string, bool> const& /*members*/) {}
 };
 template<typename K, typename V>
 struct HeedAllValues<std::unordered_multimap<K, V>>
 {
-    void operator()(std::map<std::string, bool> const& /*members*/) {}
+    void operator()(ParserInterface& /*parser*/, std::map<std::string, bool> const& /*members*/) {}
 };
 
 /* ------------ DeSerializationForBlock ------------------------- */
@@ -166,25 +169,27 @@ struct HeedAllValues<std::unordered_multimap<K, V>>
  * The default Block is a mapping of "Map" to "Object"
  * We expect an OpenMap followed by a set of Key/Value pairs followed by CloseMap
  */
-template<TraitType traitType, typename T>
+template<TraitType traitType, typename T, typename Parser = ParserInterface>
 class DeSerializationForBlock
 {
     static_assert(
         traitType != TraitType::Invalid,
         "Invalid Serialize TraitType. This usually means you have not define ThorsAnvil::Serialize::Traits<Your Type>"
     );
-    DeSerializer&    parent;
-    ParserInterface& parser;
-    std::string      key;
+    BasicDeSerializer<Parser>&  parent;
+    Parser&                     parser;
+    std::string                 key;
+    std::size_t                 count;
     public:
-        DeSerializationForBlock(DeSerializer& parent, ParserInterface& parser)
+        DeSerializationForBlock(BasicDeSerializer<Parser>& parent, Parser& parser)
             : parent(parent)
             , parser(parser)
+            , count(0)
         {
             ParserInterface::ParserToken    tokenType = parser.getToken();
 
             if (tokenType != ParserInterface::ParserToken::MapStart)
-            {   throw std::runtime_error("ThorsAnvil::Serialize::DeSerializationForBlock<Map>::DeSerializationForBlock: Invalid Object Start");
+            {   parser.parseError(ParserInterface::ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::DeSerializationForBlock<Map>::DeSerializationForBlock: Invalid Object Start");
             }
         }
 
@@ -202,10 +207,10 @@ class DeSerializationForBlock
                     memberFound[key] = true;
                 }
             }
-            if (parser.config.parseStrictness == ParserInterface::ParseType::Exact)
+            if (parser.config.parseStrictness == ParserInterface::ParseType::Exact && !parser.failed())
             {
                 HeedAllValues<T>    check;
-                check(memberFound);
+                check(parser, memberFound);
             }
         }
         bool hasMoreValue()
@@ -215,7 +220,12 @@ class DeSerializationForBlock
             if (result)
             {
                 if (tokenType != ParserInterface::ParserToken::Key)
-                {   throw std::runtime_error("ThorsAnvil::Serialize::DeSerializationForBlock<Map>::hasMoreValue: Expecting key token");
+                {   parser.parseError(ParserInterface::ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::DeSerializationForBlock<Map>::hasMoreValue: Expecting key token");
+                    return false;
+                }
+                if (++count > parser.config.maxElements)
+                {   parser.parseError(ParserInterface::ErrorCode::LimitExceeded, "ThorsAnvil::Serialize::DeSerializationForBlock<Map>::hasMoreValue: Exceeded ParserConfig::maxElements");
+                    return false;
                 }
                 key = parser.getKey();
             }
@@ -229,13 +239,13 @@ class DeSerializationForBlock
  * This is only used at the top level.
  * There is no open or close. Just a single value is expected.
  */
-template<typename T>
-class DeSerializationForBlock<TraitType::Value, T>
+template<typename T, typename Parser>
+class DeSerializationForBlock<TraitType::Value, T, Parser>
 {
-    DeSerializer&       parent;
-    ParserInterface&    parser;
+    BasicDeSerializer<Parser>&  parent;
+    Parser&                     parser;
     public:
-        DeSerializationForBlock(DeSerializer& parent, ParserInterface& parser)
+        DeSerializationForBlock(BasicDeSerializer<Parser>& parent, Parser& parser)
             : parent(parent)
             , parser(parser)
         {}
@@ -243,18 +253,19 @@ class DeSerializationForBlock<TraitType::Value, T>
         {
             ParserInterface::ParserToken    tokenType = parser.getToken();
             if (tokenType != ParserInterface::ParserToken::Value)
-            {   throw std::runtime_error("ThorsAnvil::Serialize::DeSerializationForBlock<Value>::DeSerializationForBlock: Invalid Object");
+            {   parser.parseError(ParserInterface::ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::DeSerializationForBlock<Value>::DeSerializationForBlock: Invalid Object");
+                return;
             }
             parser.getValue(object);
         }
 };
-template<typename T>
-class DeSerializationForBlock<TraitType::Serialize, T>
+template<typename T, typename Parser>
+class DeSerializationForBlock<TraitType::Serialize, T, Parser>
 {
-    DeSerializer&       parent;
-    ParserInterface&    parser;
+    BasicDeSerializer<Parser>&  parent;
+    Parser&                     parser;
     public:
-        DeSerializationForBlock(DeSerializer& parent, ParserInterface& parser)
+        DeSerializationForBlock(BasicDeSerializer<Parser>& parent, Parser& parser)
             : parent(parent)
             , parser(parser)
         {}
@@ -262,10 +273,20 @@ class DeSerializationForBlock<TraitType::Serialize, T>
         {
             ParserInterface::ParserToken    tokenType = parser.getToken();
             if (tokenType != ParserInterface::ParserToken::Value)
-            {   throw std::runtime_error("ThorsAnvil::Serialize::DeSerializationForBlock<Value>::DeSerializationForBlock: Invalid Object");
+            {   parser.parseError(ParserInterface::ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::DeSerializationForBlock<Value>::DeSerializationForBlock: Invalid Object");
+                return;
+            }
+            if constexpr (HasCustomChars<T>::value)
+            {
+                if (!Traits<T>::fromChars(parser.getRawValue(), object))
+                {   parser.parseError(ParserInterface::ErrorCode::InvalidValue, "ThorsAnvil::Serialize::DeSerializationForBlock<Serialize>::DeSerializationForBlock: Invalid Value");
+                }
+            }
+            else
+            {
+                std::stringstream valueStream(parser.getRawValue());
+                valueStream >> object;
             }
-            std::stringstream valueStream(parser.getRawValue());
-            valueStream >> object;
         }
 };
 /* ------------ tryParsePolyMorphicObject Serializer ------------------------- */
@@ -285,37 +306,50 @@ struct ConvertPointer<std::unique_ptr<T>>
         return std::unique_ptr<T>{result};
     }
 };
-template<class T>
-auto tryParsePolyMorphicObject(DeSerializer& parent, ParserInterface& parser, T& object, int) -> decltype(object->parsePolyMorphicObject(parent, parser), void())
+template<class T, typename Parser>
+auto tryParsePolyMorphicObject(BasicDeSerializer<Parser>&, Parser& parser, T& object, int) -> decltype(object->parsePolyMorphicObject(std::declval<DeSerializer&>(), parser), void())
 {
     ParserInterface::ParserToken    tokenType;
     tokenType = parser.getToken();
     if (tokenType != ParserInterface::ParserToken::MapStart)
-    {   throw std::runtime_error("ThorsAnvil::Serialize::tryParsePolyMorphicObject: Invalid Object. Expecting MapStart");
+    {   parser.parseError(ParserInterface::ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::tryParsePolyMorphicObject: Invalid Object. Expecting MapStart");
+        return;
     }
 
     tokenType = parser.getToken();
     if (tokenType != ParserInterface::ParserToken::Key)
-    {   throw std::runtime_error("ThorsAnvil::Serialize::tryParsePolyMorphicObject: Invalid Object. Expecting Key");
+    {   parser.parseError(ParserInterface::ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::tryParsePolyMorphicObject: Invalid Object. Expecting Key");
+        return;
     }
 
 
     std::string keyValue;
     if (parser.getKey() != parser.config.polymorphicMarker)
-    {   throw std::runtime_error(std::string("ThorsAnvil::Serialize::tryParsePolyMorphicObject: Invalid PolyMorphic Object. Expecting Key Name ") + parser.config.polymorphicMarker);
+    {
+        parser.parseError(ParserInterface::ErrorCode::UnknownKey, "ThorsAnvil::Serialize::tryParsePolyMorphicObject: Invalid PolyMorphic Object. Expecting Key Name ", parser.config.polymorphicMarker.c_str());
+        return;
     }
 
     tokenType = parser.getToken();
     if (tokenType != ParserInterface::ParserToken::Value)
-    {   throw std::runtime_error("ThorsAnvil::Serialize::tryParsePolyMorphicObject: Invalid Object. Expecting Value");
+    {   parser.parseError(ParserInterface::ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::tryParsePolyMorphicObject: Invalid Object. Expecting Value");
+        return;
     }
 
     std::string className;
     parser.getValue(className);
+    if (parser.failed())
+    {
+        return;
+    }
 
     using BaseType  = typename std::remove_pointer<T>::type;
     using AllocType = typename GetAllocationType<BaseType>::AllocType;
     object = ConvertPointer<BaseType>::assign(PolyMorphicRegistry::getNamedTypeConvertedTo<AllocType>(className));
+    if (parser.config.stats)
+    {
+        ++parser.config.stats->allocations;
+    }
 
     // This uses a virtual method in the object to
     // call parsePolyMorphicObject() the difference
@@ -325,33 +359,41 @@ auto tryParsePolyMorphicObject(DeSerializer& parent, ParserInterface& parser, T&
     //
     // To install this virtual method use the macro
     // ThorsAnvil_PolyMorphicSerializer  See Traits.h for details.
+    //
+    // Note: A virtual method can not be a template.
+    //       So the object is parsed with a DeSerializer (virtual calls on the parser).
     parser.pushBackToken(ParserInterface::ParserToken::MapStart);
-    object->parsePolyMorphicObject(parent, parser);
+    DeSerializer    polyMorphicParent(parser, false);
+    object->parsePolyMorphicObject(polyMorphicParent, parser);
 }
-template<class T>
-auto tryParsePolyMorphicObject(DeSerializer& parent, ParserInterface& parser, T& object, long) -> void
+template<class T, typename Parser>
+auto tryParsePolyMorphicObject(BasicDeSerializer<Parser>& parent, Parser& parser, T& object, long) -> void
 {
     using TraitPoint = Traits<T>;
     object = TraitPoint::alloc();
+    if (parser.config.stats)
+    {
+        ++parser.config.stats->allocations;
+    }
 
     parsePolyMorphicObject(parent, parser, *object);
 }
 /* ------------ PolyMorphic Serializer ------------------------- */
-template<typename T>
-void parsePolyMorphicObject(DeSerializer& parent, ParserInterface& parser, T& object)
+template<typename T, typename Parser>
+void parsePolyMorphicObject(BasicDeSerializer<Parser>& parent, Parser& parser, T& object)
 {
     using TraitBase = Traits<T>;
-    DeSerializationForBlock<TraitBase::type, T>   pointerDeSerializer(parent, parser);
+    DeSerializationForBlock<TraitBase::type, T, Parser>   pointerDeSerializer(parent, parser);
     pointerDeSerializer.scanObject(object);
 }
 
-template<typename T>
-class DeSerializationForBlock<TraitType::Pointer, T>
+template<typename T, typename Parser>
+class DeSerializationForBlock<TraitType::Pointer, T, Parser>
 {
-    DeSerializer&       parent;
-    ParserInterface&    parser;
+    BasicDeSerializer<Parser>&  parent;
+    Parser&                     parser;
     public:
-        DeSerializationForBlock(DeSerializer& parent, ParserInterface& parser)
+        DeSerializationForBlock(BasicDeSerializer<Parser>& parent, Parser& parser)
             : parent(parent)
             , parser(parser)
         {}
@@ -366,23 +408,123 @@ class DeSerializationForBlock<TraitType::Pointer, T>
                 return;
             }
 
+            if constexpr (IsSharedPtr<T>::value)
+            {
+                if (parser.config.preserveSharedPtr)
+                {
+                    scanSharedObject(tokenType, object);
+                    return;
+                }
+            }
+
             parser.pushBackToken(tokenType);
 
             tryParsePolyMorphicObject(parent, parser, object, 0);
         }
+    private:
+        std::string getSharedKey()
+        {
+            if (parser.getToken() != ParserInterface::ParserToken::Key)
+            {   parser.parseError(ParserInterface::ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::DeSerializationForBlock<Pointer>::getSharedKey: Expecting Key");
+                return "";
+            }
+            return parser.getKey();
+        }
+        std::size_t getSharedId()
+        {
+            if (parser.getToken() != ParserInterface::ParserToken::Value)
+            {   parser.parseError(ParserInterface::ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::DeSerializationForBlock<Pointer>::getSharedId: Expecting Id");
+                return -1;
+            }
+            std::size_t id = -1;
+            parser.getValue(id);
+            return id;
+        }
+        void scanSharedObject(ParserInterface::ParserToken tokenType, T& object)
+        {
+            using Element = typename T::element_type;
+            std::vector<ParserInterface::SharedObject>& objects = parser.sharedPtrObjects;
+
+            if (tokenType != ParserInterface::ParserToken::MapStart)
+            {   parser.parseError(ParserInterface::ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::DeSerializationForBlock<Pointer>::scanSharedObject: Expecting Shared Object");
+                return;
+            }
+            std::string     key = getSharedKey();
+            if (key == sharedPtrRefKey)
+            {
+                std::size_t id = getSharedId();
+                if (id >= objects.size() || objects[id].object == nullptr)
+                {   parser.parseError(ParserInterface::ErrorCode::InvalidValue, "ThorsAnvil::Serialize::DeSerializationForBlock<Pointer>::scanSharedObject: Unknown Shared Object Id");
+                    return;
+                }
+                if (objects[id].type != std::type_index(typeid(Element)))
+                {   parser.parseError(ParserInterface::ErrorCode::InvalidValue, "ThorsAnvil::Serialize::DeSerializationForBlock<Pointer>::scanSharedObject: Shared Object Id refers to a different type");
+                    return;
+                }
+                object = std::static_pointer_cast<Element>(objects[id].object);
+            }
+            else if (key == sharedPtrIdKey)
+            {
+                // Ids are allocated in order by the printer.
+                // So the next id is the only valid one (this also stops the input picking the size of objects).
+                std::size_t id = getSharedId();
+                if (id != objects.size())
+                {   parser.parseError(ParserInterface::ErrorCode::InvalidValue, "ThorsAnvil::Serialize::DeSerializationForBlock<Pointer>::scanSharedObject: Shared Object Id out of order");
+                    return;
+                }
+                if (getSharedKey() != sharedPtrValueKey)
+                {   parser.parseError(ParserInterface::ErrorCode::UnknownKey, "ThorsAnvil::Serialize::DeSerializationForBlock<Pointer>::scanSharedObject: Expecting Shared Object Value");
+                    return;
+                }
+                objects.push_back({nullptr, std::type_index(typeid(Element))});
+                scanSharedValue(object, id, 0);
+                if (parser.failed())
+                {
+                    return;
+                }
+            }
+            else
+            {   parser.parseError(ParserInterface::ErrorCode::UnknownKey, "ThorsAnvil::Serialize::DeSerializationForBlock<Pointer>::scanSharedObject: Invalid Shared Object Key");
+                return;
+            }
+            if (parser.getToken() != ParserInterface::ParserToken::MapEnd)
+            {   parser.parseError(ParserInterface::ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::DeSerializationForBlock<Pointer>::scanSharedObject: Expecting Shared Object End");
+            }
+        }
+        // Polymorphic: The object is allocated once its class name is read.
+        // So it is registered after its value is read.
+        template<typename P>
+        auto scanSharedValue(P& object, std::size_t id, int) -> decltype(object->parsePolyMorphicObject(std::declval<DeSerializer&>(), parser), void())
+        {
+            tryParsePolyMorphicObject(parent, parser, object, 0);
+            parser.sharedPtrObjects[id].object = object;
+        }
+        // Register the object before its value is read so references from inside it (cycles) are resolved.
+        // Note: Use an index (not a reference) into sharedPtrObjects as nested objects are added while reading.
+        template<typename P>
+        void scanSharedValue(P& object, std::size_t id, long)
+        {
+            object = Traits<P>::alloc();
+            if (parser.config.stats)
+            {
+                ++parser.config.stats->allocations;
+            }
+            parser.sharedPtrObjects[id].object = object;
+            parsePolyMorphicObject(parent, parser, *object);
+        }
 };
 /*
  * Specialization for Enum.
  * This is only used at the top level.
  * There is no open or close. Just a single value is expected.
  */
-template<typename T>
-class DeSerializationForBlock<TraitType::Enum, T>
+template<typename T, typename Parser>
+class DeSerializationForBlock<TraitType::Enum, T, Parser>
 {
-    DeSerializer&       parent;
-    ParserInterface&    parser;
+    BasicDeSerializer<Parser>&  parent;
+    Parser&                     parser;
     public:
-        DeSerializationForBlock(DeSerializer& parent, ParserInterface& parser)
+        DeSerializationForBlock(BasicDeSerializer<Parser>& parent, Parser& parser)
             : parent(parent)
             , parser(parser)
         {}
@@ -390,12 +532,75 @@ class DeSerializationForBlock<TraitType::Enum, T>
         {
             ParserInterface::ParserToken    tokenType = parser.getToken();
             if (tokenType != ParserInterface::ParserToken::Value)
-            {   throw std::runtime_error("ThorsAnvil::Serialize::DeSerializationForBlock<Enum>::DeSerializationForBlock: Invalid Object");
+            {   parser.parseError(ParserInterface::ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::DeSerializationForBlock<Enum>::DeSerializationForBlock: Invalid Object");
+                return;
             }
             std::string     objectValue;
             parser.getValue(objectValue);
 
-            object = Traits<T>::getValue(objectValue, "ThorsAnvil::Serialize::DeSerializationForBlock<Enum>::DeSerializationForBlock:");
+            std::size_t     index = Traits<T>::names.find(objectValue);
+            if (index == Traits<T>::names.size())
+            {   parser.parseError(ParserInterface::ErrorCode::InvalidValue, "ThorsAnvil::Serialize::DeSerializationForBlock<Enum>::DeSerializationForBlock: Invalid Enum Value");
+                return;
+            }
+            object = Traits<T>::names.value(index);
+        }
+};
+
+/*
+ * Specialization for EnumFlag.
+ * Binary formats hold a single integer.
+ * Otherwise it is an array of the names of the flags that are set.
+ */
+template<typename T, typename Parser>
+class DeSerializationForBlock<TraitType::EnumFlag, T, Parser>
+{
+    using Flag      = typename std::underlying_type<T>::type;
+    using Integer   = typename std::conditional<sizeof(Flag) <= sizeof(unsigned int), unsigned int, unsigned long long>::type;
+
+    BasicDeSerializer<Parser>&  parent;
+    Parser&                     parser;
+    public:
+        DeSerializationForBlock(BasicDeSerializer<Parser>& parent, Parser& parser)
+            : parent(parent)
+            , parser(parser)
+        {}
+        void scanObject(T& object)
+        {
+            ParserInterface::ParserToken    tokenType = parser.getToken();
+            if (parser.isBinary())
+            {
+                if (tokenType != ParserInterface::ParserToken::Value)
+                {   parser.parseError(ParserInterface::ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::DeSerializationForBlock<EnumFlag>::DeSerializationForBlock: Invalid Object");
+                    return;
+                }
+                Integer     value;
+                parser.getValue(value);
+                object = static_cast<T>(value);
+                return;
+            }
+            if (tokenType != ParserInterface::ParserToken::ArrayStart)
+            {   parser.parseError(ParserInterface::ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::DeSerializationForBlock<EnumFlag>::DeSerializationForBlock: Invalid Object Start");
+                return;
+            }
+
+            Flag            result = 0;
+            std::string     name;
+            while ((tokenType = parser.getToken()) != ParserInterface::ParserToken::ArrayEnd)
+            {
+                if (tokenType != ParserInterface::ParserToken::Value)
+                {   parser.parseError(ParserInterface::ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::DeSerializationForBlock<EnumFlag>::DeSerializationForBlock: Invalid Flag");
+                    return;
+                }
+                parser.getValue(name);
+                std::size_t index = Traits<T>::names.find(name);
+                if (index == Traits<T>::names.size())
+                {   parser.parseError(ParserInterface::ErrorCode::InvalidValue, "ThorsAnvil::Serialize::DeSerializationForBlock<EnumFlag>::DeSerializationForBlock: Invalid Enum Flag Value");
+                    return;
+                }
+                result |= static_cast<Flag>(Traits<T>::names.value(index));
+            }
+            object = static_cast<T>(result);
         }
 };
 
@@ -405,14 +610,14 @@ class DeSerializationForBlock<TraitType::Enum, T>
  * This made it different enough that combining this into a single
  * function was messy.
  */
-template<typename T>
-class DeSerializationForBlock<TraitType::Array, T>
+template<typename T, typename Parser>
+class DeSerializationForBlock<TraitType::Array, T, Parser>
 {
-    DeSerializer&    parent;
-    ParserInterface& parser;
-    std::size_t      index;
+    BasicDeSerializer<Parser>&  parent;
+    Parser&                     parser;
+    std::size_t                 index;
     public:
-        DeSerializationForBlock(DeSerializer& parent, ParserInterface& parser)
+        DeSerializationForBlock(BasicDeSerializer<Parser>& parent, Parser& parser)
             : parent(parent)
             , parser(parser)
             , index(-1)
@@ -420,7 +625,7 @@ class DeSerializationForBlock<TraitType::Array, T>
             ParserInterface::ParserToken    tokenType = parser.getToken();
 
             if (tokenType != ParserInterface::ParserToken::ArrayStart)
-            {   throw std::runtime_error("ThorsAnvil::Serialize::DeSerializationForBlock<Array>::DeSerializationForBlock: Invalid Object Start");
+            {   parser.parseError(ParserInterface::ErrorCode::UnexpectedToken, "ThorsAnvil::Serialize::DeSerializationForBlock<Array>::DeSerializationForBlock: Invalid Object Start");
             }
         }
 
@@ -434,11 +639,15 @@ class DeSerializationForBlock<TraitType::Array, T>
         bool hasMoreValue()
         {
             ParserInterface::ParserToken    tokenType = parser.getToken();
-            bool                            result    = tokenType != ParserInterface::ParserToken::ArrayEnd;
+            // Note: After an error (config.throwOnError false) the token is always Error.
+            bool                            result    = tokenType != ParserInterface::ParserToken::ArrayEnd && !parser.failed();
             if (result)
             {
+                if (++index >= parser.config.maxElements)
+                {   parser.parseError(ParserInterface::ErrorCode::LimitExceeded, "ThorsAnvil::Serialize::DeSerializationForBlock<Array>::hasMoreValue: Exceeded ParserConfig::maxElements");
+                    return false;
+                }
                 parser.pushBackToken(tokenType);
-                ++index;
             }
             return result;
         }
@@ -447,35 +656,39 @@ class DeSerializationForBlock<TraitType::Array, T>
 /* ------------ DeSerializeMember ------------------------- */
 
 template<typename T, typename M>
-DeSerializeMemberContainer<T, M>::DeSerializeMemberContainer(DeSerializer&, ParserInterface& parser, std::string const& key, T& object, std::pair<char const*, M T::*> const& memberInfo)
+template<typename Parser>
+DeSerializeMemberContainer<T, M>::DeSerializeMemberContainer(BasicDeSerializer<Parser>&, Parser& parser, std::string const& key, T& object, std::pair<char const*, M T::*> const& memberInfo)
 {
     if (key.compare(memberInfo.first) == 0)
     {
         used = true;
-        DeSerializer    deSerializer(parser, false);
+        BasicDeSerializer<Parser>   deSerializer(parser, false);
         deSerializer.parse(object.*(memberInfo.second));
     }
 }
 
 template<typename T, typename M, TraitType Type>
-DeSerializeMemberValue<T, M, Type>::DeSerializeMemberValue(DeSerializer& parent, ParserInterface& parser, std::string const& key, T& object, std::pair<char const*, M T::*> const& memberInfo)
+template<typename Parser>
+DeSerializeMemberValue<T, M, Type>::DeSerializeMemberValue(BasicDeSerializer<Parser>& parent, Parser& parser, std::string const& key, T& object, std::pair<char const*, M T::*> const& memberInfo)
 {
     init(parent, parser, key, memberInfo.first, object.*(memberInfo.second));
 }
 
 template<typename T, typename M, TraitType Type>
-DeSerializeMemberValue<T, M, Type>::DeSerializeMemberValue(DeSerializer& parent, ParserInterface& parser, std::string const& key, T&, std::pair<char const*, M*> const& memberInfo)
+template<typename Parser>
+DeSerializeMemberValue<T, M, Type>::DeSerializeMemberValue(BasicDeSerializer<Parser>& parent, Parser& parser, std::string const& key, T&, std::pair<char const*, M*> const& memberInfo)
 {
     init(parent, parser, key, memberInfo.first, *(memberInfo.second));
 }
 
 template<typename T, typename M, TraitType Type>
-void DeSerializeMemberValue<T, M, Type>::init(DeSerializer& parent, ParserInterface& parser, std::string const& key, char const* name, M& object)
+template<typename Parser>
+void DeSerializeMemberValue<T, M, Type>::init(BasicDeSerializer<Parser>& parent, Parser& parser, std::string const& key, char const* name, M& object)
 {
     if (key.compare(name) == 0)
     {
         used = true;
-        DeSerializationForBlock<Type, M>    deserializer(parent, parser);
+        DeSerializationForBlock<Type, M, Parser>    deserializer(parent, parser);
         deserializer.scanObject(object);
     }
 }
@@ -488,42 +701,46 @@ class DeSerializeMember: public TraitsInfo<T, M, Type>::DeSerializeMember
         using Parent::Parent;
 };
 
-template<typename T, typename M>
-DeSerializeMember<T, M> make_DeSerializeMember(DeSerializer& parent, ParserInterface& parser, std::string const& key, T& object, std::pair<char const*, M*> const& memberInfo)
+template<typename T, typename M, typename Parser>
+DeSerializeMember<T, M> make_DeSerializeMember(BasicDeSerializer<Parser>& parent, Parser& parser, std::string const& key, T& object, std::pair<char const*, M*> const& memberInfo)
 {
     return DeSerializeMember<T, M>(parent, parser, key, object, memberInfo);
 }
 
-template<typename T, typename M>
-DeSerializeMember<T, M> make_DeSerializeMember(DeSerializer& parent, ParserInterface& parser, std::string const& key, T& object, std::pair<char const*, M T::*> const& memberInfo)
+template<typename T, typename M, typename Parser>
+DeSerializeMember<T, M> make_DeSerializeMember(BasicDeSerializer<Parser>& parent, Parser& parser, std::string const& key, T& object, std::pair<char const*, M T::*> const& memberInfo)
 {
     return DeSerializeMember<T, M>(parent, parser, key, object, memberInfo);
 }
 
 /* ------------ DeSerializer ------------------------- */
+template<typename Parser>
 template<typename T, typename Members, std::size_t... Seq>
-inline bool DeSerializer::scanEachMember(std::string const& key, T& object, Members const& member, std::index_sequence<Seq...> const&)
+inline bool BasicDeSerializer<Parser>::scanEachMember(std::string const& key, T& object, Members const& member, std::index_sequence<Seq...> const&)
 {
     using CheckMembers = std::initializer_list<bool>;
     CheckMembers memberCheck = {static_cast<bool>(make_DeSerializeMember(*this, parser, key, object, std::get<Seq>(member)))...};
     return std::find(std::begin(memberCheck), std::end(memberCheck), true) != std::end(memberCheck);
 }
 
+template<typename Parser>
 template<typename T, typename... Members>
-inline bool DeSerializer::scanMembers(std::string const& key, T& object, std::tuple<Members...> const& members)
+inline bool BasicDeSerializer<Parser>::scanMembers(std::string const& key, T& object, std::tuple<Members...> const& members)
 {
     return scanEachMember(key, object, members, std::make_index_sequence<sizeof...(Members)>());
 }
 
+template<typename Parser>
 template<typename T, typename I, typename Action>
-inline bool DeSerializer::scanMembers(I const& key, T& object, Action action)
+inline bool BasicDeSerializer<Parser>::scanMembers(I const& key, T& object, Action action)
 {
     action(parser, key, object);
     return true;
 }
 
+template<typename Parser>
 template<typename T, typename I>
-inline bool DeSerializer::scanObjectMembers(I const& key, T& object)
+inline bool BasicDeSerializer<Parser>::scanObjectMembers(I const& key, T& object)
 {
     ApplyActionToParent<Traits<T>::type, T, I>     parentScanner;
 
@@ -532,12 +749,14 @@ inline bool DeSerializer::scanObjectMembers(I const& key, T& object)
     return result;
 }
 
+template<typename Parser>
 template<typename T>
-inline void DeSerializer::parse(T& object)
+inline void BasicDeSerializer<Parser>::parse(T& object)
 {
     try
     {
-        DeSerializationForBlock<Traits<T>::type, T>     block(*this, parser);
+        SerializeStatsTimer<T>                          timer(parser.config.stats);
+        DeSerializationForBlock<Traits<T>::type, T, Parser> block(*this, parser);
         block.scanObject(object);
     }
     catch (...)
@@ -549,7 +768,7 @@ inline void DeSerializer::parse(T& object)
 
 /* ------------ SerializerForBlock ------------------------- */
 
-template<TraitType traitType, typename T>
+template<TraitType traitType, typename T, typename Printer = PrinterInterface>
 class SerializerForBlock
 {
     static_assert(
@@ -557,11 +776,11 @@ class SerializerForBlock
         "Invalid Serialize TraitType. This usually means you have not define ThorsAnvil::Serialize::Traits<Your Type>"
     );
 
-    Serializer&         parent;
-    PrinterInterface&   printer;
-    T const&            object;
+    BasicSerializer<Printer>&   parent;
+    Printer&                    printer;
+    T const&                    object;
     public:
-        SerializerForBlock(Serializer& parent, PrinterInterface& printer, T const& object)
+        SerializerForBlock(BasicSerializer<Printer>& parent, Printer& printer, T const& object)
             : parent(parent)
             , printer(printer)
             , object(object)
@@ -584,14 +803,14 @@ class SerializerForBlock
         }
 };
 
-template<typename T>
-class SerializerForBlock<TraitType::Value, T>
+template<typename T, typename Printer>
+class SerializerForBlock<TraitType::Value, T, Printer>
 {
-    Serializer&         parent;
-    PrinterInterface&   printer;
-    T const&            object;
+    BasicSerializer<Printer>&   parent;
+    Printer&                    printer;
+    T const&                    object;
     public:
-        SerializerForBlock(Serializer& parent, PrinterInterface& printer,T const& object)
+        SerializerForBlock(BasicSerializer<Printer>& parent, Printer& printer, T const& object)
             : parent(parent)
             , printer(printer)
             , object(object)
@@ -602,14 +821,14 @@ class SerializerForBlock<TraitType::Value, T>
             printer.addValue(object);
         }
 };
-template<typename T>
-class SerializerForBlock<TraitType::Serialize, T>
+template<typename T, typename Printer>
+class SerializerForBlock<TraitType::Serialize, T, Printer>
 {
-    Serializer&         parent;
-    PrinterInterface&   printer;
-    T const&            object;
+    BasicSerializer<Printer>&   parent;
+    Printer&                    printer;
+    T const&                    object;
     public:
-        SerializerForBlock(Serializer& parent, PrinterInterface& printer,T const& object)
+        SerializerForBlock(BasicSerializer<Printer>& parent, Printer& printer, T const& object)
             : parent(parent)
             , printer(printer)
             , object(object)
@@ -617,15 +836,47 @@ class SerializerForBlock<TraitType::Serialize, T>
         ~SerializerForBlock()   {}
         void printMembers()
         {
-            std::stringstream buffer;
-            buffer << object;
-            printer.addRawValue(buffer.str());
+            if constexpr (HasCustomChars<T>::value)
+            {
+                printCustomChars();
+            }
+            else
+            {
+                std::stringstream buffer;
+                buffer << object;
+                printer.addRawValue(buffer.str());
+            }
+        }
+    private:
+        void printCustomChars()
+        {
+            // Most values fit in the local buffer.
+            // If not keep doubling the size of the buffer until it fits.
+            char    local[128];
+            char*   end = Traits<T>::toChars(local, local + sizeof(local), object);
+            if (end != nullptr)
+            {
+                printer.addRawValue(std::string(local, end));
+                return;
+            }
+            std::string     buffer(sizeof(local), '\0');
+            do
+            {
+                if (buffer.size() >= customCharsMaxSize)
+                {   throw std::runtime_error("ThorsAnvil::Serialize::SerializerForBlock<Serialize>::printCustomChars: Value too large");
+                }
+                buffer.resize(buffer.size() * 2);
+                end = Traits<T>::toChars(&buffer[0], &buffer[0] + buffer.size(), object);
+            }
+            while (end == nullptr);
+            buffer.resize(end - &buffer[0]);
+            printer.addRawValue(buffer);
         }
 };
 
 /* ------------ tryPrintPolyMorphicObject Serializer ------------------------- */
-template<class T>
-auto tryPrintPolyMorphicObject(Serializer& parent, PrinterInterface& printer, T const& object, int) -> decltype(object->printPolyMorphicObject(parent, printer), void())
+template<class T, typename Printer>
+auto tryPrintPolyMorphicObject(BasicSerializer<Printer>&, Printer& printer, T const& object, int) -> decltype(object->printPolyMorphicObject(std::declval<Serializer&>(), printer), void())
 {
     // This uses a virtual method in the object to
     // call printPolyMorphicObject() the difference
@@ -635,39 +886,43 @@ auto tryPrintPolyMorphicObject(Serializer& parent, PrinterInterface& printer, T
     //
     // To install this virtual method use the macro
     // ThorsAnvil_PolyMorphicSerializer  See Traits.h for details.
-    object->printPolyMorphicObject(parent, printer);
+    //
+    // Note: A virtual method can not be a template.
+    //       So the object is printed with a Serializer (virtual calls on the printer).
+    Serializer      polyMorphicParent(printer, false);
+    object->printPolyMorphicObject(polyMorphicParent, printer);
 }
-template<class T>
-auto tryPrintPolyMorphicObject(Serializer& parent, PrinterInterface& printer, T const& object, long) -> void
+template<class T, typename Printer>
+auto tryPrintPolyMorphicObject(BasicSerializer<Printer>& parent, Printer& printer, T const& object, long) -> void
 {
     // This version is called if the object foes not have a virtual
     // `printPolyMorphicObject()`. Thus you get a call to the current
     // object and thus we simply use `T` and we can simply print the
     // normal members.
     using BaseType = typename BaseTypeGetter<T>::type;
-    SerializerForBlock<ThorsAnvil::Serialize::Traits<BaseType>::type, BaseType>  block(parent, printer, *object);
+    SerializerForBlock<ThorsAnvil::Serialize::Traits<BaseType>::type, BaseType, Printer>  block(parent, printer, *object);
     block.printMembers();
 }
 /* ------------ PolyMorphic Serializer ------------------------- */
-template<typename T>
-void printPolyMorphicObject(Serializer& parent, PrinterInterface& printer, T const& object)
+template<typename T, typename Printer>
+void printPolyMorphicObject(BasicSerializer<Printer>& parent, Printer& printer, T const& object)
 {
     using BaseType = typename std::remove_pointer<T>::type;
-    SerializerForBlock<ThorsAnvil::Serialize::Traits<BaseType>::type, BaseType>  block(parent, printer, object);
+    SerializerForBlock<ThorsAnvil::Serialize::Traits<BaseType>::type, BaseType, Printer>  block(parent, printer, object);
 
     // Note the call to printPolyMorphicMembers() rather than printMembers()
     // this adds the "__type": "<Type Name>"
     block.printPolyMorphicMembers(T::polyMorphicSerializerName());
 }
 
-template<typename T>
-class SerializerForBlock<TraitType::Pointer, T>
+template<typename T, typename Printer>
+class SerializerForBlock<TraitType::Pointer, T, Printer>
 {
-    Serializer&         parent;
-    PrinterInterface&   printer;
-    T const&            object;
+    BasicSerializer<Printer>&   parent;
+    Printer&                    printer;
+    T const&                    object;
     public:
-        SerializerForBlock(Serializer& parent, PrinterInterface& printer,T const& object)
+        SerializerForBlock(BasicSerializer<Printer>& parent, Printer& printer, T const& object)
             : parent(parent)
             , printer(printer)
             , object(object)
@@ -678,23 +933,50 @@ class SerializerForBlock<TraitType::Pointer, T>
             if (object == nullptr)
             {
                 printer.addNull();
+                return;
+            }
+            if constexpr (IsSharedPtr<T>::value)
+            {
+                if (printer.config.preserveSharedPtr)
+                {
+                    printSharedObject();
+                    return;
+                }
+            }
+            // Use SFINAE to call one of two versions of the function.
+            tryPrintPolyMorphicObject(parent, printer, object, 0);
+        }
+    private:
+        void printSharedObject()
+        {
+            printer.openMap();
+            auto find = printer.sharedPtrIds.find(object.get());
+            if (find != printer.sharedPtrIds.end())
+            {
+                printer.addKey(std::string(sharedPtrRefKey));
+                printer.addValue(find->second);
             }
             else
             {
-                // Use SFINAE to call one of two versions of the function.
+                std::size_t id = printer.sharedPtrIds.size();
+                printer.sharedPtrIds.emplace(object.get(), id);
+                printer.addKey(std::string(sharedPtrIdKey));
+                printer.addValue(id);
+                printer.addKey(std::string(sharedPtrValueKey));
                 tryPrintPolyMorphicObject(parent, printer, object, 0);
             }
+            printer.closeMap();
         }
 };
 
-template<typename T>
-class SerializerForBlock<TraitType::Enum, T>
+template<typename T, typename Printer>
+class SerializerForBlock<TraitType::Enum, T, Printer>
 {
-    Serializer&         parent;
-    PrinterInterface&   printer;
-    T const&            object;
+    BasicSerializer<Printer>&   parent;
+    Printer&                    printer;
+    T const&                    object;
     public:
-        SerializerForBlock(Serializer& parent, PrinterInterface& printer,T const& object)
+        SerializerForBlock(BasicSerializer<Printer>& parent, Printer& printer, T const& object)
             : parent(parent)
             , printer(printer)
             , object(object)
@@ -702,18 +984,76 @@ class SerializerForBlock<TraitType::Enum, T>
         ~SerializerForBlock()   {}
         void printMembers()
         {
-            printer.addValue(Traits<T>::getValues().find(object)->second);
+            printer.addValue(Traits<T>::getName(object, "ThorsAnvil::Serialize::SerializerForBlock<Enum>::printMembers:"));
         }
 };
 
-template<typename T>
-class SerializerForBlock<TraitType::Array, T>
+template<typename T, typename Printer>
+class SerializerForBlock<TraitType::EnumFlag, T, Printer>
+{
+    using Flag      = typename std::underlying_type<T>::type;
+    using Integer   = typename std::conditional<sizeof(Flag) <= sizeof(unsigned int), unsigned int, unsigned long long>::type;
+
+    BasicSerializer<Printer>&   parent;
+    Printer&                    printer;
+    T const&                    object;
+    public:
+        SerializerForBlock(BasicSerializer<Printer>& parent, Printer& printer, T const& object)
+            : parent(parent)
+            , printer(printer)
+            , object(object)
+        {}
+        ~SerializerForBlock()   {}
+        void printMembers()
+        {
+            Flag    value = static_cast<Flag>(object);
+            if (printer.isBinary())
+            {
+                printer.addValue(static_cast<Integer>(value));
+                return;
+            }
+
+            auto const&     names       = Traits<T>::names;
+            std::size_t     count       = 0;
+            Flag            remaining   = value;
+            for (std::size_t loop = 0; loop < names.size(); ++loop)
+            {
+                if (isSet(value, loop))
+                {
+                    ++count;
+                    remaining = static_cast<Flag>(remaining & ~static_cast<Flag>(names.value(loop)));
+                }
+            }
+            if (remaining != 0)
+            {   throw std::runtime_error("ThorsAnvil::Serialize::SerializerForBlock<EnumFlag>::printMembers: Invalid Enum Flag Value");
+            }
+
+            printer.openArray(count);
+            for (std::size_t loop = 0; loop < names.size(); ++loop)
+            {
+                if (isSet(value, loop))
+                {
+                    printer.addValue(Traits<T>::getIndexName(loop));
+                }
+            }
+            printer.closeArray();
+        }
+    private:
+        static bool isSet(Flag value, std::size_t index)
+        {
+            Flag    flag = static_cast<Flag>(Traits<T>::names.value(index));
+            return flag != 0 && (value & flag) == flag;
+        }
+};
+
+template<typename T, typename Printer>
+class SerializerForBlock<TraitType::Array, T, Printer>
 {
-    Serializer&         parent;
-    PrinterInterface& printer;
-    T const&            object;
+    BasicSerializer<Printer>&   parent;
+    Printer&                    printer;
+    T const&                    object;
     public:
-        SerializerForBlock(Serializer& parent, PrinterInterface& printer, T const& object)
+        SerializerForBlock(BasicSerializer<Printer>& parent, Printer& printer, T const& object)
             : parent(parent)
             , printer(printer)
             , object(object)
@@ -733,31 +1073,34 @@ class SerializerForBlock<TraitType::Array, T>
 /* ------------ SerializeMember ------------------------- */
 
 template<typename T, typename M>
-SerializeMemberContainer<T, M>::SerializeMemberContainer(Serializer&, PrinterInterface& printer, T const& object, std::pair<char const*, M T::*> const& memberInfo)
+template<typename Printer>
+SerializeMemberContainer<T, M>::SerializeMemberContainer(BasicSerializer<Printer>&, Printer& printer, T const& object, std::pair<char const*, M T::*> const& memberInfo)
 {
-    printer.addKey(memberInfo.first);
-
-    Serializer      serialzier(printer, false);
+    // Note: The key has already been printed by Serializer::printEachMember()
+    BasicSerializer<Printer>    serialzier(printer, false);
     serialzier.print(object.*(memberInfo.second));
 }
 
 template<typename T, typename M, TraitType Type>
-SerializeMemberValue<T, M, Type>::SerializeMemberValue(Serializer& parent, PrinterInterface& printer, T const& object, std::pair<char const*, M T::*> const& memberInfo)
+template<typename Printer>
+SerializeMemberValue<T, M, Type>::SerializeMemberValue(BasicSerializer<Printer>& parent, Printer& printer, T const& object, std::pair<char const*, M T::*> const& memberInfo)
 {
     init(parent, printer, memberInfo.first, object.*(memberInfo.second));
 }
 
 template<typename T, typename M, TraitType Type>
-SerializeMemberValue<T, M, Type>::SerializeMemberValue(Serializer& parent, PrinterInterface& printer, T const&, std::pair<char const*, M*> const& memberInfo)
+template<typename Printer>
+SerializeMemberValue<T, M, Type>::SerializeMemberValue(BasicSerializer<Printer>& parent, Printer& printer, T const&, std::pair<char const*, M*> const& memberInfo)
 {
     init(parent, printer, memberInfo.first, *(memberInfo.second));
 }
 
 template<typename T, typename M, TraitType Type>
-void SerializeMemberValue<T, M, Type>::init(Serializer& parent, PrinterInterface& printer, char const* member, M const& object)
+template<typename Printer>
+void SerializeMemberValue<T, M, Type>::init(BasicSerializer<Printer>& parent, Printer& printer, char const*, M const& object)
 {
-    printer.addKey(member);
-    SerializerForBlock<Type, M>  serializer(parent, printer, object);
+    // Note: The key has already been printed by Serializer::printEachMember()
+    SerializerForBlock<Type, M, Printer>  serializer(parent, printer, object);
     serializer.printMembers();
 }
 
@@ -769,42 +1112,72 @@ class SerializeMember: public TraitsInfo<T, M, Type>::SerializeMember
         using Parent::Parent;
 };
 
-template<typename T, typename M>
-SerializeMember<T, M> make_SerializeMember(Serializer& ser, PrinterInterface& printer, T const& object, std::pair<char const*, M*> const& memberInfo)
+template<typename T, typename M, typename Printer>
+SerializeMember<T, M> make_SerializeMember(BasicSerializer<Printer>& ser, Printer& printer, T const& object, std::pair<char const*, M*> const& memberInfo)
 {
     return SerializeMember<T,M>(ser, printer, object, memberInfo);
 }
-template<typename T, typename M>
-SerializeMember<T, M> make_SerializeMember(Serializer& ser, PrinterInterface& printer, T const& object, std::pair<char const*, M T::*> const& memberInfo)
+template<typename T, typename M, typename Printer>
+SerializeMember<T, M> make_SerializeMember(BasicSerializer<Printer>& ser, Printer& printer, T const& object, std::pair<char const*, M T::*> const& memberInfo)
 {
     return SerializeMember<T,M>(ser, printer, object, memberInfo);
 }
 
+/* ------------ printMemberKey ------------------------- */
+/*
+ * Types declared with ThorsAnvil_MakeTrait have a pre-built key token for each member.
+ * So the printer can write the key directly. Hand written Traits just have the name.
+ */
+template <typename, typename = void>
+struct HasMemberKeys: std::false_type
+{};
+
+template <class T>
+struct HasMemberKeys<T, std::void_t<decltype(Traits<T>::getMemberKeys())>>: std::true_type
+{};
+
+template<typename T, std::size_t Index, typename Member, typename Printer>
+void printMemberKey(Printer& printer, Member const& memberInfo, std::true_type const&)
+{
+    printer.addKey(PrinterInterface::MemberKey{memberInfo.first, std::get<Index>(Traits<T>::getMemberKeys())});
+}
+template<typename T, std::size_t Index, typename Member, typename Printer>
+void printMemberKey(Printer& printer, Member const& memberInfo, std::false_type const&)
+{
+    printer.addKey(memberInfo.first);
+}
+
 /* ------------ Serializer ------------------------- */
 
+template<typename Printer>
 template<typename T, typename Members, std::size_t... Seq>
-inline void Serializer::printEachMember(T const& object, Members const& member, std::index_sequence<Seq...> const&)
+inline void BasicSerializer<Printer>::printEachMember(T const& object, Members const& member, std::index_sequence<Seq...> const&)
 {
-    auto discard = {1, (make_SerializeMember(*this, printer, object, std::get<Seq>(member)),1)...};
+    auto discard = {1, (printMemberKey<T, Seq>(printer, std::get<Seq>(member), HasMemberKeys<T>{}),
+                        make_SerializeMember(*this, printer, object, std::get<Seq>(member)),1)...};
     (void)discard;
 }
 
+template<typename Printer>
 template<typename T, typename... Members>
-inline void Serializer::printMembers(T const& object, std::tuple<Members...> const& members)
+inline void BasicSerializer<Printer>::printMembers(T const& object, std::tuple<Members...> const& members)
 {
     printEachMember(object, members, std::make_index_sequence<sizeof...(Members)>());
 }
 
+template<typename Printer>
 template<typename T, typename Action>
-inline void Serializer::printMembers(T const& object, Action action)
+inline void BasicSerializer<Printer>::printMembers(T const& object, Action action)
 {
     action(printer, object);
 }
 
+template<typename Printer>
 template<typename T>
-inline void Serializer::print(T const& object)
+inline void BasicSerializer<Printer>::print(T const& object)
 {
-    SerializerForBlock<Traits<T>::type, T>     block(*this, printer, object);
+    SerializeStatsTimer<T>                     timer(printer.config.stats);
+    SerializerForBlock<Traits<T>::type, T, Printer> block(*this, printer, object);
     block.printMembers();
 }
 
@@ -828,8 +1201,9 @@ struct IndexType<TraitType::Parent>
 };
 
 
+template<typename Printer>
 template<typename T>
-inline void Serializer::printObjectMembers(T const& object)
+inline void BasicSerializer<Printer>::printObjectMembers(T const& object)
 {
     using IndexInfoType = typename IndexType<Traits<T>::type>::IndexInfoType;
 
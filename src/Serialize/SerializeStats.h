@@ -0,0 +1,136 @@
+#ifndef THORS_ANVIL_SERIALIZE_SERIALIZE_STATS_H
+#define THORS_ANVIL_SERIALIZE_SERIALIZE_STATS_H
+
+/*
+ * Optional instrumentation for the serialization core.
+ *
+ * Usage:
+ *      SerializeStats                  stats;
+ *      ParserInterface::ParserConfig   config;
+ *      config.stats = &stats;
+ *
+ *      stream >> jsonImport(object, config);
+ *
+ *      std::cout << stats.tokens[static_cast<int>(ParserInterface::ParserToken::Key)] << "\n";
+ *      for (auto const& type: stats.types)
+ *      {
+ *          std::cout << type.second.name << " " << type.second.count << " " << type.second.time.count() << "ns\n";
+ *      }
+ *
+ * The same works for the printer (PrinterInterface::PrinterConfig::stats).
+ *
+ * When no SerializeStats object is provided (the default) each hook is a
+ * single test of a null pointer. So there is no measurable cost.
+ *
+ *  tokens:         Tokens returned by ParserInterface::getToken() indexed by ParserToken.
+ *                  A token that is pushed back and read again is only counted once.
+ *  bytesRead:      Bytes consumed by a root DeSerializer (needs a stream that supports tellg()).
+ *  bytesWritten:   Bytes generated by a root Serializer (needs a stream that supports tellp()).
+ *  keysIgnored:    Keys in the input that did not match a member (the value was skipped).
+ *  allocations:    Objects created by the parser for pointer members.
+ *  types:          For each type T passed through DeSerializer::parse() or Serializer::print()
+ *                  the number of times and the total time spent. The time of a type includes
+ *                  the time of all the types nested inside it.
+ */
+
+#include <array>
+#include <chrono>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <cstddef>
+
+namespace ThorsAnvil
+{
+    namespace Serialize
+    {
+
+struct SerializeStats
+{
+    struct TypeStats
+    {
+        std::string                 name;
+        std::size_t                 count   = 0;
+        std::chrono::nanoseconds    time    = std::chrono::nanoseconds::zero();
+    };
+
+    // Indexed by ParserInterface::ParserToken
+    std::array<std::size_t, 9>                          tokens          = {};
+    std::size_t                                         bytesRead       = 0;
+    std::size_t                                         bytesWritten    = 0;
+    std::size_t                                         keysIgnored     = 0;
+    std::size_t                                         allocations     = 0;
+    std::unordered_map<std::type_index, TypeStats>      types;
+
+    void reset()
+    {
+        *this = SerializeStats{};
+    }
+    void addType(std::type_info const& type, std::chrono::nanoseconds time)
+    {
+        TypeStats&  info = types[std::type_index(type)];
+        if (info.count == 0)
+        {
+            info.name = type.name();
+        }
+        ++info.count;
+        info.time += time;
+    }
+    // Adds the counts from other (used to combine stats collected on separate threads).
+    void merge(SerializeStats const& other)
+    {
+        for (std::size_t loop = 0; loop < tokens.size(); ++loop)
+        {
+            tokens[loop] += other.tokens[loop];
+        }
+        bytesRead       += other.bytesRead;
+        bytesWritten    += other.bytesWritten;
+        keysIgnored     += other.keysIgnored;
+        allocations     += other.allocations;
+        for (auto const& type: other.types)
+        {
+            TypeStats&  info = types[type.first];
+            if (info.count == 0)
+            {
+                info.name = type.second.name;
+            }
+            info.count  += type.second.count;
+            info.time   += type.second.time;
+        }
+    }
+};
+
+// Times the lifetime of the object and adds it to the stats for type T.
+// Does nothing if stats is null.
+template<typename T>
+class SerializeStatsTimer
+{
+    using Clock = std::chrono::steady_clock;
+
+    SerializeStats*     stats;
+    Clock::time_point   start;
+    public:
+        SerializeStatsTimer(SerializeStats* stats)
+            : stats(stats)
+        {
+            if (stats)
+            {
+                start = Clock::now();
+            }
+        }
+        ~SerializeStatsTimer()
+        {
+            if (stats)
+            {
+                stats->addType(typeid(T), std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start));
+            }
+        }
+        SerializeStatsTimer(SerializeStatsTimer const&)             = delete;
+        SerializeStatsTimer& operator=(SerializeStatsTimer const&)  = delete;
+};
+
+    }
+}
+
+#endif
@@ -0,0 +1,46 @@
+#include "SerializeConfig.h"
+#include "StringPool.h"
+#include <cstring>
+
+using namespace ThorsAnvil::Serialize;
+
+HEADER_ONLY_INCLUDE
+char* StringPool::allocate(std::size_t size)
+{
+    if (size > blockSize / 4)
+    {
+        // Large strings get their own block.
+        // So the current block is not wasted.
+        blocks.emplace_back(new char[size]);
+        return blocks.back().get();
+    }
+    if (size > space)
+    {
+        blocks.emplace_back(new char[blockSize]);
+        next    = blocks.back().get();
+        space   = blockSize;
+    }
+    char* result = next;
+    next    += size;
+    space   -= size;
+    return result;
+}
+
+HEADER_ONLY_INCLUDE
+InternedString StringPool::intern(std::string_view value)
+{
+    auto find = strings.find(value);
+    if (find != strings.end())
+    {
+        return InternedString(*find);
+    }
+    char* text = allocate(value.size());
+    if (!value.empty())
+    {
+        std::memcpy(text, value.data(), value.size());
+    }
+    bytes += value.size();
+    std::string_view stored(text, value.size());
+    strings.insert(stored);
+    return InternedString(stored);
+}
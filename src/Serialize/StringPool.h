@@ -0,0 +1,117 @@
+#ifndef THORS_ANVIL_SERIALIZE_STRING_POOL_H
+#define THORS_ANVIL_SERIALIZE_STRING_POOL_H
+
+/*
+ * Optional string interning for the parser.
+ *
+ * Usage:
+ *      struct Product
+ *      {
+ *          InternedString              country;
+ *          std::vector<InternedString> tags;
+ *      };
+ *      ThorsAnvil_MakeTrait(Product, country, tags);
+ *
+ *      StringPool                      pool;
+ *      ParserInterface::ParserConfig   config;
+ *      config.stringPool = &pool;
+ *
+ *      stream >> jsonImport(products, config);
+ *
+ * Each distinct string is stored once in the pool. An InternedString is a
+ * handle (a view) to the text in the pool. So repeated values (and the keys
+ * of std::map<InternedString, V>/std::unordered_map<InternedString, V>)
+ * share storage.
+ *
+ * The pool must outlive the objects that use it.
+ * Parsing an InternedString without a pool throws.
+ */
+
+#include "Traits.h"
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <ostream>
+#include <cstddef>
+
+namespace ThorsAnvil
+{
+    namespace Serialize
+    {
+
+class StringPool;
+
+class InternedString
+{
+    std::string_view    value;
+
+    friend class StringPool;
+    explicit InternedString(std::string_view value)
+        : value(value)
+    {}
+    public:
+        InternedString() = default;
+
+        std::string_view    view() const                {return value;}
+        std::string         str() const                 {return std::string(value);}
+        char const*         data() const                {return value.data();}
+        std::size_t         size() const                {return value.size();}
+        bool                empty() const               {return value.empty();}
+        operator std::string_view() const               {return value;}
+
+        // Strings from the same pool with the same text share storage.
+        // So the pointer test handles the common case.
+        friend bool operator==(InternedString const& lhs, InternedString const& rhs)
+        {
+            return (lhs.value.data() == rhs.value.data() && lhs.value.size() == rhs.value.size()) || lhs.value == rhs.value;
+        }
+        friend bool operator!=(InternedString const& lhs, InternedString const& rhs)   {return !(lhs == rhs);}
+        friend bool operator<(InternedString const& lhs, InternedString const& rhs)    {return lhs.value < rhs.value;}
+        friend std::ostream& operator<<(std::ostream& stream, InternedString const& value) {return stream << value.value;}
+};
+
+class StringPool
+{
+    static constexpr std::size_t blockSize = 64 * 1024;
+
+    std::unordered_set<std::string_view>    strings;
+    std::vector<std::unique_ptr<char[]>>    blocks;
+    char*                                   next    = nullptr;
+    std::size_t                             space   = 0;
+    std::size_t                             bytes   = 0;
+
+    char* allocate(std::size_t size);
+    public:
+        StringPool() = default;
+        StringPool(StringPool const&)               = delete;
+        StringPool& operator=(StringPool const&)    = delete;
+
+        // Returns the handle of the text. The text is copied into the pool the first time it is seen.
+        InternedString  intern(std::string_view value);
+
+        std::size_t     size() const        {return strings.size();}   // Number of distinct strings.
+        std::size_t     memory() const      {return bytes;}             // Bytes of text held by the pool.
+};
+
+template<> class Traits<InternedString>         {public: static constexpr TraitType type = TraitType::Value;};
+
+    }
+}
+
+template<>
+struct std::hash<ThorsAnvil::Serialize::InternedString>
+{
+    std::size_t operator()(ThorsAnvil::Serialize::InternedString const& value) const
+    {
+        return std::hash<std::string_view>{}(value.view());
+    }
+};
+
+#if defined(HEADER_ONLY) && HEADER_ONLY == 1
+#include "StringPool.source"
+#endif
+
+#endif
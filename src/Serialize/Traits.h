@@ -7,12 +7,14 @@
  *  specializations for user defined types.
  *
  *      ThorsAnvil_MakeTraitCustom(DataType)    // Will use operator << and operator >>
+ *      ThorsAnvil_MakeTraitCustomChars(DataType, ToChars, FromChars)
  *      ThorsAnvil_PointerAllocator(DataType, Action)
  *      ThorsAnvil_MakeTrait(DataType, ...)
  *      ThorsAnvil_ExpandTrait(ParentType, DataType, ...)
  *      ThorsAnvil_Template_MakeTrait(TemplateParameterCount, DataType, ...)
  *      ThorsAnvil_Template_ExpandTrait(TemplateParameterCount, ParentType, DataType, ...)
  *      ThorsAnvil_MakeEnum(<EnumType>, <EnumValues>...)
+ *      ThorsAnvil_MakeEnumFlag(<EnumType>, <EnumValues>...)
  *
  *      ThorsAnvil_PolyMorphicSerializer(Type)
  *      ThorsAnvil_RegisterPolyMorphicType(Type)
@@ -21,7 +23,12 @@
  */
 
 #include <string>
+#include <string_view>
+#include <array>
 #include <tuple>
+#include <utility>
+#include <type_traits>
+#include <cstdint>
 #include <map>
 #include <functional>
 #include <memory>
@@ -159,6 +166,8 @@
  * THOR_TYPEACTION:      Declares a type to hold the name and a pointer to the internal object.
  * THOR_VALUEACTION:     Declares an initialization of the Type putting the name and the pointer
  *                  into the object
+ * THOR_KEYACTION:       Declares the quoted key token for the member ("<name>": ) so printers
+ *                  can write the key without building a string at runtime.
  */
 #define BUILDTEMPLATETYPEPARAM(Act, Count)      ALT_REP_OF_N(Act, ,  ,  , Count)
 #define BUILDTEMPLATETYPEVALUE(Act, Count)      ALT_REP_OF_N(Act, , <, >, Count)
@@ -166,9 +175,11 @@
 
 #define THOR_TYPEACTION(TC, Type, Member)       std::pair<char const*, decltype(&Type BUILDTEMPLATETYPEVALUE(THOR_TYPENAMEVALUEACTION, TC) ::Member)>
 #define THOR_VALUEACTION(TC, Type, Member)      { QUOTE(Member), &Type BUILDTEMPLATETYPEVALUE(THOR_TYPENAMEVALUEACTION, TC) ::Member }
-#define THOR_NAMEACTION(TC, Type, Member)       { Type::Member, #Member ## s}
+#define THOR_NAMEACTION(TC, Type, Member)       { Type::Member, #Member }
+#define THOR_KEYACTION(TC, Type, Member)        std::string_view{"\"" QUOTE(Member) "\": "}
 #define LAST_THOR_TYPEACTION(TC, Type)
 #define LAST_THOR_VALUEACTION(TC, Type)
+#define LAST_THOR_KEYACTION(TC, Type)
 #define LAST_THOR_NAMEACTION(TC, Type)
 
 #define THOR_TYPENAMEPARAMACTION(Ex, Id)        typename T ## Id
@@ -217,12 +228,22 @@ class Traits<DataType BUILDTEMPLATETYPEVALUE(THOR_TYPENAMEVALUEACTION, Count) >
                         REP_N(THOR_TYPEACTION, Count, DataType, __VA_ARGS__)        \
                                     >;                                  \
                                                                         \
-        static Members const& getMembers()                              \
-        {                                                               \
-            static constexpr Members members{                           \
+        static constexpr Members members{                               \
                         REP_N(THOR_VALUEACTION, Count, DataType, __VA_ARGS__)       \
-                                            };                          \
+                                        };                              \
+        static constexpr Members const& getMembers()                    \
+        {                                                               \
             return members;                                             \
+        }                                                               \
+                                                                        \
+        using MemberKeys = std::array<std::string_view, std::tuple_size<Members>::value>; \
+                                                                        \
+        static constexpr MemberKeys keys{{                              \
+                        REP_N(THOR_KEYACTION, Count, DataType, __VA_ARGS__)         \
+                                        }};                             \
+        static constexpr MemberKeys const& getMemberKeys()              \
+        {                                                               \
+            return keys;                                                \
         }                                                               \
 };                                                                      \
 }}                                                                      \
@@ -263,6 +284,29 @@ class Traits<DataType>                                                  \
 }}                                                                      \
 DO_ASSERT(DataType)
 
+/*
+ * Like ThorsAnvil_MakeTraitCustom() but the value is converted directly to/from text
+ * (no std::stringstream is created for each value).
+ *
+ *      char* ToChars(char* first, char* last, DataType const& value);
+ *              Writes the value into [first, last) and returns the end of the text.
+ *              Returns nullptr if the buffer is too small (it is called again with a larger buffer).
+ *      bool  FromChars(std::string_view text, DataType& value);
+ *              Returns false if text is not a valid value.
+ */
+#define ThorsAnvil_MakeTraitCustomChars(DataType, ToChars, FromChars)    \
+namespace ThorsAnvil { namespace Serialize {                            \
+template<>                                                              \
+class Traits<DataType>                                                  \
+{                                                                       \
+    public:                                                             \
+        static constexpr TraitType type = TraitType::Serialize;         \
+        static char* toChars(char* first, char* last, DataType const& value) {return ToChars(first, last, value);} \
+        static bool  fromChars(std::string_view text, DataType& value)  {return FromChars(text, value);} \
+};                                                                      \
+}}                                                                      \
+DO_ASSERT(DataType)
+
 #define ThorsAnvil_Template_ExpandTrait(Count, ParentType, ...)         \
     ThorsAnvil_MakeTrait_Base(ThorsAnvil_Parent(Count, ParentType, __VA_ARGS__, 1), Parent, Count, __VA_ARGS__, 1) \
     static_assert(true, "")
@@ -289,29 +333,68 @@ class Traits<EnumName>                                                  \
 {                                                                       \
     public:                                                             \
         static constexpr    TraitType       type = TraitType::Enum;     \
+        static constexpr    EnumNames<EnumName, NUM_ARGS(__VA_ARGS__, 1)> names{{{ \
+                REP_N(THOR_NAMEACTION, 0, EnumName, __VA_ARGS__, 1)     \
+                                            }}};                        \
+        static std::size_t getSize()                                    \
+        {                                                               \
+            return names.size();                                        \
+        }                                                               \
+        /* Kept for compatibility: built from names on first use. */    \
         static std::map<EnumName, std::string> const& getValues()       \
         {                                                               \
-            using std::string_literals::operator""s;                    \
-            static const std::map<EnumName, std::string> values =       \
-            {                                                           \
-                REP_N(THOR_NAMEACTION, 0, EnumName, __VA_ARGS__, 1)     \
-            };                                                          \
+            static const std::map<EnumName, std::string> values = names.map(); \
             return values;                                              \
         }                                                               \
-        static std::size_t getSize()                                    \
+        static std::string const& getName(EnumName val, char const* msg) \
         {                                                               \
-            return NUM_ARGS(__VA_ARGS__, 1);                            \
+            static const auto text = names.text();                      \
+            std::size_t index = names.find(val);                        \
+            if (index == names.size()) {                                \
+                throw std::runtime_error(std::string(msg) + " Invalid Enum Value"); \
+            }                                                           \
+            return text[index];                                         \
         }                                                               \
-        static EnumName getValue(std::string const& val, std::string const& msg) \
+        static EnumName getValue(std::string_view val, std::string const& msg) \
         {                                                               \
-            std::map<EnumName, std::string> const& values = getValues();\
-            for (auto const& value: values)                             \
-            {                                                           \
-                if (val == value.second) {                              \
-                    return value.first;                                 \
-                }                                                       \
+            std::size_t index = names.find(val);                        \
+            if (index == names.size()) {                                \
+                throw std::runtime_error(msg + " Invalid Enum Value");  \
             }                                                           \
-            throw std::runtime_error(msg + " Invalid Enum Value");      \
+            return names.value(index);                                  \
+        }                                                               \
+};                                                                      \
+}}                                                                      \
+DO_ASSERT(EnumName)
+
+/*
+ * For enums where each value is a bit flag and the object can hold several of them.
+ *      Text formats:   An array of the names of the flags that are set.
+ *      Binary formats: A single integer (see PrinterInterface::isBinary()).
+ * Note: A value with bits set that are not named is an error.
+ */
+#define ThorsAnvil_MakeEnumFlag(EnumName, ...)                          \
+namespace ThorsAnvil { namespace Serialize {                            \
+template<>                                                              \
+class Traits<EnumName>                                                  \
+{                                                                       \
+    public:                                                             \
+        static constexpr    TraitType       type = TraitType::EnumFlag; \
+        static constexpr    EnumNames<EnumName, NUM_ARGS(__VA_ARGS__, 1)> names{{{ \
+                REP_N(THOR_NAMEACTION, 0, EnumName, __VA_ARGS__, 1)     \
+                                            }}};                        \
+        static std::string const& getIndexName(std::size_t index)       \
+        {                                                               \
+            static const auto text = names.text();                      \
+            return text[index];                                         \
+        }                                                               \
+        static EnumName getValue(std::string_view val, std::string const& msg) \
+        {                                                               \
+            std::size_t index = names.find(val);                        \
+            if (index == names.size()) {                                \
+                throw std::runtime_error(msg + " Invalid Enum Flag Value"); \
+            }                                                           \
+            return names.value(index);                                  \
         }                                                               \
 };                                                                      \
 }}                                                                      \
@@ -345,7 +428,7 @@ namespace ThorsAnvil
 /*
  * Defines the generic type that all serialization types can expand on
  */
-enum class TraitType {Invalid, Parent, Value, Map, Array, Enum, Pointer, Serialize};
+enum class TraitType {Invalid, Parent, Value, Map, Array, Enum, EnumFlag, Pointer, Serialize};
 
 /*
  * A class for holding multiple header types.
@@ -357,6 +440,130 @@ enum class TraitType {Invalid, Parent, Value, Map, Array, Enum, Pointer, Seriali
 template<typename... P>
 struct Parents: public std::tuple<P...> {};
 
+/*
+ * The names of the values of an enum (used by ThorsAnvil_MakeEnum).
+ * Built at compile time so there is no map to construct at runtime.
+ *
+ *      values: The enum values and their names in declaration order.
+ *      sorted: Index into values ordered by name (for a binary search by name).
+ *      byValue: When the values are contiguous (the usual case) the index into values
+ *               for each value (indexed by value - first). So find(E) is a single lookup.
+ *               Otherwise (gaps or aliases) find(E) is a linear scan.
+ */
+template<typename E, std::size_t N>
+class EnumNames
+{
+    using Names     = std::array<std::pair<E, std::string_view>, N>;
+    using Underlying= typename std::underlying_type<E>::type;
+
+    Names                       values;
+    std::array<std::size_t, N>  sorted;
+    std::array<std::size_t, N>  byValue;
+    Underlying                  first;
+    bool                        dense;
+
+    // Note: Unsigned arithmetic so it works for any underlying type (signed values wrap).
+    static constexpr std::uint64_t offset(E value, Underlying first)
+    {
+        return static_cast<std::uint64_t>(static_cast<Underlying>(value)) - static_cast<std::uint64_t>(first);
+    }
+    public:
+        constexpr EnumNames(Names const& names)
+            : values(names)
+            , sorted{}
+            , byValue{}
+            , first{}
+            , dense(N != 0)
+        {
+            for (std::size_t loop = 0; loop < N; ++loop)
+            {
+                if (loop == 0 || static_cast<Underlying>(values[loop].first) < first)
+                {
+                    first = static_cast<Underlying>(values[loop].first);
+                }
+                byValue[loop] = N;
+            }
+            for (std::size_t loop = 0; dense && loop < N; ++loop)
+            {
+                std::uint64_t   pos = offset(values[loop].first, first);
+                dense = pos < N && byValue[pos] == N;
+                if (dense)
+                {
+                    byValue[pos] = loop;
+                }
+            }
+            // Insertion sort: std::sort is not constexpr.
+            for (std::size_t loop = 0; loop < N; ++loop)
+            {
+                std::size_t pos = loop;
+                for (; pos > 0 && values[loop].second < values[sorted[pos - 1]].second; --pos)
+                {
+                    sorted[pos] = sorted[pos - 1];
+                }
+                sorted[pos] = loop;
+            }
+        }
+        constexpr std::size_t   size()                  const {return N;}
+        constexpr E             value(std::size_t index)const {return values[index].first;}
+
+        // Returns size() if not found.
+        constexpr std::size_t find(E value) const
+        {
+            if (dense)
+            {
+                std::uint64_t   pos = offset(value, first);
+                return pos < N ? byValue[pos] : N;
+            }
+            std::size_t index = 0;
+            for (; index < N && values[index].first != value; ++index)
+            {}
+            return index;
+        }
+        constexpr std::size_t find(std::string_view name) const
+        {
+            std::size_t low   = 0;
+            std::size_t high  = N;
+            while (low < high)
+            {
+                std::size_t mid     = low + (high - low) / 2;
+                std::string_view    midName = values[sorted[mid]].second;
+                if (midName == name)
+                {
+                    return sorted[mid];
+                }
+                if (midName < name)
+                {
+                    low     = mid + 1;
+                }
+                else
+                {
+                    high    = mid;
+                }
+            }
+            return N;
+        }
+        // The names as std::string (the printer interface uses std::string).
+        std::array<std::string, N> text() const
+        {
+            std::array<std::string, N>  result;
+            for (std::size_t loop = 0; loop < N; ++loop)
+            {
+                result[loop] = std::string(values[loop].second);
+            }
+            return result;
+        }
+        // The names by value (for an alias the first name is kept).
+        std::map<E, std::string> map() const
+        {
+            std::map<E, std::string>    result;
+            for (std::size_t loop = 0; loop < N; ++loop)
+            {
+                result.emplace(values[loop].first, values[loop].second);
+            }
+            return result;
+        }
+};
+
 /*
  * To help the macros check the parent type we need to extract the type.
  * There is a special case when we use "Parents" to get the first type
@@ -392,13 +599,9 @@ class Traits
         // they  define a static getMembers() function.
         // static Members const& getMembers()
         //
-        // I would have made this a type declaration but I could
-        // not get it to bind correctly without an explicit
-        // instantiation (if you know how please let me know).
-        //
-        // So I use a static member function with a static variable
-        // which can be defined in-line within the traits class and
-        // does not need a separate declaration in a compilation unit.
+        // The macro generated Traits hold the members in an (inline)
+        // static constexpr member so getMembers() is constexpr and
+        // the member list can be used at compile time (see thash<T>()).
 };
 
 /*
@@ -450,6 +653,7 @@ template<> class Traits<long double>            {public: static constexpr TraitT
 template<> class Traits<bool>                   {public: static constexpr TraitType type = TraitType::Value;};
 
 template<> class Traits<std::string>            {public: static constexpr TraitType type = TraitType::Value;};
+template<> class Traits<std::string_view>       {public: static constexpr TraitType type = TraitType::Value;};
 
 /*
  * For object that are serialized as Json Array
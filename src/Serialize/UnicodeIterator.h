@@ -16,6 +16,8 @@
  *  // Or
  *  std::string     text;
  *  std::copy(std::bin(input), std::end(input), make_UnicodePushBackIterator(text));
+ *
+ * Note: The Json parser decodes a whole string at a time with decodeJsonString() (see JsonStringDecoder.h).
  */
 
 #include <iterator>
@@ -0,0 +1,114 @@
+#include "SerializeConfig.h"
+#include "Utf8Validator.h"
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+using namespace ThorsAnvil::Serialize;
+
+namespace
+{
+using Byte = unsigned char;
+
+inline Byte const* skipAscii(Byte const* next, Byte const* end)
+{
+#if defined(__AVX2__)
+    for (; end - next >= 32; next += 32)
+    {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(next));
+        if (_mm256_movemask_epi8(block) != 0)
+        {
+            break;
+        }
+    }
+#endif
+#if defined(__SSE2__)
+    for (; end - next >= 16; next += 16)
+    {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(next));
+        if (_mm_movemask_epi8(block) != 0)
+        {
+            break;
+        }
+    }
+#endif
+    // Find the exact position of the first non ASCII byte in the block.
+    for (; next != end && *next < 0x80; ++next)
+    {}
+    return next;
+}
+
+inline bool isContinuation(Byte value)
+{
+    return (value & 0xC0) == 0x80;
+}
+
+// next points at a byte >= 0x80.
+// Returns the byte after the sequence or nullptr if the sequence is invalid.
+inline Byte const* checkSequence(Byte const* next, Byte const* end)
+{
+    Byte        lead    = next[0];
+    std::size_t size;
+    Byte        low     = 0x80;     // Range of the second byte.
+    Byte        high    = 0xBF;
+    if (lead < 0xC2)
+    {
+        // Continuation byte or overlong 2 byte sequence.
+        return nullptr;
+    }
+    else if (lead < 0xE0)
+    {
+        size = 2;
+    }
+    else if (lead < 0xF0)
+    {
+        size = 3;
+        low  = lead == 0xE0 ? 0xA0 : 0x80;     // Overlong
+        high = lead == 0xED ? 0x9F : 0xBF;     // Surrogates
+    }
+    else if (lead < 0xF5)
+    {
+        size = 4;
+        low  = lead == 0xF0 ? 0x90 : 0x80;     // Overlong
+        high = lead == 0xF4 ? 0x8F : 0xBF;     // Above U+10FFFF
+    }
+    else
+    {
+        return nullptr;
+    }
+
+    if (static_cast<std::size_t>(end - next) < size || next[1] < low || next[1] > high)
+    {
+        return nullptr;
+    }
+    for (std::size_t loop = 2; loop < size; ++loop)
+    {
+        if (!isContinuation(next[loop]))
+        {
+            return nullptr;
+        }
+    }
+    return next + size;
+}
+}
+
+HEADER_ONLY_INCLUDE
+bool ThorsAnvil::Serialize::isValidUtf8(char const* data, std::size_t size)
+{
+    Byte const* next    = reinterpret_cast<Byte const*>(data);
+    Byte const* end     = next + size;
+    while (true)
+    {
+        next = skipAscii(next, end);
+        if (next == end)
+        {
+            return true;
+        }
+        next = checkSequence(next, end);
+        if (next == nullptr)
+        {
+            return false;
+        }
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef THORS_ANVIL_SERIALIZE_UTF8_VALIDATOR_H
+#define THORS_ANVIL_SERIALIZE_UTF8_VALIDATOR_H
+/*
+ * Checks that a string is well formed UTF-8.
+ *      No overlong encodings.
+ *      No surrogates (U+D800 - U+DFFF).
+ *      Nothing above U+10FFFF.
+ *
+ * Most text is ASCII. So runs of ASCII are skipped a block at a time
+ * (32 bytes with AVX2 or 16 bytes with SSE2 when the compiler targets them).
+ * Anything else is checked one byte at a time.
+ *
+ * Used by the Json and Yaml parsers when ParserConfig::validateUtf8 is set.
+ */
+
+#include <cstddef>
+
+namespace ThorsAnvil
+{
+    namespace Serialize
+    {
+
+bool isValidUtf8(char const* data, std::size_t size);
+
+    }
+}
+
+#if defined(HEADER_ONLY) && HEADER_ONLY == 1
+#include "Utf8Validator.source"
+#endif
+
+#endif
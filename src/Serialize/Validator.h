@@ -0,0 +1,359 @@
+#ifndef THORS_ANVIL_SERIALIZE_VALIDATOR_H
+#define THORS_ANVIL_SERIALIZE_VALIDATOR_H
+/*
+ * SchemaValidator
+ *      Checks that a stream conforms to the Traits<T> of a type without building a T.
+ *
+ *      The validator walks Traits<T> alongside the token stream of the parser and checks:
+ *          The structure:          Maps and arrays are where Traits<T> expects them.
+ *          The key membership:     Unknown keys are an error unless the parser is Weak.
+ *                                  Missing members are an error if the parser is Exact.
+ *          The value types:        Bool/String/Number values match the type of the member.
+ *
+ *      Parsers that know the type of the current value (see ParserInterface::getValueType())
+ *      skip the value without converting numbers or building strings. Other parsers
+ *      read the value into a temporary.
+ *
+ *      Note: The range of a number is not checked (e.g. 300 is accepted for a char member).
+ *            Types that are not Value/Map/Array (enums, pointers, custom serializers) are
+ *            parsed into a temporary object as they have their own rules.
+ *
+ * Usage:
+ *      if (validate<Json, MyType>(stream, ParserInterface::ParseType::Exact)) {
+ *          // Stream conforms to MyType
+ *      }
+ */
+
+#include "Serialize.h"
+#include <istream>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <type_traits>
+
+namespace ThorsAnvil
+{
+    namespace Serialize
+    {
+
+class SchemaValidator
+{
+    using ParserToken   = ParserInterface::ParserToken;
+    using ValueType     = ParserInterface::ValueType;
+    using Check         = void (SchemaValidator::*)();
+    struct Member
+    {
+        char const*     name;
+        Check           check;
+    };
+    using MemberTable   = std::vector<Member>;
+
+    ParserInterface&    parser;
+
+    void expect(ParserToken expected, char const* method);
+
+    template<typename T>
+    void validateMap();
+    template<typename T, typename... Members>
+    void validateMap(std::tuple<Members...> const& members);
+    template<typename T, typename Action>
+    void validateMap(Action const& action);
+    template<typename T>
+    void validateDynamicMap(...);
+    template<typename T>
+    void validateDynamicMap(typename T::mapped_type*);
+    template<typename T>
+    void validateArray(...);
+    template<typename T>
+    void validateArray(typename T::value_type*);
+    template<typename T>
+    void validateGeneric();
+    void validateMembers(MemberTable const& table);
+
+    template<typename T>
+    static MemberTable const& memberTable();
+    template<typename T>
+    static void addMembers(MemberTable& table);
+    template<typename P>
+    static void addParent(MemberTable& table, P*);
+    template<typename... P>
+    static void addParent(MemberTable& table, Parents<P...>*);
+    template<typename... Members>
+    static void addMemberList(MemberTable& table, std::tuple<Members...> const& members);
+    template<typename Action>
+    static void addMemberList(MemberTable&, Action const&) {}
+
+    static void addMember(MemberTable&, void*) {}
+    template<typename O, typename M>
+    static void addMember(MemberTable& table, std::pair<char const*, M O::*> const& member);
+    template<typename M>
+    static void addMember(MemberTable& table, std::pair<char const*, M*> const& member);
+    public:
+        SchemaValidator(ParserInterface& parser);
+
+        // Validate a whole document (DocStart <value> DocEnd).
+        template<typename T>
+        void validateDocument();
+        // Validate the next value in the stream.
+        template<typename T>
+        void validateValue();
+};
+
+/* ------------ SchemaValidator ------------------------- */
+
+inline SchemaValidator::SchemaValidator(ParserInterface& parser)
+    : parser(parser)
+{}
+
+inline void SchemaValidator::expect(ParserToken expected, char const* method)
+{
+    if (parser.getToken() != expected)
+    {
+        throw std::runtime_error(std::string("ThorsAnvil::Serialize::SchemaValidator::") + method + ": Invalid token found");
+    }
+}
+
+template<typename T>
+inline void SchemaValidator::validateDocument()
+{
+    expect(ParserToken::DocStart, "validateDocument");
+    validateValue<T>();
+    expect(ParserToken::DocEnd, "validateDocument");
+}
+
+template<typename T>
+inline void SchemaValidator::validateValue()
+{
+    using Type = typename std::remove_cv<T>::type;
+
+    constexpr TraitType type = Traits<Type>::type;
+    if constexpr (type == TraitType::Value)
+    {
+        ParserToken token = parser.getToken();
+        ValueType   found = parser.getValueType();
+        if (token != ParserToken::Value || found == ValueType::Unknown)
+        {
+            // Let the normal parsing code report the error or convert the value.
+            parser.pushBackToken(token);
+            validateGeneric<Type>();
+            return;
+        }
+
+        bool good = false;
+        if constexpr (std::is_same<Type, bool>::value)
+        {
+            good = found == ValueType::Bool;
+        }
+        else if constexpr (std::is_same<Type, std::string>::value || std::is_same<Type, std::string_view>::value || std::is_same<Type, InternedString>::value)
+        {
+            good = found == ValueType::String;
+        }
+        else if constexpr (std::is_floating_point<Type>::value || std::is_same<Type, RawNumber>::value)
+        {
+            good = found == ValueType::Integer || found == ValueType::Float;
+        }
+        else if constexpr (std::is_integral<Type>::value)
+        {
+            good = found == ValueType::Integer;
+        }
+        if (!good)
+        {
+            throw std::runtime_error("ThorsAnvil::Serialize::SchemaValidator::validateValue: Invalid value type");
+        }
+        parser.ignoreDataValue();
+    }
+    else if constexpr (type == TraitType::Map || type == TraitType::Parent)
+    {
+        validateMap<Type>();
+    }
+    else if constexpr (type == TraitType::Array)
+    {
+        validateArray<Type>(nullptr);
+    }
+    else
+    {
+        validateGeneric<Type>();
+    }
+}
+
+template<typename T>
+inline void SchemaValidator::validateMap()
+{
+    validateMap<T>(Traits<T>::getMembers());
+}
+
+template<typename T, typename... Members>
+inline void SchemaValidator::validateMap(std::tuple<Members...> const&)
+{
+    validateMembers(memberTable<T>());
+}
+
+template<typename T, typename Action>
+inline void SchemaValidator::validateMap(Action const&)
+{
+    validateDynamicMap<T>(nullptr);
+}
+
+template<typename T>
+inline void SchemaValidator::validateDynamicMap(...)
+{
+    // The keys are generated by the Action.
+    // So the validator can not know them.
+    validateGeneric<T>();
+}
+
+template<typename T>
+inline void SchemaValidator::validateDynamicMap(typename T::mapped_type*)
+{
+    expect(ParserToken::MapStart, "validateDynamicMap");
+    for (ParserToken token = parser.getToken(); token != ParserToken::MapEnd; token = parser.getToken())
+    {
+        if (token != ParserToken::Key)
+        {
+            throw std::runtime_error("ThorsAnvil::Serialize::SchemaValidator::validateDynamicMap: Invalid token found. (Expecting Key)");
+        }
+        parser.ignoreDataValue();
+        validateValue<typename T::mapped_type>();
+    }
+}
+
+template<typename T>
+inline void SchemaValidator::validateArray(...)
+{
+    // Arrays of different types (std::tuple).
+    validateGeneric<T>();
+}
+
+template<typename T>
+inline void SchemaValidator::validateArray(typename T::value_type*)
+{
+    expect(ParserToken::ArrayStart, "validateArray");
+    for (ParserToken token = parser.getToken(); token != ParserToken::ArrayEnd && !parser.failed(); token = parser.getToken())
+    {
+        parser.pushBackToken(token);
+        validateValue<typename T::value_type>();
+    }
+}
+
+template<typename T>
+inline void SchemaValidator::validateGeneric()
+{
+    T               value{};
+    DeSerializer    deSerializer(parser, false);
+    deSerializer.parse(value);
+}
+
+inline void SchemaValidator::validateMembers(MemberTable const& table)
+{
+    expect(ParserToken::MapStart, "validateMembers");
+
+    std::vector<bool>   found(table.size(), false);
+    for (ParserToken token = parser.getToken(); token != ParserToken::MapEnd; token = parser.getToken())
+    {
+        if (token != ParserToken::Key)
+        {
+            throw std::runtime_error("ThorsAnvil::Serialize::SchemaValidator::validateMembers: Invalid token found. (Expecting Key)");
+        }
+        std::string key  = parser.getKey();
+        auto        find = std::lower_bound(std::begin(table), std::end(table), key.c_str(),
+                                            [](Member const& lhs, char const* rhs){return std::strcmp(lhs.name, rhs) < 0;});
+        if (find == std::end(table) || std::strcmp(find->name, key.c_str()) != 0)
+        {
+            parser.ignoreValue();
+            continue;
+        }
+        found[find - std::begin(table)] = true;
+        (this->*(find->check))();
+    }
+    if (parser.config.parseStrictness == ParserInterface::ParseType::Exact)
+    {
+        auto missing = std::find(std::begin(found), std::end(found), false);
+        if (missing != std::end(found))
+        {
+            throw std::runtime_error(std::string("ThorsAnvil::Serialize::SchemaValidator::validateMembers: Missing member: ") + table[missing - std::begin(found)].name);
+        }
+    }
+}
+
+template<typename T>
+inline SchemaValidator::MemberTable const& SchemaValidator::memberTable()
+{
+    // Built once per type and sorted by name so keys can be found with a binary search.
+    static MemberTable const table = []()
+    {
+        MemberTable result;
+        addMembers<T>(result);
+        std::sort(std::begin(result), std::end(result),
+                  [](Member const& lhs, Member const& rhs){return std::strcmp(lhs.name, rhs.name) < 0;});
+        return result;
+    }();
+    return table;
+}
+
+template<typename T>
+inline void SchemaValidator::addMembers(MemberTable& table)
+{
+    if constexpr (Traits<T>::type == TraitType::Parent)
+    {
+        addParent(table, static_cast<typename Traits<T>::Parent*>(nullptr));
+    }
+    addMemberList(table, Traits<T>::getMembers());
+}
+
+template<typename P>
+inline void SchemaValidator::addParent(MemberTable& table, P*)
+{
+    addMembers<P>(table);
+}
+
+template<typename... P>
+inline void SchemaValidator::addParent(MemberTable& table, Parents<P...>*)
+{
+    (addMembers<P>(table), ...);
+}
+
+template<typename... Members>
+inline void SchemaValidator::addMemberList(MemberTable& table, std::tuple<Members...> const& members)
+{
+    std::apply([&table](auto const&... member){(addMember(table, member), ...);}, members);
+}
+
+template<typename O, typename M>
+inline void SchemaValidator::addMember(MemberTable& table, std::pair<char const*, M O::*> const& member)
+{
+    table.push_back(Member{member.first, &SchemaValidator::validateValue<M>});
+}
+
+template<typename M>
+inline void SchemaValidator::addMember(MemberTable& table, std::pair<char const*, M*> const& member)
+{
+    table.push_back(Member{member.first, &SchemaValidator::validateValue<M>});
+}
+
+/* ------------ validate ------------------------- */
+
+// @function-api
+// @param stream            The stream to validate.
+// @param config            Parser configuration. 'Weak': ignore extra keys. 'Strict': extra keys are invalid. 'Exact': missing members are also invalid.
+// @return                  true if the stream conforms to Traits<T>.
+template<typename Format, typename T>
+bool validate(std::istream& stream, ParserInterface::ParserConfig config = ParserInterface::ParserConfig{})
+{
+    try
+    {
+        typename Format::Parser parser(stream, config);
+        SchemaValidator         validator(parser);
+        validator.validateDocument<T>();
+        return !parser.failed();
+    }
+    catch (std::exception const&)
+    {
+        return false;
+    }
+}
+
+    }
+}
+
+#endif
@@ -1,6 +1,7 @@
 #include "SerializeConfig.h"
 #ifdef HAVE_YAML
 #include "YamlParser.h"
+#include "Utf8Validator.h"
 
 using namespace ThorsAnvil::Serialize;
 
@@ -170,7 +171,10 @@ std::string YamlParser::getString()
               << "VAL: " << std::string(buffer, buffer + length) << "\n";
 */
 
-
+    if (config.validateUtf8 && !isValidUtf8(buffer, length))
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::YamlParser::getString: Invalid UTF-8");
+    }
     return std::string(buffer, buffer + length);
 }
 
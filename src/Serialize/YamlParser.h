@@ -72,6 +72,7 @@ class YamlParser: public ParserInterface
         virtual void    getValue(bool& value)                   override;
 
         virtual void    getValue(std::string& value)            override;
+        using ParserInterface::getValue;                        // Overloads that are not virtual.
 
         virtual bool    isValueNull()                           override;
 
@@ -36,6 +36,7 @@ class YamlPrinter: public PrinterInterface
         virtual void closeArray()                           override;
 
         virtual void addKey(std::string const& key)         override;
+        virtual void addKey(MemberKey const& key)           override    {addKey(std::string(key.name));}
 
         virtual void addValue(short int value)              override    {emit(value);}
         virtual void addValue(int value)                    override    {emit(value);}
@@ -54,6 +55,7 @@ class YamlPrinter: public PrinterInterface
         virtual void addValue(bool value)                   override    {emit(value?"true":"false");}
 
         virtual void addValue(std::string const& value)     override    {emit(value);}
+        using PrinterInterface::addValue;                    // Overloads that are not virtual.
 
         virtual void addRawValue(std::string const& value)  override    {emit(value);}
 
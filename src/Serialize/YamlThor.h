@@ -5,10 +5,12 @@
  *      ThorsAnvil::Serialize::Yaml
  *      ThorsAnvil::Serialize::yamlExport
  *      ThorsAnvil::Serialize::yamlImport
+ *      ThorsAnvil::Serialize::yamlValidate
  *
  * Usage:
  *      std::cout << yamlExport(object); // converts object to Yaml on an output stream
  *      std::cin  >> yamlImport(object); // converts Yaml to a C++ object from an input stream
+ *      yamlValidate<T>(std::cin);       // checks Yaml conforms to T without building an object
  */
 
 #ifdef HAVE_YAML
@@ -17,6 +19,7 @@
 #include "YamlPrinter.h"
 #include "Exporter.h"
 #include "Importer.h"
+#include "Validator.h"
 
 namespace ThorsAnvil
 {
@@ -48,6 +51,15 @@ template<typename T>
 Importer<Yaml, T> yamlImport(T& value, ParserInterface::ParserConfig config = ParserInterface::ParserConfig{}, bool catchExceptions = false)
 {
     return Importer<Yaml, T>(value, config, catchExceptions);
+}
+// @function-api
+// @param stream            The stream to validate.
+// @param parseStrictness   'Weak':    ignore extra fields. 'Strict': Any extra fields are invalid. 'Exact': Any missing fields are also invalid.
+// @return                  true if the stream conforms to Traits<T> (see Validator.h).
+template<typename T>
+bool yamlValidate(std::istream& stream, ParserInterface::ParserConfig config = ParserInterface::ParserConfig{})
+{
+    return validate<Yaml, T>(stream, config);
 }
     }
 }
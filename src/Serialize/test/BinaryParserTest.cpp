@@ -8,10 +8,20 @@
 namespace TA=ThorsAnvil::Serialize;
 using TA::ParserInterface;
 
+// The header written by BinaryPrinter<T>::openDoc()
+template<typename T>
+std::string header()
+{
+    TBin::BinForm64 hash    = TBin::host2Net(static_cast<TBin::BinForm64>(TA::thash<T>()));
+    std::string     result(1, static_cast<char>(TA::binaryFormatVersion));
+    result.append(reinterpret_cast<char const*>(&hash), sizeof(hash));
+    return result;
+}
+
 
 TEST(BinaryParserTest, ArrayEmpty)
 {
-    std::stringstream   stream(std::string("\xea\xb0\x50\x2f\x00\x00\x00\x00", 8)); // []
+    std::stringstream   stream(header<std::vector<int>>() + std::string("\x00\x00\x00\x00", 4)); // []
     TA::BinaryParser<std::vector<int>>    parser(stream);
 
     EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
@@ -21,7 +31,7 @@ TEST(BinaryParserTest, ArrayEmpty)
 }
 TEST(BinaryParserTest, ArrayOneValue)
 {
-    std::stringstream   stream(std::string("\xea\xb0\x50\x2f\x00\x00\x00\x01\x00\x00\x00\x0c", 12)); // [12]
+    std::stringstream   stream(header<std::vector<int>>() + std::string("\x00\x00\x00\x01\x00\x00\x00\x0c", 8)); // [12]
     TA::BinaryParser<std::vector<int>>      parser(stream);
 
     EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
@@ -32,7 +42,7 @@ TEST(BinaryParserTest, ArrayOneValue)
 }
 TEST(BinaryParserTest, ArrayTwoValue)
 {
-    std::stringstream   stream(std::string("\xea\xb0\x50\x2f\x00\x00\x00\x02\x00\x00\x00\x0c\x00\x00\x00\x0d",16)); // [12,13]
+    std::stringstream   stream(header<std::vector<int>>() + std::string("\x00\x00\x00\x02\x00\x00\x00\x0c\x00\x00\x00\x0d", 12)); // [12,13]
     TA::BinaryParser<std::vector<int>>      parser(stream);
 
     EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
@@ -44,7 +54,7 @@ TEST(BinaryParserTest, ArrayTwoValue)
 }
 TEST(BinaryParserTest, ArrayThreeValue)
 {
-    std::stringstream   stream(std::string("\xea\xb0\x50\x2f\x00\x00\x00\x03\x00\x00\x00\x0c\x00\x00\x00\x0d\x00\x00\x00\x0e", 20));    // [12,13,14]
+    std::stringstream   stream(header<std::vector<int>>() + std::string("\x00\x00\x00\x03\x00\x00\x00\x0c\x00\x00\x00\x0d\x00\x00\x00\x0e", 16));    // [12,13,14]
     TA::BinaryParser<std::vector<int>>      parser(stream);
 
     EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
@@ -57,7 +67,7 @@ TEST(BinaryParserTest, ArrayThreeValue)
 }
 TEST(BinaryParserTest, ArrayWithArray)
 {
-    std::stringstream   stream(std::string("\xfc\x63\xdf\xfd\x00\x00\x00\x01\x00\x00\x00\x00", 12)); // [[]]
+    std::stringstream   stream(header<std::vector<std::vector<int>>>() + std::string("\x00\x00\x00\x01\x00\x00\x00\x00", 8)); // [[]]
     TA::BinaryParser<std::vector<std::vector<int>>>      parser(stream);
 
     EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
@@ -69,7 +79,7 @@ TEST(BinaryParserTest, ArrayWithArray)
 }
 TEST(BinaryParserTest, ArrayWithTwoArray)
 {
-    std::stringstream   stream(std::string("\xfc\x63\xdf\xfd\x00\x00\x00\x02\x00\x00\x00\x00\x00\x00\x00\x00", 16)); // [[],[]]
+    std::stringstream   stream(header<std::vector<std::vector<int>>>() + std::string("\x00\x00\x00\x02\x00\x00\x00\x00\x00\x00\x00\x00", 12)); // [[],[]]
     TA::BinaryParser<std::vector<std::vector<int>>>      parser(stream);
 
     EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
@@ -83,7 +93,7 @@ TEST(BinaryParserTest, ArrayWithTwoArray)
 }
 TEST(BinaryParserTest, ArrayWithMap)
 {
-    std::stringstream   stream(std::string("\xfd\x0e\x05\xca\x00\x00\x00\x01", 8)); // [{}]
+    std::stringstream   stream(header<std::vector<BinaryParserTest::MapEmptyTest>>() + std::string("\x00\x00\x00\x01", 4)); // [{}]
     TA::BinaryParser<std::vector<BinaryParserTest::MapEmptyTest>>      parser(stream);
 
     EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
@@ -95,7 +105,7 @@ TEST(BinaryParserTest, ArrayWithMap)
 }
 TEST(BinaryParserTest, ArrayWithTwoMap)
 {
-    std::stringstream   stream(std::string("\xfd\x0e\x05\xca\x00\x00\x00\x02", 8)); // [{},{}]
+    std::stringstream   stream(header<std::vector<BinaryParserTest::MapEmptyTest>>() + std::string("\x00\x00\x00\x02", 4)); // [{},{}]
     TA::BinaryParser<std::vector<BinaryParserTest::MapEmptyTest>>      parser(stream);
 
     EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
@@ -109,7 +119,7 @@ TEST(BinaryParserTest, ArrayWithTwoMap)
 }
 TEST(BinaryParserTest, MapEmpty)
 {
-    std::stringstream               stream(std::string("\x00\x00\x00\x00", 4));
+    std::stringstream               stream(header<BinaryParserTest::MapEmptyTest>());
     TA::BinaryParser<BinaryParserTest::MapEmptyTest>  parser(stream);
 
     EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
@@ -119,7 +129,7 @@ TEST(BinaryParserTest, MapEmpty)
 }
 TEST(BinaryParserTest, MapOneValue)
 {
-    std::stringstream               stream(std::string("\x00\x3a\x22\xc7\x00\x00\x00\x0c", 8));
+    std::stringstream               stream(header<BinaryParserTest::MapOneValue>() + std::string("\x00\x00\x00\x0c", 4));
     TA::BinaryParser<BinaryParserTest::MapOneValue>   parser(stream);
 
     EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
@@ -131,7 +141,7 @@ TEST(BinaryParserTest, MapOneValue)
 }
 TEST(BinaryParserTest, MapTwoValue)
 {
-    std::stringstream               stream(std::string("\xa7\x1b\xe8\x72\x00\x00\x00\x0c\x00\x00\x00\x0d", 12));
+    std::stringstream               stream(header<BinaryParserTest::MapTwoValue>() + std::string("\x00\x00\x00\x0c\x00\x00\x00\x0d", 8));
     TA::BinaryParser<BinaryParserTest::MapTwoValue>   parser(stream);
 
     EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
@@ -145,7 +155,7 @@ TEST(BinaryParserTest, MapTwoValue)
 }
 TEST(BinaryParserTest, MapThreeValue)
 {
-    std::stringstream               stream(std::string("\xbc\xd9\x07\xdb\x00\x00\x00\x0c\x00\x00\x00\x0d\x00\x00\x00\x0e", 16));
+    std::stringstream               stream(header<BinaryParserTest::MapThreeValue>() + std::string("\x00\x00\x00\x0c\x00\x00\x00\x0d\x00\x00\x00\x0e", 12));
     TA::BinaryParser<BinaryParserTest::MapThreeValue> parser(stream);
 
     EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
@@ -161,7 +171,7 @@ TEST(BinaryParserTest, MapThreeValue)
 }
 TEST(BinaryParserTest, MapWithArray)
 {
-    std::stringstream   stream(std::string("\x47\xeb\xc5\x75\x00\x00\x00\x00", 8)); // {"one": []}
+    std::stringstream   stream(header<BinaryParserTest::MapWithArray>() + std::string("\x00\x00\x00\x00", 4)); // {"one": []}
     TA::BinaryParser<BinaryParserTest::MapWithArray>      parser(stream);
 
     EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
@@ -174,7 +184,7 @@ TEST(BinaryParserTest, MapWithArray)
 }
 TEST(BinaryParserTest, MapWithTwoArray)
 {
-    std::stringstream   stream(std::string("\x9c\x3c\xee\x5a\x00\x00\x00\x00\x00\x00\x00\x00", 12)); // {"one": [], "two": []}
+    std::stringstream   stream(header<BinaryParserTest::MapWithTwoArray>() + std::string("\x00\x00\x00\x00\x00\x00\x00\x00", 8)); // {"one": [], "two": []}
     TA::BinaryParser<BinaryParserTest::MapWithTwoArray>      parser(stream);
 
     EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
@@ -190,7 +200,7 @@ TEST(BinaryParserTest, MapWithTwoArray)
 }
 TEST(BinaryParserTest, MapWithMap)
 {
-    std::stringstream   stream(std::string("\x00\x02\x61\xe2", 4)); // R"({"one": {}})"
+    std::stringstream   stream(header<BinaryParserTest::MapWithMap>()); // R"({"one": {}})"
     TA::BinaryParser<BinaryParserTest::MapWithMap>      parser(stream);
 
     EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
@@ -203,7 +213,7 @@ TEST(BinaryParserTest, MapWithMap)
 }
 TEST(BinaryParserTest, MapWithTwoMap)
 {
-    std::stringstream   stream(std::string("\xd7\x63\xe8\x10", 4)); // {"one": {}, "two": {}}
+    std::stringstream   stream(header<BinaryParserTest::MapWithTwoMap>()); // {"one": {}, "two": {}}
     TA::BinaryParser<BinaryParserTest::MapWithTwoMap>      parser(stream);
 
     EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
@@ -219,7 +229,7 @@ TEST(BinaryParserTest, MapWithTwoMap)
 }
 TEST(BinaryParserTest, GetKeyValue)
 {
-    std::stringstream   stream(std::string("\x00\x3a\x22\xc7\x00\x00\x00\x0F", 8)); // {"One": 15}
+    std::stringstream   stream(header<BinaryParserTest::MapOneValue>() + std::string("\x00\x00\x00\x0F", 4)); // {"One": 15}
     TA::BinaryParser<BinaryParserTest::MapOneValue>      parser(stream);
 
     EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
@@ -240,7 +250,7 @@ TEST(BinaryParserTest, GetKeyValue)
 }
 TEST(BinaryParserTest, GetArrayBoolValues)
 {
-    std::stringstream   stream(std::string("\x24\x8f\x37\x84\x00\x00\x00\x02\x01\x00", 10)); // [true, false]
+    std::stringstream   stream(header<std::vector<bool>>() + std::string("\x00\x00\x00\x02\x01\x00", 6)); // [true, false]
     TA::BinaryParser<std::vector<bool>>      parser(stream);
 
     EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
@@ -262,7 +272,7 @@ TEST(BinaryParserTest, GetArrayBoolValues)
 }
 TEST(BinaryParserTest, GetArrayIntValues)
 {
-    std::stringstream   stream(std::string("\xea\xb0\x50\x2f\x00\x00\x00\x03\x00\x00\x00\x7b\x00\x00\x01\x7b\x00\x00\x99\x7b", 20)); // [123, 379, 39291]
+    std::stringstream   stream(header<std::vector<int>>() + std::string("\x00\x00\x00\x03\x00\x00\x00\x7b\x00\x00\x01\x7b\x00\x00\x99\x7b", 16)); // [123, 379, 39291]
     TA::BinaryParser<std::vector<int>>      parser(stream);
 
     EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
@@ -287,12 +297,12 @@ TEST(BinaryParserTest, GetArrayIntValues)
 }
 TEST(BinaryParserTest, GetArrayFloatValues)
 {
-    std::stringstream   stream(std::string("\xef\x74\x19\xfe"                       // Hash
+    std::stringstream   stream(header<std::vector<double>>() + std::string(
                                             "\x00\x00\x00\x03"                      // Size
                                             "\x40\x5e\xe0\x00\x00\x00\x00\x00"      // 123.5
                                             "\x40\x8a\xdd\x00\x00\x00\x00\x00"      // 859.625
                                             "\x40\x6d\x5c\x00\x00\x00\x00\x00"      // 234.875
-                                            , 32)); // [123.5, 859.625, 234.875]
+                                            , 28)); // [123.5, 859.625, 234.875]
     TA::BinaryParser<std::vector<double>>      parser(stream);
 
     EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
@@ -315,12 +325,12 @@ TEST(BinaryParserTest, GetArrayFloatValues)
 }
 TEST(BinaryParserTest, GetArrayStringValues)
 {
-    std::stringstream   stream(std::string( "\x29\x04\xd4\x19"
+    std::stringstream   stream(header<std::vector<std::string>>() + std::string(
                                             "\x00\x00\x00\x03"
                                             "\x00\x00\x00\x08" "A String"
                                             "\x00\x00\x00\x05" "Blurb"
                                             "\x00\x00\x00\x0e" "Risk The world",
-                                            4 + 4 + (4 + 8) + (4 + 5) + (4 + 14))); // ["A String", "Blurb", "Risk The world"]
+                                            4 + (4 + 8) + (4 + 5) + (4 + 14))); // ["A String", "Blurb", "Risk The world"]
     TA::BinaryParser<std::vector<std::string>>      parser(stream);
 
     EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
@@ -344,7 +354,7 @@ TEST(BinaryParserTest, GetArrayStringValues)
 }
 TEST(BinaryParserTest, getDataFromString)
 {
-    std::stringstream   stream(std::string("\x29\x04\xd4\x19\x00\x00\x00\x01\x00\x00\x00\x04" "Test", 16)); // ["Test"]
+    std::stringstream   stream(header<std::vector<std::string>>() + std::string("\x00\x00\x00\x01\x00\x00\x00\x04" "Test", 12)); // ["Test"]
     TA::BinaryParser<std::vector<std::string>>      parser(stream);
 
     EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
@@ -363,12 +373,12 @@ TEST(BinaryParserTest, getDataFromString)
 
 TEST(BinaryParserTest, TestParentDeSerilization)
 {
-    std::stringstream   stream(std::string( "\xf1\x21\x74\x88"
+    std::stringstream   stream(header<BinaryParserTest::Derived>() + std::string(
                                             "\x00\x00\x00\x00\x00\x00\x00\x00"      // ace
                                             "\x00\x00\x00\x00\x00\x00\x00\x00"      // val
                                             "\x00\x00\x00\x00\x00\x00\x00\x00"      // der
                                             "\x00\x00\x00\x00\x00\x00\x00\x00",     // flt
-                                            36));
+                                            32));
 
     TA::BinaryParser<BinaryParserTest::Derived>   parser(stream);
 
@@ -387,5 +397,24 @@ TEST(BinaryParserTest, TestParentDeSerilization)
 }
 
 
+TEST(BinaryParserTest, RejectUnknownVersion)
+{
+    std::string         input   = header<std::vector<int>>() + std::string("\x00\x00\x00\x00", 4);
+    input[0] = static_cast<char>(TA::binaryFormatVersion + 1);
+    std::stringstream   stream(input);
+
+    ASSERT_ANY_THROW(
+        TA::BinaryParser<std::vector<int>>  parser(stream)
+    );
+}
+TEST(BinaryParserTest, RejectDifferentType)
+{
+    std::stringstream   stream(header<std::vector<double>>() + std::string("\x00\x00\x00\x00", 4));
+
+    ASSERT_ANY_THROW(
+        TA::BinaryParser<std::vector<int>>  parser(stream)
+    );
+}
+
 #endif
 
@@ -17,8 +17,8 @@ TEST(BinaryPrinterTest, ArrayTokens)
     printer.closeDoc();
 
     std::string     result  = stream.str();
-    EXPECT_EQ(4, result.size());
-    EXPECT_EQ(0, result.compare(0, 4, "\0\0\0I", 4));
+    EXPECT_EQ(9, result.size());
+    EXPECT_EQ(0, result.compare(0, 9, "\x01\xb8\xc6\x88\x62\x26\xc4\x81\xbc", 9));     // Version + THash of int
 }
 TEST(BinaryPrinterTest, MapTokens)
 {
@@ -31,8 +31,8 @@ TEST(BinaryPrinterTest, MapTokens)
     printer.closeDoc();
 
     std::string     result  = stream.str();
-    EXPECT_EQ(8, result.size());
-    EXPECT_EQ(0, result.compare(0, 8, "\0\0\0I\0\0\0\0", 8));
+    EXPECT_EQ(13, result.size());
+    EXPECT_EQ(0, result.compare(0, 13, "\x01\xb8\xc6\x88\x62\x26\xc4\x81\xbc\0\0\0\0", 13));
 }
 TEST(BinaryPrinterTest, intToken)
 {
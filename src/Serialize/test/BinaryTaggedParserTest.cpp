@@ -0,0 +1,180 @@
+#include "SerializeConfig.h"
+#ifdef NETWORK_BYTE_ORDER
+
+#include "gtest/gtest.h"
+#include "Serialize.h"
+#include "Serialize.tpp"
+#include "SerUtil.h"
+#include "BinaryTaggedThor.h"
+#include <sstream>
+#include <vector>
+#include <map>
+
+namespace BinaryTaggedParserTest
+{
+struct PointV1
+{
+    int                 x;
+    int                 y;
+};
+struct PointV2
+{
+    int                 x;
+    int                 y;
+    std::vector<int>    tags;
+    std::string         name;
+};
+struct Shape
+{
+    std::string         kind;
+};
+struct Circle: public Shape
+{
+    PointV2             centre;
+    double              radius;
+};
+struct Tree
+{
+    int                 value;
+    std::vector<Tree>   children;
+};
+}
+ThorsAnvil_MakeTrait(BinaryTaggedParserTest::PointV1, x, y);
+ThorsAnvil_MakeTrait(BinaryTaggedParserTest::PointV2, x, y, tags, name);
+ThorsAnvil_MakeTrait(BinaryTaggedParserTest::Shape, kind);
+ThorsAnvil_ExpandTrait(BinaryTaggedParserTest::Shape, BinaryTaggedParserTest::Circle, centre, radius);
+ThorsAnvil_MakeTrait(BinaryTaggedParserTest::Tree, value, children);
+
+using namespace ThorsAnvil::Serialize;
+using ParserToken = ParserInterface::ParserToken;
+
+TEST(BinaryTaggedParserTest, RoundTripWithParent)
+{
+    BinaryTaggedParserTest::Circle  circle;
+    circle.kind     = "circle";
+    circle.centre   = {4, 5, {1, 2, 3}, "centre"};
+    circle.radius   = 2.5;
+
+    std::stringstream   stream;
+    stream << binTaggedExport(circle);
+
+    BinaryTaggedParserTest::Circle  result;
+    stream >> binTaggedImport(result);
+
+    EXPECT_EQ("circle", result.kind);
+    EXPECT_EQ(4,        result.centre.x);
+    EXPECT_EQ(5,        result.centre.y);
+    EXPECT_EQ(std::vector<int>({1, 2, 3}), result.centre.tags);
+    EXPECT_EQ("centre", result.centre.name);
+    EXPECT_EQ(2.5,      result.radius);
+}
+TEST(BinaryTaggedParserTest, NewReaderDefaultsMissingFields)
+{
+    BinaryTaggedParserTest::PointV1 point{7, 8};
+
+    std::stringstream   stream;
+    stream << binTaggedExport(point);
+
+    BinaryTaggedParserTest::PointV2 result{0, 0, {9}, "old"};
+    stream >> binTaggedImport(result);
+
+    EXPECT_EQ(7,        result.x);
+    EXPECT_EQ(8,        result.y);
+    EXPECT_EQ(std::vector<int>({9}), result.tags);
+    EXPECT_EQ("old",    result.name);
+}
+TEST(BinaryTaggedParserTest, OldReaderSkipsUnknownFields)
+{
+    std::vector<BinaryTaggedParserTest::PointV2>    points{{1, 2, {3, 4}, "A"}, {5, 6, {}, "B"}};
+
+    std::stringstream   stream;
+    stream << binTaggedExport(points);
+
+    std::vector<BinaryTaggedParserTest::PointV1>    result;
+    stream >> binTaggedImport(result);
+
+    ASSERT_EQ(2, result.size());
+    EXPECT_EQ(1, result[0].x);
+    EXPECT_EQ(2, result[0].y);
+    EXPECT_EQ(5, result[1].x);
+    EXPECT_EQ(6, result[1].y);
+    EXPECT_EQ(std::char_traits<char>::eof(), stream.peek());
+}
+TEST(BinaryTaggedParserTest, ExactReportsMissingFields)
+{
+    BinaryTaggedParserTest::PointV1 point{7, 8};
+
+    std::stringstream   stream;
+    stream << binTaggedExport(point);
+
+    BinaryTaggedParserTest::PointV2 result;
+    EXPECT_THROW(
+        stream >> binTaggedImport(result, ParserInterface::ParseType::Exact),
+        std::runtime_error
+    );
+}
+TEST(BinaryTaggedParserTest, StringKeyMap)
+{
+    std::map<std::string, BinaryTaggedParserTest::PointV1>  data{{"one", {1, 2}}, {"two", {3, 4}}};
+
+    std::stringstream   stream;
+    stream << binTaggedExport(data);
+
+    std::map<std::string, BinaryTaggedParserTest::PointV1>  result;
+    stream >> binTaggedImport(result);
+
+    ASSERT_EQ(2, result.size());
+    EXPECT_EQ(2, result["one"].y);
+    EXPECT_EQ(3, result["two"].x);
+}
+TEST(BinaryTaggedParserTest, RecursiveType)
+{
+    BinaryTaggedParserTest::Tree    tree{1, {{2, {}}, {3, {{4, {}}}}}};
+
+    std::stringstream   stream;
+    stream << binTaggedExport(tree);
+
+    BinaryTaggedParserTest::Tree    result;
+    stream >> binTaggedImport(result);
+
+    EXPECT_EQ(1, result.value);
+    ASSERT_EQ(2, result.children.size());
+    EXPECT_EQ(3, result.children[1].value);
+    ASSERT_EQ(1, result.children[1].children.size());
+    EXPECT_EQ(4, result.children[1].children[0].value);
+}
+TEST(BinaryTaggedParserTest, TokensForUnknownFieldAreSkipped)
+{
+    // {x: 1, <id 3: [1]>, y: 2} read as PointV1
+    std::stringstream   stream(std::string("\x02\x00\x00\x00\x04\x00\x00\x00\x01"
+                                           "\x06\x00\x00\x00\x08\x00\x00\x00\x01\x00\x00\x00\x01"
+                                           "\x04\x00\x00\x00\x04\x00\x00\x00\x02"
+                                           "\x00", 32));
+    BinaryTaggedParser  parser(stream, ParserInterface::ParserConfig{}, taggedSchema<BinaryTaggedParserTest::PointV1>());
+
+    int value;
+    EXPECT_EQ(ParserToken::DocStart,    parser.getToken());
+    EXPECT_EQ(ParserToken::MapStart,    parser.getToken());
+    EXPECT_EQ(ParserToken::Key,         parser.getToken());
+    EXPECT_EQ("x",                      parser.getKey());
+    EXPECT_EQ(ParserToken::Value,       parser.getToken());
+    parser.getValue(value);
+    EXPECT_EQ(1,                        value);
+    EXPECT_EQ(ParserToken::Key,         parser.getToken());
+    EXPECT_EQ("y",                      parser.getKey());
+    EXPECT_EQ(ParserToken::Value,       parser.getToken());
+    parser.getValue(value);
+    EXPECT_EQ(2,                        value);
+    EXPECT_EQ(ParserToken::MapEnd,      parser.getToken());
+    EXPECT_EQ(ParserToken::DocEnd,      parser.getToken());
+}
+TEST(BinaryTaggedParserTest, TruncatedInput)
+{
+    std::stringstream   stream(std::string("\x02\x00\x00", 3));
+    BinaryTaggedParserTest::PointV1 result;
+    EXPECT_THROW(
+        stream >> binTaggedImport(result),
+        std::runtime_error
+    );
+}
+#endif
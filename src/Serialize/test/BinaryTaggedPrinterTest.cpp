@@ -0,0 +1,75 @@
+#include "SerializeConfig.h"
+#ifdef NETWORK_BYTE_ORDER
+
+#include "gtest/gtest.h"
+#include "Serialize.h"
+#include "Serialize.tpp"
+#include "SerUtil.h"
+#include "BinaryTaggedThor.h"
+#include <sstream>
+#include <vector>
+#include <map>
+
+namespace BinaryTaggedPrinterTest
+{
+struct Item
+{
+    int         a;
+    std::string b;
+};
+}
+ThorsAnvil_MakeTrait(BinaryTaggedPrinterTest::Item, a, b);
+
+using namespace ThorsAnvil::Serialize;
+
+TEST(BinaryTaggedPrinterTest, MapWritesFieldIds)
+{
+    BinaryTaggedPrinterTest::Item   item{1, "x"};
+    std::stringstream               stream;
+    stream << binTaggedExport(item);
+
+    std::string     result  = stream.str();
+    EXPECT_EQ(20,   result.size());
+    EXPECT_EQ(std::string("\x02\x00\x00\x00\x04\x00\x00\x00\x01"
+                          "\x04\x00\x00\x00\x05\x00\x00\x00\x01x"
+                          "\x00", 20), result);
+}
+TEST(BinaryTaggedPrinterTest, StringKeysWrittenAsText)
+{
+    std::map<std::string, short>    data{{"ab", 5}};
+    std::stringstream               stream;
+    stream << binTaggedExport(data);
+
+    std::string     result  = stream.str();
+    EXPECT_EQ(10,   result.size());
+    EXPECT_EQ(std::string("\x05" "ab" "\x00\x00\x00\x02" "\x00\x05" "\x00", 10), result);
+}
+TEST(BinaryTaggedPrinterTest, ArrayHasCountNoTags)
+{
+    std::vector<int>    data{1, 2};
+    std::stringstream   stream;
+    stream << binTaggedExport(data);
+
+    std::string     result  = stream.str();
+    EXPECT_EQ(12,   result.size());
+    EXPECT_EQ(std::string("\x00\x00\x00\x02\x00\x00\x00\x01\x00\x00\x00\x02", 12), result);
+}
+TEST(BinaryTaggedPrinterTest, NestedFieldSizeIncludesChildren)
+{
+    std::vector<BinaryTaggedPrinterTest::Item>  data{{1, "x"}};
+    std::map<std::string, std::vector<BinaryTaggedPrinterTest::Item>>   wrap{{"v", data}};
+    std::stringstream   stream;
+    stream << binTaggedExport(wrap);
+
+    std::string     result  = stream.str();
+    // key(2) + size(4) + count(4) + item(20) + end(1)
+    EXPECT_EQ(31,   result.size());
+    EXPECT_EQ(std::string("\x03v\x00\x00\x00\x18", 6), result.substr(0, 6));
+}
+TEST(BinaryTaggedPrinterTest, NullNotSupported)
+{
+    std::stringstream   stream;
+    BinaryTaggedPrinter printer(stream);
+    EXPECT_THROW(printer.addNull(), std::runtime_error);
+}
+#endif
@@ -0,0 +1,183 @@
+#include "gtest/gtest.h"
+#include "Serialize.h"
+#include "Serialize.tpp"
+#include "SerUtil.h"
+#include "BsonThor.h"
+#include <sstream>
+#include <vector>
+#include <map>
+
+namespace BsonParserTest
+{
+struct Person
+{
+    std::string                 name;
+    int                         age;
+    double                      height;
+    bool                        active;
+    std::vector<long long>      scores;
+    std::map<std::string, int>  counts;
+};
+struct PersonV2
+{
+    std::string                 name;
+    int                         age;
+};
+}
+ThorsAnvil_MakeTrait(BsonParserTest::Person, name, age, height, active, scores, counts);
+ThorsAnvil_MakeTrait(BsonParserTest::PersonV2, name, age);
+
+namespace TA=ThorsAnvil::Serialize;
+using TA::ParserInterface;
+
+TEST(BsonParserTest, MapWithArray)
+{
+    // {"a": [1, "xy"], "b": 2}
+    std::string         input("\x29\x00\x00\x00"
+                              "\x04" "a\x00"
+                                  "\x16\x00\x00\x00"
+                                  "\x10" "0\x00" "\x01\x00\x00\x00"
+                                  "\x02" "1\x00" "\x03\x00\x00\x00" "xy\x00"
+                                  "\x00"
+                              "\x12" "b\x00" "\x02\x00\x00\x00\x00\x00\x00\x00"
+                              "\x00", 41);
+    std::stringstream   stream(input);
+    TA::BsonParser      parser(stream);
+
+    EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::MapStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::Key,        parser.getToken());
+    EXPECT_EQ("a", parser.getKey());
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayStart, parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser.getToken());
+    int value;
+    parser.getValue(value);
+    EXPECT_EQ(1, value);
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser.getToken());
+    std::string text;
+    parser.getValue(text);
+    EXPECT_EQ("xy", text);
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayEnd,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::Key,        parser.getToken());
+    EXPECT_EQ("b", parser.getKey());
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser.getToken());
+    long long   big;
+    parser.getValue(big);
+    EXPECT_EQ(2, big);
+    EXPECT_EQ(ParserInterface::ParserToken::MapEnd,     parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::DocEnd,     parser.getToken());
+}
+TEST(BsonParserTest, RootValue)
+{
+    int                 value = 12;
+    std::stringstream   stream;
+    stream << TA::bsonExport(value);
+
+    int                 result = 0;
+    stream >> TA::bsonImport(result);
+    EXPECT_EQ(12, result);
+}
+TEST(BsonParserTest, RootArray)
+{
+    std::vector<std::string>    value{"a", "bc", ""};
+    std::stringstream           stream;
+    stream << TA::bsonExport(value);
+
+    std::vector<std::string>    result;
+    stream >> TA::bsonImport(result);
+    EXPECT_EQ(value, result);
+}
+TEST(BsonParserTest, UnknownDocumentsAreSkippedWithoutTokens)
+{
+    BsonParserTest::Person  person{"Alice", 30, 1.6, false, {}, {}};
+    for (int loop = 0; loop < 100; ++loop)
+    {
+        person.scores.push_back(loop);
+        person.counts[std::to_string(loop)] = loop;
+    }
+
+    std::stringstream       stream;
+    stream << TA::bsonExport(person);
+
+    TA::SerializeStats              stats;
+    ParserInterface::ParserConfig   config;
+    config.stats = &stats;
+
+    BsonParserTest::PersonV2    result{};
+    stream >> TA::bsonImport(result, config);
+
+    EXPECT_EQ("Alice",  result.name);
+    EXPECT_EQ(30,       result.age);
+    // Only the two members that are used generate a value token.
+    EXPECT_EQ(2, stats.tokens[static_cast<int>(ParserInterface::ParserToken::Value)]);
+    EXPECT_EQ(4, stats.keysIgnored);
+    EXPECT_EQ(stream.str().size(), stats.bytesRead);
+}
+TEST(BsonParserTest, IntegerOutOfRange)
+{
+    std::stringstream   stream(std::string("\x0C\x00\x00\x00" "\x10" "\x00" "\x00\x00\x01\x00" "\x00", 12));
+    TA::BsonParser      parser(stream, ParserInterface::ParserConfig{}, TA::BsonContainer::Value);
+
+    EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser.getToken());
+    int     value   = 0;
+    parser.getValue(value);
+    EXPECT_EQ(65536, value);
+    short   small   = 0;
+    EXPECT_THROW(
+        parser.getValue(small),
+        std::runtime_error
+    );
+    EXPECT_EQ(ParserInterface::ParserToken::DocEnd,     parser.getToken());
+}
+TEST(BsonParserTest, TruncatedInput)
+{
+    std::stringstream   stream(std::string("\x10\x00\x00\x00" "\x02" "a\x00" "\x05\x00", 9));
+    TA::BsonParser      parser(stream);
+
+    EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::MapStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::Key,        parser.getToken());
+    EXPECT_THROW(
+        parser.getToken(),
+        std::runtime_error
+    );
+}
+TEST(BsonParserTest, IgnoredValueWithInvalidSize)
+{
+    // {"x": <document with size -1>}: The value is skipped as PersonV2 has no member "x".
+    std::string                 input("\x10\x00\x00\x00" "\x03" "x\x00" "\xFF\xFF\xFF\xFF" "\x00\x00\x00\x00", 16);
+    std::stringstream           stream(input + std::string(100, 'X'));
+    BsonParserTest::PersonV2    result{};
+
+    EXPECT_THROW(
+        stream >> TA::bsonImport(result),
+        std::runtime_error
+    );
+    // The size is rejected before anything is skipped.
+    EXPECT_EQ(11, stream.rdbuf()->pubseekoff(0, std::ios_base::cur, std::ios_base::in));
+}
+TEST(BsonParserTest, IgnoredStringWithInvalidSize)
+{
+    // {"x": <string with size 0>}
+    std::string                 input("\x10\x00\x00\x00" "\x02" "x\x00" "\x00\x00\x00\x00" "\x00\x00\x00\x00", 16);
+    std::stringstream           stream(input + std::string(100, 'X'));
+    BsonParserTest::PersonV2    result{};
+
+    EXPECT_THROW(
+        stream >> TA::bsonImport(result),
+        std::runtime_error
+    );
+    EXPECT_EQ(11, stream.rdbuf()->pubseekoff(0, std::ios_base::cur, std::ios_base::in));
+}
+TEST(BsonParserTest, BinaryWithNegativeSize)
+{
+    // {"": <binary with size -1>}
+    std::stringstream   stream(std::string("\x10\x00\x00\x00" "\x05" "\x00" "\xFF\xFF\xFF\xFF" "\x00" "\x00\x00\x00\x00", 16));
+    std::string         result;
+
+    EXPECT_THROW(
+        stream >> TA::bsonImport(result),
+        std::runtime_error
+    );
+}
@@ -0,0 +1,100 @@
+#include "gtest/gtest.h"
+#include "BsonPrinter.h"
+#include <sstream>
+
+namespace TA=ThorsAnvil::Serialize;
+
+TEST(BsonPrinterTest, SimpleMap)
+{
+    std::stringstream   stream;
+    TA::BsonPrinter     printer(stream);
+
+    printer.openDoc();
+    printer.openMap();
+    printer.addKey("a");
+    printer.addValue(1);
+    printer.addKey(TA::PrinterInterface::MemberKey{"b", "\"b\": "});
+    printer.addValue(std::string("xy"));
+    printer.closeMap();
+    printer.closeDoc();
+
+    std::string expected("\x16\x00\x00\x00"
+                         "\x10" "a\x00" "\x01\x00\x00\x00"
+                         "\x02" "b\x00" "\x03\x00\x00\x00" "xy\x00"
+                         "\x00", 22);
+    EXPECT_EQ(expected, stream.str());
+}
+TEST(BsonPrinterTest, NestedArray)
+{
+    std::stringstream   stream;
+    TA::BsonPrinter     printer(stream);
+
+    printer.openDoc();
+    printer.openMap();
+    printer.addKey("v");
+    printer.openArray(2);
+    printer.addValue(true);
+    printer.addNull();
+    printer.closeArray();
+    printer.closeMap();
+    printer.closeDoc();
+
+    std::string expected("\x14\x00\x00\x00"
+                         "\x04" "v\x00"
+                            "\x0C\x00\x00\x00"
+                            "\x08" "0\x00" "\x01"
+                            "\x0A" "1\x00"
+                            "\x00"
+                         "\x00", 20);
+    EXPECT_EQ(expected, stream.str());
+}
+TEST(BsonPrinterTest, RootValueIsWrapped)
+{
+    std::stringstream   stream;
+    TA::BsonPrinter     printer(stream);
+
+    printer.openDoc();
+    printer.addValue(2.5);
+    printer.closeDoc();
+
+    std::string expected("\x0F\x00\x00\x00"
+                         "\x01" "\x00" "\x00\x00\x00\x00\x00\x00\x04\x40"
+                         "\x00", 15);
+    EXPECT_EQ(expected, stream.str());
+}
+TEST(BsonPrinterTest, UnsignedTooLarge)
+{
+    std::stringstream   stream;
+    TA::BsonPrinter     printer(stream);
+
+    printer.openDoc();
+    printer.openArray(1);
+    EXPECT_THROW(
+        printer.addValue(static_cast<unsigned long long>(-1)),
+        std::runtime_error
+    );
+}
+TEST(BsonPrinterTest, CloseMapWithArray)
+{
+    std::stringstream   stream;
+    TA::BsonPrinter     printer(stream);
+
+    printer.openDoc();
+    printer.openArray(0);
+    EXPECT_THROW(
+        printer.closeMap(),
+        std::runtime_error
+    );
+}
+TEST(BsonPrinterTest, KeyInArray)
+{
+    std::stringstream   stream;
+    TA::BsonPrinter     printer(stream);
+
+    printer.openDoc();
+    printer.openArray(1);
+    EXPECT_THROW(
+        printer.addKey("K1"),
+        std::runtime_error
+    );
+}
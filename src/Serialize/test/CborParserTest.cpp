@@ -0,0 +1,114 @@
+#include "gtest/gtest.h"
+#include "Serialize.h"
+#include "Serialize.tpp"
+#include "SerUtil.h"
+#include "CborThor.h"
+#include <sstream>
+
+namespace TA=ThorsAnvil::Serialize;
+using TA::ParserInterface;
+
+TEST(CborParserTest, ArrayEmpty)
+{
+    std::stringstream   stream(std::string("\x80", 1));
+    TA::CborParser      parser(stream);
+
+    EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayStart, parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayEnd,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::DocEnd,     parser.getToken());
+}
+TEST(CborParserTest, DefiniteMapWithIndefiniteArray)
+{
+    // {"a": [1, -2], "b": "xy"}
+    std::stringstream   stream(std::string("\xA2" "\x61" "a" "\x9F\x01\x21\xFF" "\x61" "b" "\x62" "xy", 12));
+    TA::CborParser      parser(stream);
+
+    EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::MapStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::Key,        parser.getToken());
+    EXPECT_EQ("a", parser.getKey());
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayStart, parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser.getToken());
+    int value;
+    parser.getValue(value);
+    EXPECT_EQ(1, value);
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser.getToken());
+    parser.getValue(value);
+    EXPECT_EQ(-2, value);
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayEnd,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::Key,        parser.getToken());
+    EXPECT_EQ("b", parser.getKey());
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser.getToken());
+    std::string text;
+    parser.getValue(text);
+    EXPECT_EQ("xy", text);
+    EXPECT_EQ(ParserInterface::ParserToken::MapEnd,     parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::DocEnd,     parser.getToken());
+}
+TEST(CborParserTest, HalfFloatTagAndChunkedString)
+{
+    // [1.5 (half), tag(1) 100, (_ "ab" "c")]
+    std::stringstream   stream(std::string("\x83" "\xF9\x3E\x00" "\xC1\x18\x64" "\x7F\x62" "ab" "\x61" "c" "\xFF", 15));
+    TA::CborParser      parser(stream);
+
+    EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayStart, parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser.getToken());
+    double  real;
+    parser.getValue(real);
+    EXPECT_EQ(1.5, real);
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser.getToken());
+    unsigned int number;
+    parser.getValue(number);
+    EXPECT_EQ(100, number);
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser.getToken());
+    std::string text;
+    parser.getValue(text);
+    EXPECT_EQ("abc", text);
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayEnd,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::DocEnd,     parser.getToken());
+}
+TEST(CborParserTest, IntegerOutOfRange)
+{
+    std::stringstream   stream(std::string("\x1A\x00\x01\x00\x00", 5));
+    TA::CborParser      parser(stream);
+
+    EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser.getToken());
+    int     value   = 0;
+    parser.getValue(value);
+    EXPECT_EQ(65536, value);
+    short   small   = 0;
+    EXPECT_THROW(
+        parser.getValue(small),
+        std::runtime_error
+    );
+    std::string text;
+    EXPECT_THROW(
+        parser.getValue(text),
+        std::runtime_error
+    );
+}
+TEST(CborParserTest, TruncatedInput)
+{
+    std::stringstream   stream(std::string("\x62" "x", 2));
+    TA::CborParser      parser(stream);
+
+    EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
+    EXPECT_THROW(
+        parser.getToken(),
+        std::runtime_error
+    );
+}
+TEST(CborParserTest, LongRunOfTags)
+{
+    // tag(1) repeated many times then the value 5.
+    std::string         input(1000000, '\xC1');
+    input += '\x05';
+    std::stringstream   stream(input);
+    int                 value = 0;
+
+    stream >> TA::cborImport(value);
+    EXPECT_EQ(5, value);
+}
@@ -0,0 +1,131 @@
+#include "gtest/gtest.h"
+#include "CborPrinter.h"
+#include <sstream>
+
+namespace TA=ThorsAnvil::Serialize;
+
+TEST(CborPrinterTest, SmallInteger)
+{
+    std::stringstream   stream;
+    TA::CborPrinter     printer(stream);
+
+    printer.openDoc();
+    printer.addValue(10);
+    printer.closeDoc();
+
+    EXPECT_EQ(std::string("\x0A", 1), stream.str());
+}
+TEST(CborPrinterTest, IntegerSizes)
+{
+    std::stringstream   stream;
+    TA::CborPrinter     printer(stream);
+
+    printer.openDoc();
+    printer.openArray(5);
+    printer.addValue(24);
+    printer.addValue(1000);
+    printer.addValue(1000000);
+    printer.addValue(1000000000000LL);
+    printer.addValue(-100);
+    printer.closeArray();
+    printer.closeDoc();
+
+    std::string expected("\x85"
+                         "\x18\x18"
+                         "\x19\x03\xE8"
+                         "\x1A\x00\x0F\x42\x40"
+                         "\x1B\x00\x00\x00\xE8\xD4\xA5\x10\x00"
+                         "\x38\x63", 22);
+    EXPECT_EQ(expected, stream.str());
+}
+TEST(CborPrinterTest, FloatBoolNull)
+{
+    std::stringstream   stream;
+    TA::CborPrinter     printer(stream);
+
+    printer.openDoc();
+    printer.openArray(5);
+    printer.addValue(1.5f);
+    printer.addValue(1.1);
+    printer.addValue(true);
+    printer.addValue(false);
+    printer.addNull();
+    printer.closeArray();
+    printer.closeDoc();
+
+    std::string expected("\x85"
+                         "\xFA\x3F\xC0\x00\x00"
+                         "\xFB\x3F\xF1\x99\x99\x99\x99\x99\x9A"
+                         "\xF5"
+                         "\xF4"
+                         "\xF6", 18);
+    EXPECT_EQ(expected, stream.str());
+}
+TEST(CborPrinterTest, MapWithKeys)
+{
+    std::stringstream   stream;
+    TA::CborPrinter     printer(stream);
+
+    printer.openDoc();
+    printer.openMap();
+    printer.addKey("a");
+    printer.addValue(1);
+    printer.addKey(TA::PrinterInterface::MemberKey{"b", "\"b\": "});
+    printer.addValue(std::string("xy"));
+    printer.closeMap();
+    printer.closeDoc();
+
+    std::string expected("\xBF" "\x61" "a" "\x01" "\x61" "b" "\x62" "xy" "\xFF", 10);
+    EXPECT_EQ(expected, stream.str());
+}
+TEST(CborPrinterTest, ArrayOfUnknownSize)
+{
+    std::stringstream   stream;
+    TA::CborPrinter     printer(stream);
+
+    printer.openDoc();
+    printer.openArray(-1);
+    printer.addValue(1);
+    printer.addValue(2);
+    printer.closeArray();
+    printer.closeDoc();
+
+    EXPECT_EQ(std::string("\x9F\x01\x02\xFF", 4), stream.str());
+}
+TEST(CborPrinterTest, ArraySizeMismatch)
+{
+    std::stringstream   stream;
+    TA::CborPrinter     printer(stream);
+
+    printer.openDoc();
+    printer.openArray(2);
+    printer.addValue(1);
+    EXPECT_THROW(
+        printer.closeArray(),
+        std::runtime_error
+    );
+}
+TEST(CborPrinterTest, KeyInArray)
+{
+    std::stringstream   stream;
+    TA::CborPrinter     printer(stream);
+
+    printer.openDoc();
+    printer.openArray(1);
+    EXPECT_THROW(
+        printer.addKey("K1"),
+        std::runtime_error
+    );
+}
+TEST(CborPrinterTest, CloseMapWithArray)
+{
+    std::stringstream   stream;
+    TA::CborPrinter     printer(stream);
+
+    printer.openDoc();
+    printer.openArray(0);
+    EXPECT_THROW(
+        printer.closeMap(),
+        std::runtime_error
+    );
+}
@@ -0,0 +1,173 @@
+#include "gtest/gtest.h"
+#include "Serialize.h"
+#include "Serialize.tpp"
+#include "SerUtil.h"
+#include "JsonThor.h"
+#include "BsonThor.h"
+#include "Columnar.h"
+#include <sstream>
+#include <vector>
+#include <deque>
+
+namespace ColumnarTest
+{
+struct Trade
+{
+    double      price;
+    int         qty;
+    std::string symbol;
+};
+struct Base
+{
+    int         id;
+};
+struct Tagged: public Base
+{
+    std::vector<int>    tags;
+};
+}
+ThorsAnvil_MakeTrait(ColumnarTest::Trade, price, qty, symbol);
+ThorsAnvil_MakeTrait(ColumnarTest::Base, id);
+ThorsAnvil_ExpandTrait(ColumnarTest::Base, ColumnarTest::Tagged, tags);
+
+using namespace ThorsAnvil::Serialize;
+
+TEST(ColumnarTest, ExportColumns)
+{
+    std::vector<ColumnarTest::Trade>    data{{1.5, 2, "AB"}, {3.25, 7, "CD"}};
+
+    std::stringstream   stream;
+    stream << jsonExport(columnar(data), PrinterInterface::OutputType::Stream);
+
+    EXPECT_EQ(R"({"price":[1.5,3.25],"qty":[2,7],"symbol":["AB","CD"]})", stream.str());
+}
+
+TEST(ColumnarTest, ImportColumns)
+{
+    std::stringstream                   stream(R"({"qty": [2, 7], "symbol": ["AB", "CD"], "price": [1.5, 3.25]})");
+    std::vector<ColumnarTest::Trade>    data;
+    auto                                columns = columnar(data);
+
+    stream >> jsonImport(columns);
+
+    ASSERT_EQ(2, data.size());
+    EXPECT_EQ(1.5,  data[0].price);
+    EXPECT_EQ(2,    data[0].qty);
+    EXPECT_EQ("AB", data[0].symbol);
+    EXPECT_EQ(3.25, data[1].price);
+    EXPECT_EQ(7,    data[1].qty);
+    EXPECT_EQ("CD", data[1].symbol);
+}
+
+TEST(ColumnarTest, ImportAppendsAndIgnoresUnknownColumns)
+{
+    std::stringstream                   stream(R"({"price": [4.5], "extra": [1, 2, 3], "qty": [9, 10]})");
+    std::deque<ColumnarTest::Trade>     data{{1.5, 2, "AB"}};
+    auto                                columns = columnar(data);
+
+    stream >> jsonImport(columns);
+
+    ASSERT_EQ(3, data.size());
+    EXPECT_EQ(1.5,  data[0].price);
+    EXPECT_EQ(4.5,  data[1].price);
+    EXPECT_EQ(9,    data[1].qty);
+    EXPECT_EQ(0,    data[2].price);
+    EXPECT_EQ(10,   data[2].qty);
+}
+
+TEST(ColumnarTest, ImportStrictRejectsUnknownColumns)
+{
+    std::stringstream                   stream(R"({"price": [4.5], "extra": [1]})");
+    std::vector<ColumnarTest::Trade>    data;
+    auto                                columns = columnar(data);
+
+    EXPECT_THROW(
+        stream >> jsonImport(columns, ParserInterface::ParseType::Strict),
+        std::runtime_error
+    );
+}
+
+TEST(ColumnarTest, ImportRequiresArrayColumn)
+{
+    std::stringstream                   stream(R"({"price": 4.5})");
+    std::vector<ColumnarTest::Trade>    data;
+    auto                                columns = columnar(data);
+
+    EXPECT_THROW(
+        stream >> jsonImport(columns),
+        std::runtime_error
+    );
+}
+
+TEST(ColumnarTest, TryImportRequiresArrayColumn)
+{
+    std::stringstream                   stream(R"({"price": 4.5})");
+    std::vector<ColumnarTest::Trade>    data;
+    auto                                columns = columnar(data);
+
+    ParserInterface::ParseResult result = jsonTryImport(stream, columns);
+    EXPECT_EQ(ParserInterface::ErrorCode::UnexpectedToken, result.code);
+}
+
+TEST(ColumnarTest, TryImportTruncatedColumn)
+{
+    std::stringstream                   stream(R"({"price": [1, 2, )");
+    std::vector<ColumnarTest::Trade>    data;
+    auto                                columns = columnar(data);
+
+    ParserInterface::ParseResult result = jsonTryImport(stream, columns);
+    EXPECT_FALSE(static_cast<bool>(result));
+    EXPECT_EQ(2, data.size());
+}
+
+TEST(ColumnarTest, ImportColumnMaxElements)
+{
+    std::stringstream                   stream(R"({"price": [1, 2, 3, 4]})");
+    std::vector<ColumnarTest::Trade>    data;
+    auto                                columns = columnar(data);
+
+    ParserInterface::ParserConfig       config;
+    config.maxElements = 3;
+    ParserInterface::ParseResult result = jsonTryImport(stream, columns, config);
+    EXPECT_EQ(ParserInterface::ErrorCode::LimitExceeded, result.code);
+    EXPECT_EQ(3, data.size());
+}
+
+TEST(ColumnarTest, ParentMembersAreColumns)
+{
+    std::vector<ColumnarTest::Tagged>   data(2);
+    data[0].id  = 1;
+    data[0].tags= {1, 2};
+    data[1].id  = 2;
+
+    std::stringstream   stream;
+    stream << jsonExport(columnar(data), PrinterInterface::OutputType::Stream);
+    EXPECT_EQ(R"({"id":[1,2],"tags":[[1,2],[]]})", stream.str());
+
+    std::vector<ColumnarTest::Tagged>   result;
+    auto                                columns = columnar(result);
+    stream >> jsonImport(columns);
+
+    ASSERT_EQ(2, result.size());
+    EXPECT_EQ(1, result[0].id);
+    EXPECT_EQ(std::vector<int>({1, 2}), result[0].tags);
+    EXPECT_EQ(2, result[1].id);
+    EXPECT_TRUE(result[1].tags.empty());
+}
+
+TEST(ColumnarTest, BsonRoundTrip)
+{
+    std::vector<ColumnarTest::Trade> const  data{{1.5, 2, "AB"}, {3.25, 7, "CD"}};
+
+    std::stringstream   stream;
+    stream << bsonExport(columnar(data));
+
+    std::vector<ColumnarTest::Trade>    result;
+    auto                                columns = columnar(result);
+    stream >> bsonImport(columns);
+
+    ASSERT_EQ(2, result.size());
+    EXPECT_EQ(3.25, result[1].price);
+    EXPECT_EQ(7,    result[1].qty);
+    EXPECT_EQ("CD", result[1].symbol);
+}
@@ -0,0 +1,107 @@
+#include "gtest/gtest.h"
+#include "Serialize.h"
+#include "Serialize.tpp"
+#include "JsonThor.h"
+#include <charconv>
+#include <sstream>
+
+namespace CustomCharsTest
+{
+struct ID
+{
+    int id;
+};
+char* idToChars(char* first, char* last, ID const& value)
+{
+    std::to_chars_result result = std::to_chars(first, last, value.id);
+    return result.ec == std::errc() ? result.ptr : nullptr;
+}
+bool idFromChars(std::string_view text, ID& value)
+{
+    std::from_chars_result result = std::from_chars(text.data(), text.data() + text.size(), value.id);
+    return result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+// Generates a value larger than the local buffer used by the printer.
+struct Long
+{
+    std::size_t size;
+};
+char* longToChars(char* first, char* last, Long const& value)
+{
+    if (static_cast<std::size_t>(last - first) < value.size + 2)
+    {
+        return nullptr;
+    }
+    *first++ = '"';
+    first = std::fill_n(first, value.size, 'x');
+    *first++ = '"';
+    return first;
+}
+bool longFromChars(std::string_view text, Long& value)
+{
+    value.size = text.size();
+    return true;
+}
+
+struct Holder
+{
+    ID      id;
+    int     value;
+};
+}
+
+ThorsAnvil_MakeTraitCustomChars(CustomCharsTest::ID, CustomCharsTest::idToChars, CustomCharsTest::idFromChars);
+ThorsAnvil_MakeTraitCustomChars(CustomCharsTest::Long, CustomCharsTest::longToChars, CustomCharsTest::longFromChars);
+ThorsAnvil_MakeTrait(CustomCharsTest::Holder, id, value);
+
+using ThorsAnvil::Serialize::jsonExport;
+using ThorsAnvil::Serialize::jsonImport;
+using ThorsAnvil::Serialize::PrinterInterface;
+
+TEST(CustomCharsTest, PrintValue)
+{
+    CustomCharsTest::ID     id{1234};
+    std::stringstream       stream;
+    stream << jsonExport(id, PrinterInterface::OutputType::Stream);
+
+    EXPECT_EQ("1234", stream.str());
+}
+TEST(CustomCharsTest, ParseValue)
+{
+    CustomCharsTest::ID     id{0};
+    std::stringstream       stream("5678");
+    stream >> jsonImport(id);
+
+    EXPECT_EQ(5678, id.id);
+}
+TEST(CustomCharsTest, RoundTripMember)
+{
+    CustomCharsTest::Holder holder{{42}, 7};
+    std::stringstream       stream;
+    stream << jsonExport(holder, PrinterInterface::OutputType::Stream);
+    EXPECT_EQ(R"({"id":42,"value":7})", stream.str());
+
+    CustomCharsTest::Holder result{{0}, 0};
+    stream >> jsonImport(result);
+    EXPECT_EQ(42, result.id.id);
+    EXPECT_EQ(7, result.value);
+}
+TEST(CustomCharsTest, ParseInvalidValue)
+{
+    CustomCharsTest::ID     id{0};
+    std::stringstream       stream(R"("Bad")");
+
+    EXPECT_THROW(
+        stream >> jsonImport(id),
+        std::runtime_error
+    );
+}
+TEST(CustomCharsTest, PrintValueLargerThanLocalBuffer)
+{
+    CustomCharsTest::Long   value{1000};
+    std::stringstream       stream;
+    stream << jsonExport(value, PrinterInterface::OutputType::Stream);
+
+    EXPECT_EQ("\"" + std::string(1000, 'x') + "\"", stream.str());
+}
@@ -0,0 +1,254 @@
+
+#include "gtest/gtest.h"
+#include "Serialize.h"
+#include "Serialize.tpp"
+#include "SerUtil.h"
+#include "JsonThor.h"
+#include "DeSerializePlan.h"
+#include <sstream>
+#include <vector>
+#include <list>
+#include <map>
+
+namespace DeSerializePlanTest
+{
+enum class Colour {Red, Green, Blue};
+struct Position
+{
+    int     x;
+    int     y;
+};
+struct Shape
+{
+    std::string             name;
+    Position                origin;
+    std::vector<Position>   points;
+    Colour                  colour;
+};
+struct Circle: public Shape
+{
+    double                  radius;
+    std::list<int>          tags;
+    std::map<std::string, int>  attributes;
+    Position*               centre  = nullptr;
+    ~Circle() {delete centre;}
+};
+struct Node
+{
+    int                     value;
+    std::vector<Node>       children;
+};
+struct Palette
+{
+    std::vector<Colour>     c;
+};
+struct VirtualShape: public virtual Position
+{
+    std::string             name;
+};
+struct NoDefault
+{
+    NoDefault(int x): x(x), y(0) {}
+    int                     x;
+    int                     y;
+};
+struct HoldsVirtual
+{
+    int                     id;
+    VirtualShape            shape;
+};
+}
+
+ThorsAnvil_MakeEnum(DeSerializePlanTest::Colour, Red, Green, Blue);
+ThorsAnvil_MakeTrait(DeSerializePlanTest::Position, x, y);
+ThorsAnvil_MakeTrait(DeSerializePlanTest::Shape, name, origin, points, colour);
+ThorsAnvil_ExpandTrait(DeSerializePlanTest::Shape, DeSerializePlanTest::Circle, radius, tags, attributes, centre);
+ThorsAnvil_MakeTrait(DeSerializePlanTest::Node, value, children);
+ThorsAnvil_MakeTrait(DeSerializePlanTest::Palette, c);
+ThorsAnvil_ExpandTrait(DeSerializePlanTest::Position, DeSerializePlanTest::VirtualShape, name);
+ThorsAnvil_MakeTrait(DeSerializePlanTest::NoDefault, x, y);
+ThorsAnvil_MakeTrait(DeSerializePlanTest::HoldsVirtual, id, shape);
+
+using namespace ThorsAnvil::Serialize;
+
+TEST(DeSerializePlanTest, ReadSimpleObject)
+{
+    std::stringstream               stream(R"({"y": 12, "x": 5})");
+    DeSerializePlanTest::Position   position{0, 0};
+
+    stream >> PlanImport<Json>(position);
+
+    EXPECT_EQ(5,  position.x);
+    EXPECT_EQ(12, position.y);
+}
+
+TEST(DeSerializePlanTest, ReadObjectWithParentAndContainers)
+{
+    std::stringstream           stream(R"({"name": "Ring", "origin": {"x": 1, "y": 2}, "points": [{"x": 3, "y": 4}, {"x": 5, "y": 6}],
+                                           "colour": "Blue", "radius": 12.5, "tags": [7, 8, 9], "attributes": {"Plop": 3},
+                                           "centre": {"x": 10, "y": 11}})");
+    DeSerializePlanTest::Circle circle;
+
+    stream >> PlanImport<Json>(circle);
+
+    EXPECT_EQ("Ring", circle.name);
+    EXPECT_EQ(1,  circle.origin.x);
+    EXPECT_EQ(2,  circle.origin.y);
+    ASSERT_EQ(2,  circle.points.size());
+    EXPECT_EQ(3,  circle.points[0].x);
+    EXPECT_EQ(6,  circle.points[1].y);
+    EXPECT_EQ(DeSerializePlanTest::Colour::Blue, circle.colour);
+    EXPECT_EQ(12.5, circle.radius);
+    EXPECT_EQ((std::list<int>{7, 8, 9}), circle.tags);
+    EXPECT_EQ(3,  circle.attributes["Plop"]);
+    ASSERT_NE(nullptr, circle.centre);
+    EXPECT_EQ(10, circle.centre->x);
+    EXPECT_EQ(11, circle.centre->y);
+}
+
+TEST(DeSerializePlanTest, MatchesDeSerializer)
+{
+    std::string const   input = R"({"name": "Square", "origin": {"x": -1, "y": -2}, "points": [{"x": 1, "y": 1}], "colour": "Green", "radius": 0.5, "tags": [], "attributes": {}, "centre": null})";
+
+    DeSerializePlanTest::Circle fromPlan;
+    std::stringstream           planStream(input);
+    planStream >> PlanImport<Json>(fromPlan);
+
+    DeSerializePlanTest::Circle fromDeSerializer;
+    std::stringstream           deSerializerStream(input);
+    deSerializerStream >> jsonImport(fromDeSerializer);
+
+    std::stringstream   planOutput;
+    planOutput << jsonExport(fromPlan);
+    std::stringstream   deSerializerOutput;
+    deSerializerOutput << jsonExport(fromDeSerializer);
+
+    EXPECT_EQ(deSerializerOutput.str(), planOutput.str());
+}
+
+TEST(DeSerializePlanTest, RecursiveType)
+{
+    std::stringstream           stream(R"({"value": 1, "children": [{"value": 2, "children": []}, {"value": 3, "children": [{"value": 4, "children": []}]}]})");
+    DeSerializePlanTest::Node   node;
+
+    stream >> PlanImport<Json>(node);
+
+    EXPECT_EQ(1, node.value);
+    ASSERT_EQ(2, node.children.size());
+    EXPECT_EQ(2, node.children[0].value);
+    EXPECT_EQ(3, node.children[1].value);
+    ASSERT_EQ(1, node.children[1].children.size());
+    EXPECT_EQ(4, node.children[1].children[0].value);
+}
+
+TEST(DeSerializePlanTest, UnknownKeyIgnoredInWeakMode)
+{
+    std::stringstream               stream(R"({"x": 5, "z": [1, {"a": 2}], "y": 6})");
+    DeSerializePlanTest::Position   position{0, 0};
+
+    stream >> PlanImport<Json>(position);
+
+    EXPECT_EQ(5, position.x);
+    EXPECT_EQ(6, position.y);
+}
+
+TEST(DeSerializePlanTest, UnknownKeyFailsInStrictMode)
+{
+    std::stringstream               stream(R"({"x": 5, "z": 7, "y": 6})");
+    DeSerializePlanTest::Position   position{0, 0};
+
+    EXPECT_THROW(
+        stream >> PlanImport<Json>(position, ParserInterface::ParseType::Strict),
+        std::runtime_error
+    );
+}
+
+TEST(DeSerializePlanTest, MissingKeyFailsInExactMode)
+{
+    std::stringstream               stream(R"({"x": 5})");
+    DeSerializePlanTest::Position   position{0, 0};
+
+    EXPECT_THROW(
+        stream >> PlanImport<Json>(position, ParserInterface::ParseType::Exact),
+        std::runtime_error
+    );
+}
+
+TEST(DeSerializePlanTest, MissingKeyRecordedInExactMode)
+{
+    std::stringstream               stream(R"({"x": 5})");
+    DeSerializePlanTest::Position   position{0, 0};
+    ParserInterface::ParserConfig   config(ParserInterface::ParseType::Exact);
+    config.throwOnError = false;
+
+    EXPECT_NO_THROW(
+        stream >> PlanImport<Json>(position, config)
+    );
+    EXPECT_TRUE(stream.fail());
+    EXPECT_EQ(5, position.x);
+}
+
+TEST(DeSerializePlanTest, BadValueMarksStreamAsFailed)
+{
+    std::stringstream               stream(R"({"x": [5], "y": 6})");
+    DeSerializePlanTest::Position   position{0, 0};
+
+    bool ok = static_cast<bool>(stream >> PlanImport<Json>(position, ParserInterface::ParseType::Weak, true));
+
+    EXPECT_FALSE(ok);
+}
+
+TEST(DeSerializePlanTest, ErrorInGenericElementStopsArray)
+{
+    std::stringstream               stream(R"({"c": ["Red", "Bogus", "Green"]})");
+    DeSerializePlanTest::Palette    palette;
+    ParserInterface::ParserConfig   config;
+    config.throwOnError = false;
+
+    EXPECT_NO_THROW(
+        stream >> PlanImport<Json>(palette, config)
+    );
+    EXPECT_TRUE(stream.fail());
+    EXPECT_LE(palette.c.size(), std::size_t{2});
+}
+
+TEST(DeSerializePlanTest, ErrorInValueIsRecorded)
+{
+    std::stringstream               stream(R"({"x": 5, "y": @})");
+    DeSerializePlanTest::Position   position{0, 0};
+    ParserInterface::ParserConfig   config;
+    config.throwOnError = false;
+
+    EXPECT_NO_THROW(
+        stream >> PlanImport<Json>(position, config)
+    );
+    EXPECT_TRUE(stream.fail());
+    EXPECT_EQ(5, position.x);
+}
+
+TEST(DeSerializePlanTest, VirtualBaseIsGeneric)
+{
+    static_assert(IsVirtualBase<DeSerializePlanTest::VirtualShape, DeSerializePlanTest::Position>::value, "Expected a virtual base");
+    static_assert(!IsVirtualBase<DeSerializePlanTest::Circle, DeSerializePlanTest::Shape>::value, "Expected a normal base");
+
+    std::stringstream                   stream(R"({"id": 3, "shape": {"name": "Box", "x": 4, "y": 5}})");
+    DeSerializePlanTest::HoldsVirtual   value{};
+
+    stream >> PlanImport<Json>(value);
+
+    EXPECT_EQ(3, value.id);
+    EXPECT_EQ("Box", value.shape.name);
+    EXPECT_EQ(4, value.shape.x);
+    EXPECT_EQ(5, value.shape.y);
+}
+
+TEST(DeSerializePlanTest, NoDefaultConstructorIsGeneric)
+{
+    std::stringstream               stream(R"({"y": 12, "x": 5})");
+    DeSerializePlanTest::NoDefault  value(0);
+
+    stream >> PlanImport<Json>(value);
+
+    EXPECT_EQ(5,  value.x);
+    EXPECT_EQ(12, value.y);
+}
@@ -0,0 +1,189 @@
+#include "gtest/gtest.h"
+#include "Serialize.h"
+#include "Serialize.tpp"
+#include "SerUtil.h"
+#include "JsonThor.h"
+#include <sstream>
+#include <vector>
+#include <string>
+
+namespace ErrorCodeTest
+{
+enum class Colour {Red, Green, Blue};
+struct Record
+{
+    int                 x;
+    double              y;
+    std::string         name;
+    std::vector<int>    data;
+    Colour              colour;
+};
+}
+
+ThorsAnvil_MakeEnum(ErrorCodeTest::Colour, Red, Green, Blue);
+ThorsAnvil_MakeTrait(ErrorCodeTest::Record, x, y, name, data, colour);
+
+using ThorsAnvil::Serialize::jsonImport;
+using ThorsAnvil::Serialize::jsonTryImport;
+using ThorsAnvil::Serialize::ParserInterface;
+using ErrorCode = ParserInterface::ErrorCode;
+
+TEST(ErrorCodeTest, ValidDocument)
+{
+    std::stringstream       stream(R"({"x": 1, "y": 2.5, "name": "Loki", "data": [1, 2], "colour": "Blue"})");
+    ErrorCodeTest::Record   record{};
+
+    ParserInterface::ParseResult result = jsonTryImport(stream, record);
+    EXPECT_TRUE(static_cast<bool>(result));
+    EXPECT_EQ(ErrorCode::None, result.code);
+    EXPECT_EQ(1, record.x);
+    EXPECT_EQ(2.5, record.y);
+    EXPECT_EQ("Loki", record.name);
+    EXPECT_EQ((std::vector<int>{1, 2}), record.data);
+    EXPECT_EQ(ErrorCodeTest::Colour::Blue, record.colour);
+}
+TEST(ErrorCodeTest, InvalidCharacter)
+{
+    std::string             text(R"({"x": 1, "y": @, "name": "Loki"})");
+    std::stringstream       stream(text);
+    ErrorCodeTest::Record   record{};
+
+    ParserInterface::ParseResult result = jsonTryImport(stream, record);
+    EXPECT_FALSE(static_cast<bool>(result));
+    EXPECT_EQ(ErrorCode::InvalidCharacter, result.code);
+    EXPECT_EQ(text.find('@') + 1, result.offset);
+    EXPECT_TRUE(stream.fail());
+}
+TEST(ErrorCodeTest, UnexpectedToken)
+{
+    std::stringstream       stream(R"([1, 2])");
+    ErrorCodeTest::Record   record{};
+
+    ParserInterface::ParseResult result = jsonTryImport(stream, record);
+    EXPECT_EQ(ErrorCode::UnexpectedToken, result.code);
+    EXPECT_EQ(std::size_t{1}, result.offset);
+}
+TEST(ErrorCodeTest, InvalidValue)
+{
+    std::stringstream       stream(R"({"x": 1.5, "y": 2})");
+    ErrorCodeTest::Record   record{};
+
+    EXPECT_EQ(ErrorCode::InvalidValue, jsonTryImport(stream, record).code);
+}
+TEST(ErrorCodeTest, InvalidEnumValue)
+{
+    std::stringstream       stream(R"({"colour": "Pink"})");
+    ErrorCodeTest::Record   record{};
+
+    EXPECT_EQ(ErrorCode::InvalidValue, jsonTryImport(stream, record).code);
+}
+TEST(ErrorCodeTest, InvalidString)
+{
+    std::stringstream       stream(R"({"name": "Lo\qki"})");
+    ErrorCodeTest::Record   record{};
+
+    EXPECT_EQ(ErrorCode::InvalidString, jsonTryImport(stream, record).code);
+}
+TEST(ErrorCodeTest, UnknownKeyInStrictMode)
+{
+    std::stringstream       stream(R"({"x": 1, "z": 2})");
+    ErrorCodeTest::Record   record{};
+
+    EXPECT_EQ(ErrorCode::UnknownKey, jsonTryImport(stream, record, ParserInterface::ParseType::Strict).code);
+}
+TEST(ErrorCodeTest, FirstErrorIsKept)
+{
+    std::string             text(R"({"x": "one", "data": [1, true, 3], "y": })");
+    std::stringstream       stream(text);
+    ErrorCodeTest::Record   record{};
+
+    ParserInterface::ParseResult result = jsonTryImport(stream, record);
+    EXPECT_EQ(ErrorCode::InvalidValue, result.code);
+    EXPECT_EQ(text.find("\"one"), result.offset);
+}
+TEST(ErrorCodeTest, TruncatedDocument)
+{
+    std::stringstream       stream(R"({"x": 1, "data": [1, 2)");
+    ErrorCodeTest::Record   record{};
+
+    EXPECT_FALSE(static_cast<bool>(jsonTryImport(stream, record)));
+}
+TEST(ErrorCodeTest, MissingMemberInExactMode)
+{
+    std::stringstream       stream(R"({"x": 1})");
+    ErrorCodeTest::Record   record{};
+
+    EXPECT_EQ(ErrorCode::MissingMember, jsonTryImport(stream, record, ParserInterface::ParseType::Exact).code);
+}
+TEST(ErrorCodeTest, MissingMemberThrowsWithName)
+{
+    std::stringstream       stream(R"({"x": 1, "y": 2.5, "name": "Loki", "data": []})");
+    ErrorCodeTest::Record   record{};
+
+    try
+    {
+        stream >> jsonImport(record, ParserInterface::ParseType::Exact);
+        FAIL() << "Expected std::runtime_error";
+    }
+    catch (std::runtime_error const& e)
+    {
+        EXPECT_NE(std::string::npos, std::string(e.what()).find("colour"));
+    }
+}
+TEST(ErrorCodeTest, ImporterSetsFailBit)
+{
+    std::stringstream       stream(R"({"x": 1, "y": @})");
+    ErrorCodeTest::Record   record{};
+    ParserInterface::ParserConfig   config;
+    config.throwOnError = false;
+
+    EXPECT_NO_THROW(
+        stream >> jsonImport(record, config)
+    );
+    EXPECT_TRUE(stream.fail());
+}
+TEST(ErrorCodeTest, ImporterThrowsByDefault)
+{
+    std::stringstream       stream(R"({"x": 1, "y": @})");
+    ErrorCodeTest::Record   record{};
+
+    EXPECT_THROW(
+        stream >> jsonImport(record),
+        std::runtime_error
+    );
+}
+TEST(ErrorCodeTest, InSituOffset)
+{
+    std::string             text(R"({"x": 1, "name": "Lo\qki"})");
+    ErrorCodeTest::Record   record{};
+    ParserInterface::ParserConfig   config;
+    config.throwOnError = false;
+
+    ThorsAnvil::Serialize::JsonInSituParser     parser(&text[0], text.size(), config);
+    {
+        ThorsAnvil::Serialize::DeSerializer     deSerializer(parser);
+        deSerializer.parse(record);
+    }
+    EXPECT_EQ(ErrorCode::InvalidString, parser.error.code);
+    EXPECT_EQ(text.find('k') + 3, parser.error.offset);
+}
+TEST(ErrorCodeTest, InSituReturnsError)
+{
+    std::string             text(R"({"x": 1, "name": "Lo\qki"})");
+    ErrorCodeTest::Record   record{};
+    ParserInterface::ParserConfig   config;
+    config.throwOnError = false;
+
+    ParserInterface::ParseResult result = ThorsAnvil::Serialize::jsonImportInSitu(&text[0], text.size(), record, config);
+    EXPECT_FALSE(static_cast<bool>(result));
+    EXPECT_EQ(ErrorCode::InvalidString, result.code);
+    EXPECT_EQ(text.find('k') + 3, result.offset);
+}
+TEST(ErrorCodeTest, InSituReturnsNoError)
+{
+    std::string             text(R"({"x": 1, "name": "Loki"})");
+    ErrorCodeTest::Record   record{};
+
+    EXPECT_TRUE(static_cast<bool>(ThorsAnvil::Serialize::jsonImportInSitu(&text[0], text.size(), record)));
+    EXPECT_EQ("Loki", record.name);
+}
@@ -0,0 +1,102 @@
+#include "gtest/gtest.h"
+#include "Serialize.h"
+#include "Serialize.tpp"
+#include "SerUtil.h"
+#include "JsonThor.h"
+#include <sstream>
+#include <string_view>
+#include <vector>
+
+namespace JsonInSituTest
+{
+struct Message
+{
+    std::string_view    user;
+    std::string         text;
+    int                 id;
+};
+struct Thread
+{
+    std::string_view        title;
+    std::vector<Message>    messages;
+};
+}
+
+ThorsAnvil_MakeTrait(JsonInSituTest::Message, user, text, id);
+ThorsAnvil_MakeTrait(JsonInSituTest::Thread, title, messages);
+
+using ThorsAnvil::Serialize::jsonImportInSitu;
+using ThorsAnvil::Serialize::jsonImport;
+using ThorsAnvil::Serialize::jsonExport;
+using ThorsAnvil::Serialize::PrinterInterface;
+
+TEST(JsonInSituTest, ViewRefersToBuffer)
+{
+    std::string                 input(R"({"user": "Loki", "text": "Hi", "id": 12})");
+    JsonInSituTest::Message     message{};
+    jsonImportInSitu(&input[0], input.size(), message);
+
+    EXPECT_EQ("Loki", message.user);
+    EXPECT_EQ("Hi", message.text);
+    EXPECT_EQ(12, message.id);
+    EXPECT_GE(message.user.data(), input.data());
+    EXPECT_LT(message.user.data(), input.data() + input.size());
+}
+TEST(JsonInSituTest, EscapesDecodedInPlace)
+{
+    std::string                 input(R"({"user": "Lo\"ki\\\n\u00e9", "text": "A\tB", "id": 1})");
+    JsonInSituTest::Message     message{};
+    jsonImportInSitu(&input[0], input.size(), message);
+
+    EXPECT_EQ("Lo\"ki\\\n\xC3\xA9", message.user);
+    EXPECT_EQ("A\tB", message.text);
+}
+TEST(JsonInSituTest, EscapedKey)
+{
+    std::string                 input(R"({"\u0075ser": "Loki", "id": 3})");
+    JsonInSituTest::Message     message{};
+    jsonImportInSitu(&input[0], input.size(), message);
+
+    EXPECT_EQ("Loki", message.user);
+    EXPECT_EQ(3, message.id);
+}
+TEST(JsonInSituTest, NestedContainers)
+{
+    std::string                 input(R"({"title": "Chat", "messages": [{"user": "A", "text": "One", "id": 1}, {"user": "B", "text": "Two", "id": 2}]})");
+    JsonInSituTest::Thread      thread{};
+    jsonImportInSitu(&input[0], input.size(), thread);
+
+    EXPECT_EQ("Chat", thread.title);
+    ASSERT_EQ(2, thread.messages.size());
+    EXPECT_EQ("A", thread.messages[0].user);
+    EXPECT_EQ("Two", thread.messages[1].text);
+    EXPECT_EQ(2, thread.messages[1].id);
+}
+TEST(JsonInSituTest, UnterminatedString)
+{
+    std::string                 input(R"({"user": "Loki)");
+    JsonInSituTest::Message     message{};
+
+    EXPECT_THROW(
+        jsonImportInSitu(&input[0], input.size(), message),
+        std::runtime_error
+    );
+}
+TEST(JsonInSituTest, ViewNeedsInSituParser)
+{
+    std::stringstream           stream(R"({"user": "Loki"})");
+    JsonInSituTest::Message     message{};
+
+    EXPECT_THROW(
+        stream >> jsonImport(message),
+        std::runtime_error
+    );
+}
+TEST(JsonInSituTest, PrintView)
+{
+    JsonInSituTest::Message     message{"Loki", "Hi", 4};
+    std::stringstream           stream;
+    stream << jsonExport(message, PrinterInterface::OutputType::Stream);
+
+    EXPECT_EQ(R"({"user":"Loki","text":"Hi","id":4})", stream.str());
+}
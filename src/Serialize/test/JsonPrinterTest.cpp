@@ -280,3 +280,36 @@ TEST(JsonPrinterTest, DoubleZeroNeedsDot)
     EXPECT_NE(std::string::npos, find);
 }
 
+TEST(JsonPrinterTest, PreQuotedKeyStream)
+{
+    std::stringstream                   stream;
+    ThorsAnvil::Serialize::JsonPrinter  printer(stream, ThorsAnvil::Serialize::PrinterInterface::OutputType::Stream);
+
+    printer.openDoc();
+    printer.openMap();
+    printer.addKey(ThorsAnvil::Serialize::PrinterInterface::MemberKey{"K1", "\"K1\": "});
+    printer.addValue(12);
+    printer.addKey(ThorsAnvil::Serialize::PrinterInterface::MemberKey{"K2", "\"K2\": "});
+    printer.addValue(13);
+    printer.closeMap();
+    printer.closeDoc();
+
+    EXPECT_EQ(stream.str(), R"({"K1":12,"K2":13})");
+}
+TEST(JsonPrinterTest, PreQuotedKeyConfig)
+{
+    std::stringstream                   stream;
+    ThorsAnvil::Serialize::JsonPrinter  printer(stream, ThorsAnvil::Serialize::PrinterInterface::OutputType::Config);
+
+    printer.openDoc();
+    printer.openMap();
+    printer.addKey(ThorsAnvil::Serialize::PrinterInterface::MemberKey{"K1", "\"K1\": "});
+    printer.addValue(12);
+    printer.closeMap();
+    printer.closeDoc();
+
+    std::string     result  = stream.str();
+    result.erase(std::remove_if(std::begin(result), std::end(result), [](char x){return ::isspace(x);}), std::end(result));
+    EXPECT_EQ(result, R"({"K1":12})");
+    EXPECT_NE(std::string::npos, stream.str().find(R"("K1": 12)"));
+}
@@ -0,0 +1,97 @@
+#include "gtest/gtest.h"
+#include "JsonStringDecoder.h"
+#include "JsonThor.h"
+#include "SerUtil.h"
+#include <sstream>
+
+using namespace ThorsAnvil::Serialize;
+
+namespace
+{
+std::string decode(std::string const& input)
+{
+    std::string     output;
+    decodeJsonString(input.data(), input.data() + input.size(), output);
+    return output;
+}
+}
+
+TEST(JsonStringDecoderTest, NormalCharacters)
+{
+    EXPECT_EQ("This is a normal string that should not change", decode("This is a normal string that should not change"));
+}
+TEST(JsonStringDecoderTest, AppendsToOutput)
+{
+    std::string     input("Plop");
+    std::string     output("Start:");
+    decodeJsonString(input.data(), input.data() + input.size(), output);
+    EXPECT_EQ("Start:Plop", output);
+}
+TEST(JsonStringDecoderTest, StandardEscape)
+{
+    EXPECT_EQ("\"\\/\b\f\n\r\t", decode(R"(\"\\\/\b\f\n\r\t)"));
+}
+TEST(JsonStringDecoderTest, EscapeBetweenRuns)
+{
+    EXPECT_EQ("Line 1\nLine 2\tTab \\", decode(R"(Line 1\nLine 2\tTab \\)"));
+}
+TEST(JsonStringDecoderTest, Unicode1Byte)
+{
+    EXPECT_EQ("oN", decode(R"(\u006f\u004E)"));
+}
+TEST(JsonStringDecoderTest, Unicode2Byte)
+{
+    EXPECT_EQ("\xC4\x82\xC4\x9D\xC4\xBD", decode(R"(\u0102\u011D\u013d)"));
+}
+TEST(JsonStringDecoderTest, Unicode3Byte)
+{
+    EXPECT_EQ("\xE0\xA5\xA7\xE0\xA6\x95\xE0\xA5\xBF", decode(R"(\u0967\u0995\u097f)"));
+}
+TEST(JsonStringDecoderTest, UnicodeSurrogatePairs)
+{
+    // 0xF0 0x93 0x80 0x80  (UTF-8) => 0x00013000 (UTF-32) => 0xD80C 0xDC00 (UTF-16)
+    EXPECT_EQ("\xF0\x93\x80\x80", decode(R"(\uD80C\uDC00)"));
+    EXPECT_EQ("A\xF4\x8F\xBF\xBFZ", decode(R"(A\uDBFF\uDFFFZ)"));
+}
+TEST(JsonStringDecoderTest, InvalidEscape)
+{
+    EXPECT_THROW(decode(R"(\k)"), std::runtime_error);
+    EXPECT_THROW(decode(R"(Ends with \)"), std::runtime_error);
+}
+TEST(JsonStringDecoderTest, InvalidHex)
+{
+    EXPECT_THROW(decode(R"(\u00G0)"), std::runtime_error);
+    EXPECT_THROW(decode(R"(\u00)"), std::runtime_error);
+}
+TEST(JsonStringDecoderTest, InvalidSurrogatePair)
+{
+    EXPECT_THROW(decode(R"(\uD80C)"), std::runtime_error);
+    EXPECT_THROW(decode(R"(\uD80Cx\uDC00)"), std::runtime_error);
+    EXPECT_THROW(decode(R"(\uD80C\u0041)"), std::runtime_error);
+}
+TEST(JsonStringDecoderTest, ControlCharacter)
+{
+    EXPECT_THROW(decode("Tab\tIn String"), std::runtime_error);
+}
+TEST(JsonStringDecoderTest, ParseEscapedQuotes)
+{
+    std::stringstream           stream(R"(["Quote \" inside", "Ends with \\", "\\\"", "Last"])");
+    std::vector<std::string>    data;
+    stream >> jsonImport(data);
+
+    ASSERT_EQ(4, data.size());
+    EXPECT_EQ("Quote \" inside", data[0]);
+    EXPECT_EQ("Ends with \\", data[1]);
+    EXPECT_EQ("\\\"", data[2]);
+    EXPECT_EQ("Last", data[3]);
+}
+TEST(JsonStringDecoderTest, ParseUnterminatedString)
+{
+    std::stringstream           stream(R"(["Not terminated)");
+    std::vector<std::string>    data;
+
+    EXPECT_THROW(
+        stream >> jsonImport(data),
+        std::runtime_error
+    );
+}
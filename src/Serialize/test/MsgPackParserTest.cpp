@@ -0,0 +1,98 @@
+#include "gtest/gtest.h"
+#include "Serialize.h"
+#include "Serialize.tpp"
+#include "SerUtil.h"
+#include "MsgPackThor.h"
+#include <sstream>
+
+namespace TA=ThorsAnvil::Serialize;
+using TA::ParserInterface;
+
+TEST(MsgPackParserTest, ArrayEmpty)
+{
+    std::stringstream   stream(std::string("\x90", 1));
+    TA::MsgPackParser   parser(stream);
+
+    EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayStart, parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayEnd,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::DocEnd,     parser.getToken());
+}
+TEST(MsgPackParserTest, MapWithArray)
+{
+    // {"a": [1, -2], "b": "xy"}
+    std::stringstream   stream(std::string("\x82" "\xA1" "a" "\x92\x01\xFE" "\xA1" "b" "\xA2" "xy", 11));
+    TA::MsgPackParser   parser(stream);
+
+    EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::MapStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::Key,        parser.getToken());
+    EXPECT_EQ("a", parser.getKey());
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayStart, parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser.getToken());
+    int value;
+    parser.getValue(value);
+    EXPECT_EQ(1, value);
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser.getToken());
+    parser.getValue(value);
+    EXPECT_EQ(-2, value);
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayEnd,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::Key,        parser.getToken());
+    EXPECT_EQ("b", parser.getKey());
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser.getToken());
+    EXPECT_EQ("xy", parser.getStringView());
+    EXPECT_EQ(ParserInterface::ParserToken::MapEnd,     parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::DocEnd,     parser.getToken());
+}
+TEST(MsgPackParserTest, UnusedStringIsSkipped)
+{
+    // ["abc", str8 "hello", 5]
+    std::stringstream   stream(std::string("\x93" "\xA3" "abc" "\xD9\x05" "hello" "\x05", 13));
+    TA::MsgPackParser   parser(stream);
+
+    EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayStart, parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser.getToken());
+    std::string text;
+    parser.getValue(text);
+    EXPECT_EQ("hello", text);
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser.getToken());
+    int value;
+    parser.getValue(value);
+    EXPECT_EQ(5, value);
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayEnd,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::DocEnd,     parser.getToken());
+}
+TEST(MsgPackParserTest, IntegerOutOfRange)
+{
+    std::stringstream   stream(std::string("\xCE\x00\x01\x00\x00", 5));
+    TA::MsgPackParser   parser(stream);
+
+    EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser.getToken());
+    int     value   = 0;
+    parser.getValue(value);
+    EXPECT_EQ(65536, value);
+    short   small   = 0;
+    EXPECT_THROW(
+        parser.getValue(small),
+        std::runtime_error
+    );
+    std::string text;
+    EXPECT_THROW(
+        parser.getValue(text),
+        std::runtime_error
+    );
+}
+TEST(MsgPackParserTest, InvalidTypeByte)
+{
+    std::stringstream   stream(std::string("\xC1", 1));
+    TA::MsgPackParser   parser(stream);
+
+    EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
+    EXPECT_THROW(
+        parser.getToken(),
+        std::runtime_error
+    );
+}
@@ -0,0 +1,132 @@
+#include "gtest/gtest.h"
+#include "MsgPackPrinter.h"
+#include <sstream>
+
+namespace TA=ThorsAnvil::Serialize;
+
+TEST(MsgPackPrinterTest, FixInt)
+{
+    std::stringstream   stream;
+    TA::MsgPackPrinter  printer(stream);
+
+    printer.openDoc();
+    printer.openArray(3);
+    printer.addValue(0);
+    printer.addValue(127);
+    printer.addValue(-32);
+    printer.closeArray();
+    printer.closeDoc();
+
+    EXPECT_EQ(std::string("\x93\x00\x7F\xE0", 4), stream.str());
+}
+TEST(MsgPackPrinterTest, IntegerSizes)
+{
+    std::stringstream   stream;
+    TA::MsgPackPrinter  printer(stream);
+
+    printer.openDoc();
+    printer.openArray(5);
+    printer.addValue(200);
+    printer.addValue(1000);
+    printer.addValue(100000);
+    printer.addValue(-100);
+    printer.addValue(-1000);
+    printer.closeArray();
+    printer.closeDoc();
+
+    std::string expected("\x95"
+                         "\xCC\xC8"
+                         "\xCD\x03\xE8"
+                         "\xCE\x00\x01\x86\xA0"
+                         "\xD0\x9C"
+                         "\xD1\xFC\x18", 16);
+    EXPECT_EQ(expected, stream.str());
+}
+TEST(MsgPackPrinterTest, FloatBoolNull)
+{
+    std::stringstream   stream;
+    TA::MsgPackPrinter  printer(stream);
+
+    printer.openDoc();
+    printer.openArray(4);
+    printer.addValue(1.5f);
+    printer.addValue(true);
+    printer.addValue(false);
+    printer.addNull();
+    printer.closeArray();
+    printer.closeDoc();
+
+    EXPECT_EQ(std::string("\x94" "\xCA\x3F\xC0\x00\x00" "\xC3" "\xC2" "\xC0", 9), stream.str());
+}
+TEST(MsgPackPrinterTest, FixMapHeaderInserted)
+{
+    std::stringstream   stream;
+    TA::MsgPackPrinter  printer(stream);
+
+    printer.openDoc();
+    printer.openMap();
+    printer.addKey("a");
+    printer.addValue(1);
+    printer.addKey(TA::PrinterInterface::MemberKey{"b", "\"b\": "});
+    printer.openMap();
+    printer.addKey("c");
+    printer.addValue(std::string("xy"));
+    printer.closeMap();
+    printer.closeMap();
+    printer.closeDoc();
+
+    std::string expected("\x82" "\xA1" "a" "\x01" "\xA1" "b" "\x81" "\xA1" "c" "\xA2" "xy", 12);
+    EXPECT_EQ(expected, stream.str());
+}
+TEST(MsgPackPrinterTest, LargeMapAndString)
+{
+    std::stringstream   stream;
+    TA::MsgPackPrinter  printer(stream);
+
+    printer.openDoc();
+    printer.openMap();
+    for (int loop = 0; loop < 16; ++loop)
+    {
+        printer.addKey(std::string(1, 'a' + loop));
+        printer.addValue(loop);
+    }
+    printer.closeMap();
+    printer.closeDoc();
+
+    std::string result = stream.str();
+    ASSERT_EQ(3 + 16 * 3, result.size());
+    EXPECT_EQ(std::string("\xDE\x00\x10", 3), result.substr(0, 3));
+
+    std::stringstream   stringStream;
+    TA::MsgPackPrinter  stringPrinter(stringStream);
+    stringPrinter.openDoc();
+    stringPrinter.addValue(std::string(40, 'x'));
+    stringPrinter.closeDoc();
+    EXPECT_EQ(std::string("\xD9\x28", 2), stringStream.str().substr(0, 2));
+    EXPECT_EQ(42, stringStream.str().size());
+}
+TEST(MsgPackPrinterTest, ArraySizeMismatch)
+{
+    std::stringstream   stream;
+    TA::MsgPackPrinter  printer(stream);
+
+    printer.openDoc();
+    printer.openArray(2);
+    printer.addValue(1);
+    EXPECT_THROW(
+        printer.closeArray(),
+        std::runtime_error
+    );
+}
+TEST(MsgPackPrinterTest, KeyInArray)
+{
+    std::stringstream   stream;
+    TA::MsgPackPrinter  printer(stream);
+
+    printer.openDoc();
+    printer.openArray(1);
+    EXPECT_THROW(
+        printer.addKey("K1"),
+        std::runtime_error
+    );
+}
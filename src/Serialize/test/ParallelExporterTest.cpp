@@ -0,0 +1,147 @@
+
+#include "gtest/gtest.h"
+#include "Serialize.h"
+#include "Serialize.tpp"
+#include "SerUtil.h"
+#include "JsonThor.h"
+#include "ParallelExporter.h"
+#include <sstream>
+#include <vector>
+#include <list>
+
+namespace ParallelExporterTest
+{
+struct Point
+{
+    int         x;
+    double      y;
+    std::string name;
+};
+}
+ThorsAnvil_MakeTrait(ParallelExporterTest::Point, x, y, name);
+
+using namespace ThorsAnvil::Serialize;
+
+TEST(ParallelExporterTest, VectorOfIntMatchesExport)
+{
+    std::vector<int>    data;
+    for (int loop = 0; loop < 1000; ++loop)
+    {
+        data.push_back(loop);
+    }
+
+    std::stringstream   expected;
+    expected << jsonExport(data);
+
+    std::stringstream   result;
+    result << ParallelExport<Json>(data, 7);
+
+    EXPECT_EQ(expected.str(), result.str());
+}
+
+TEST(ParallelExporterTest, VectorOfObjectMatchesExport)
+{
+    std::vector<ParallelExporterTest::Point>    data;
+    for (int loop = 0; loop < 100; ++loop)
+    {
+        data.push_back({loop, loop * 1.5, "Point-" + std::to_string(loop)});
+    }
+
+    std::stringstream   expected;
+    expected << jsonExport(data);
+
+    std::stringstream   result;
+    result << ParallelExport<Json>(data, 4);
+
+    EXPECT_EQ(expected.str(), result.str());
+}
+
+TEST(ParallelExporterTest, StreamModeMatchesExport)
+{
+    std::list<std::vector<int>>     data{{1, 2}, {3}, {}, {4, 5, 6}, {7}};
+
+    std::stringstream   expected;
+    expected << jsonExport(data, PrinterInterface::OutputType::Stream);
+
+    std::stringstream   result;
+    result << ParallelExport<Json>(data, 3, PrinterInterface::OutputType::Stream);
+
+    EXPECT_EQ(expected.str(), result.str());
+    EXPECT_EQ(R"([[1,2],[3],[],[4,5,6],[7]])", result.str());
+}
+
+TEST(ParallelExporterTest, MoreThreadsThanElements)
+{
+    std::vector<int>    data{1, 2};
+
+    std::stringstream   expected;
+    expected << jsonExport(data);
+
+    std::stringstream   result;
+    result << ParallelExport<Json>(data, 16);
+
+    EXPECT_EQ(expected.str(), result.str());
+}
+
+TEST(ParallelExporterTest, EmptyContainer)
+{
+    std::vector<int>    data;
+
+    std::stringstream   expected;
+    expected << jsonExport(data);
+
+    std::stringstream   result;
+    result << ParallelExport<Json>(data, 4);
+
+    EXPECT_EQ(expected.str(), result.str());
+}
+
+TEST(ParallelExporterTest, RoundTrip)
+{
+    std::vector<ParallelExporterTest::Point>    data;
+    for (int loop = 0; loop < 57; ++loop)
+    {
+        data.push_back({loop, loop * 0.5, "P" + std::to_string(loop)});
+    }
+
+    std::stringstream   stream;
+    stream << ParallelExport<Json>(data, 5);
+
+    std::vector<ParallelExporterTest::Point>    result;
+    stream >> jsonImport(result);
+
+    ASSERT_EQ(data.size(), result.size());
+    for (std::size_t loop = 0; loop < data.size(); ++loop)
+    {
+        EXPECT_EQ(data[loop].x,     result[loop].x);
+        EXPECT_EQ(data[loop].y,     result[loop].y);
+        EXPECT_EQ(data[loop].name,  result[loop].name);
+    }
+}
+
+TEST(ParallelExporterTest, StatsAreMergedFromEachChunk)
+{
+    std::vector<ParallelExporterTest::Point>    data;
+    for (int loop = 0; loop < 1000; ++loop)
+    {
+        data.push_back({loop, loop * 1.5, "Point-" + std::to_string(loop)});
+    }
+
+    SerializeStats                  expectedStats;
+    PrinterInterface::PrinterConfig expectedConfig;
+    expectedConfig.stats = &expectedStats;
+    std::stringstream               expected;
+    expected << jsonExport(data, expectedConfig);
+
+    SerializeStats                  stats;
+    PrinterInterface::PrinterConfig config;
+    config.stats = &stats;
+    std::stringstream               result;
+    result << ParallelExport<Json>(data, 8, config);
+
+    EXPECT_EQ(expected.str(), result.str());
+    auto find = stats.types.find(typeid(ParallelExporterTest::Point));
+    ASSERT_NE(find, stats.types.end());
+    EXPECT_EQ(expectedStats.types[typeid(ParallelExporterTest::Point)].count, find->second.count);
+    EXPECT_EQ(std::size_t{1000}, find->second.count);
+}
@@ -0,0 +1,235 @@
+#include "gtest/gtest.h"
+#include "Serialize.h"
+#include "Serialize.tpp"
+#include "SerUtil.h"
+#include "JsonThor.h"
+#include "MsgPackThor.h"
+#include "DeSerializePlan.h"
+#include <sstream>
+#include <vector>
+#include <map>
+#include <string>
+
+namespace ParserLimitsTest
+{
+struct Record
+{
+    int                             x;
+    std::string                     name;
+    std::vector<std::vector<int>>   data;
+};
+}
+
+ThorsAnvil_MakeTrait(ParserLimitsTest::Record, x, name, data);
+
+using ThorsAnvil::Serialize::jsonImport;
+using ThorsAnvil::Serialize::jsonTryImport;
+using ThorsAnvil::Serialize::ParserInterface;
+using ErrorCode = ParserInterface::ErrorCode;
+
+namespace
+{
+ParserInterface::ParserConfig limits()
+{
+    ParserInterface::ParserConfig   config;
+    config.maxDepth         = 3;
+    config.maxStringLength  = 8;
+    config.maxNumberLength  = 5;
+    config.maxElements      = 4;
+    return config;
+}
+}
+
+TEST(ParserLimitsTest, WithinLimits)
+{
+    std::stringstream           stream(R"({"x": 12345, "name": "12345678", "data": [[1, 2, 3, 4], []]})");
+    ParserLimitsTest::Record    record{};
+
+    EXPECT_TRUE(static_cast<bool>(jsonTryImport(stream, record, limits())));
+    EXPECT_EQ(12345, record.x);
+    EXPECT_EQ("12345678", record.name);
+    EXPECT_EQ(std::size_t{4}, record.data[0].size());
+}
+TEST(ParserLimitsTest, DepthExceeded)
+{
+    std::stringstream           stream(R"({"x": 1, "data": [[[1]]]})");
+    ParserLimitsTest::Record    record{};
+
+    EXPECT_EQ(ErrorCode::LimitExceeded, jsonTryImport(stream, record, limits()).code);
+}
+TEST(ParserLimitsTest, DepthOfIgnoredValueExceeded)
+{
+    std::stringstream           stream(R"({"x": 1, "unknown": [[[[[[1]]]]]]})");
+    ParserLimitsTest::Record    record{};
+
+    EXPECT_EQ(ErrorCode::LimitExceeded, jsonTryImport(stream, record, limits()).code);
+}
+TEST(ParserLimitsTest, DepthExceededThrows)
+{
+    std::stringstream           stream(R"({"x": 1, "data": [[[1]]]})");
+    ParserLimitsTest::Record    record{};
+
+    EXPECT_THROW(
+        stream >> jsonImport(record, limits()),
+        std::runtime_error
+    );
+}
+TEST(ParserLimitsTest, StringLengthExceeded)
+{
+    std::string                 text(R"({"name": "123456789", "x": 1})");
+    std::stringstream           stream(text);
+    ParserLimitsTest::Record    record{};
+
+    ParserInterface::ParseResult result = jsonTryImport(stream, record, limits());
+    EXPECT_EQ(ErrorCode::LimitExceeded, result.code);
+    // Reading stopped at the limit.
+    EXPECT_EQ(text.find('9') + 1, result.offset);
+}
+TEST(ParserLimitsTest, EscapedStringLengthExceeded)
+{
+    std::stringstream           stream(R"({"name": "1234\"5678", "x": 1})");
+    ParserLimitsTest::Record    record{};
+
+    EXPECT_EQ(ErrorCode::LimitExceeded, jsonTryImport(stream, record, limits()).code);
+}
+TEST(ParserLimitsTest, KeyLengthExceeded)
+{
+    std::stringstream           stream(R"({"averyverylongkey": 1})");
+    ParserLimitsTest::Record    record{};
+
+    EXPECT_EQ(ErrorCode::LimitExceeded, jsonTryImport(stream, record, limits()).code);
+}
+TEST(ParserLimitsTest, InSituStringLengthExceeded)
+{
+    std::string                 text(R"({"name": "123456789"})");
+    ParserLimitsTest::Record    record{};
+    ParserInterface::ParserConfig   config = limits();
+    config.throwOnError = false;
+
+    ThorsAnvil::Serialize::JsonInSituParser     parser(&text[0], text.size(), config);
+    {
+        ThorsAnvil::Serialize::DeSerializer     deSerializer(parser);
+        deSerializer.parse(record);
+    }
+    EXPECT_EQ(ErrorCode::LimitExceeded, parser.error.code);
+}
+TEST(ParserLimitsTest, NumberLengthExceeded)
+{
+    std::stringstream           stream(R"({"x": 123456})");
+    ParserLimitsTest::Record    record{};
+
+    EXPECT_EQ(ErrorCode::LimitExceeded, jsonTryImport(stream, record, limits()).code);
+}
+TEST(ParserLimitsTest, ArrayElementsExceeded)
+{
+    std::stringstream           stream(R"({"data": [[1, 2, 3, 4, 5]]})");
+    ParserLimitsTest::Record    record{};
+
+    EXPECT_EQ(ErrorCode::LimitExceeded, jsonTryImport(stream, record, limits()).code);
+}
+TEST(ParserLimitsTest, MapMembersExceeded)
+{
+    std::stringstream           stream(R"({"a": 1, "b": 2, "c": 3, "d": 4, "e": 5})");
+    std::map<std::string, int>  value;
+
+    EXPECT_EQ(ErrorCode::LimitExceeded, jsonTryImport(stream, value, limits()).code);
+}
+TEST(ParserLimitsTest, BytesExceeded)
+{
+    std::stringstream           stream(R"({"x": 1, "name": "Loki"})");
+    ParserLimitsTest::Record    record{};
+    ParserInterface::ParserConfig   config;
+    config.maxBytes = 12;
+
+    EXPECT_EQ(ErrorCode::LimitExceeded, jsonTryImport(stream, record, config).code);
+}
+TEST(ParserLimitsTest, BytesExceededThrows)
+{
+    std::stringstream           stream(R"({"x": 1, "name": "Loki"})");
+    ParserLimitsTest::Record    record{};
+    ParserInterface::ParserConfig   config;
+    config.maxBytes = 12;
+
+    EXPECT_THROW(
+        stream >> jsonImport(record, config),
+        std::runtime_error
+    );
+}
+TEST(ParserLimitsTest, BytesAtLimitRestoresStream)
+{
+    std::string                 first(R"({"x": 1, "name": "Loki"})");
+    std::stringstream           stream(first + R"( {"x": 2})");
+    std::streambuf*             buffer = stream.rdbuf();
+    ParserLimitsTest::Record    record{};
+    ParserInterface::ParserConfig   config;
+    config.maxBytes = first.size();
+
+    stream >> jsonImport(record, config);
+    EXPECT_FALSE(stream.fail());
+    EXPECT_EQ(buffer, stream.rdbuf());
+    EXPECT_EQ("Loki", record.name);
+
+    stream >> jsonImport(record, config);
+    EXPECT_FALSE(stream.fail());
+    EXPECT_EQ(2, record.x);
+}
+TEST(ParserLimitsTest, BinaryStringSizeCheckedBeforeRead)
+{
+    std::stringstream           stream;
+    std::string                 input(1000, 'x');
+    stream << ThorsAnvil::Serialize::msgpackExport(input);
+
+    std::string                 output;
+    ParserInterface::ParserConfig   config;
+    config.maxStringLength = 100;
+
+    EXPECT_THROW(
+        stream >> ThorsAnvil::Serialize::msgpackImport(output, config),
+        std::runtime_error
+    );
+}
+TEST(ParserLimitsTest, BinaryStringSizeCheckedAgainstBytes)
+{
+    // A str32 that claims to be 2GB long: Rejected before the string is allocated.
+    std::stringstream           stream(std::string("\xDB\x7F\xFF\xFF\xFFabc", 8));
+    std::string                 output;
+    ParserInterface::ParserConfig   config;
+    config.maxBytes = 1024;
+
+    EXPECT_EQ(ErrorCode::LimitExceeded, ThorsAnvil::Serialize::tryImport<ThorsAnvil::Serialize::MsgPack>(stream, output, config).code);
+}
+TEST(ParserLimitsTest, BinaryStringWithinBytes)
+{
+    std::stringstream           stream;
+    std::string                 input(100, 'x');
+    stream << ThorsAnvil::Serialize::msgpackExport(input);
+
+    std::string                 output;
+    ParserInterface::ParserConfig   config;
+    config.maxBytes = stream.str().size();
+
+    stream >> ThorsAnvil::Serialize::msgpackImport(output, config);
+    EXPECT_EQ(input, output);
+}
+TEST(ParserLimitsTest, PlanImportArrayElementsExceeded)
+{
+    std::stringstream           stream(R"({"data": [[1, 2, 3, 4, 5, 6]]})");
+    ParserLimitsTest::Record    record{};
+    ParserInterface::ParserConfig   config;
+    config.maxElements = 2;
+
+    EXPECT_THROW(
+        stream >> ThorsAnvil::Serialize::PlanImport<ThorsAnvil::Serialize::Json>(record, config),
+        std::runtime_error
+    );
+}
+TEST(ParserLimitsTest, PlanImportMembersExceeded)
+{
+    std::stringstream           stream(R"({"x": 1, "a": 2, "b": 3, "c": 4, "d": 5})");
+    ParserLimitsTest::Record    record{};
+    ParserInterface::ParserConfig   config = limits();
+    config.throwOnError = false;
+
+    stream >> ThorsAnvil::Serialize::PlanImport<ThorsAnvil::Serialize::Json>(record, config);
+    EXPECT_TRUE(stream.fail());
+}
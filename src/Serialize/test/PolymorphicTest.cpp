@@ -148,4 +148,12 @@ TEST(PolymorphicTest, ReadBike)
     ASSERT_NE(bike, nullptr);
     EXPECT_EQ(bike->stroke, 7);
 }
+TEST(PolymorphicTest, MissingMarkerIsRecorded)
+{
+    std::stringstream   stream(R"({"age":10,"transport":{"speed":12,"__type":"PolymorphicTest::Vehicle"}})");
+    PolymorphicTest::User    user1{10, nullptr};
 
+    ThorsAnvil::Serialize::ParserInterface::ParseResult result = ThorsAnvil::Serialize::jsonTryImport(stream, user1);
+    EXPECT_EQ(ThorsAnvil::Serialize::ParserInterface::ErrorCode::UnknownKey, result.code);
+    delete user1.transport;
+}
@@ -0,0 +1,143 @@
+#include "gtest/gtest.h"
+#include "Serialize.h"
+#include "Serialize.tpp"
+#include "SerUtil.h"
+#include "JsonThor.h"
+#include "YamlThor.h"
+#include "Validator.h"
+#include <sstream>
+#include <vector>
+
+namespace RawNumberTest
+{
+using ThorsAnvil::Serialize::RawNumber;
+struct Order
+{
+    RawNumber                   id;
+    RawNumber                   price;
+    std::vector<RawNumber>      data;
+};
+}
+
+ThorsAnvil_MakeTrait(RawNumberTest::Order, id, price, data);
+
+using ThorsAnvil::Serialize::RawNumber;
+using ThorsAnvil::Serialize::jsonImport;
+using ThorsAnvil::Serialize::jsonExport;
+using ThorsAnvil::Serialize::jsonValidate;
+using ThorsAnvil::Serialize::PrinterInterface;
+
+TEST(RawNumberTest, SmallTextIsLocal)
+{
+    RawNumber   value("-12.5e3");
+    EXPECT_EQ("-12.5e3", value.text());
+    EXPECT_FALSE(value.isInteger());
+    EXPECT_EQ(-12500.0, value.asDouble());
+}
+TEST(RawNumberTest, LongTextIsKept)
+{
+    std::string text = "123456789012345678901234567890123456789";
+    RawNumber   value(text);
+    EXPECT_EQ(text, value.text());
+    EXPECT_TRUE(value.isInteger());
+    EXPECT_THROW(value.asInteger(), std::runtime_error);
+    EXPECT_DOUBLE_EQ(1.2345678901234568e38, value.asDouble());
+}
+TEST(RawNumberTest, ConvertInteger)
+{
+    RawNumber   value("42");
+    EXPECT_EQ(42, value.asInteger());
+    EXPECT_EQ(42, value.asInteger());
+    EXPECT_EQ(42.0, value.asDouble());
+}
+TEST(RawNumberTest, FloatIsNotInteger)
+{
+    RawNumber   value("4.0");
+    EXPECT_THROW(value.asInteger(), std::runtime_error);
+}
+TEST(RawNumberTest, InvalidText)
+{
+    EXPECT_THROW(RawNumber("01"), std::runtime_error);
+    EXPECT_THROW(RawNumber("1."), std::runtime_error);
+    EXPECT_THROW(RawNumber("1e"), std::runtime_error);
+    EXPECT_THROW(RawNumber("abc"), std::runtime_error);
+    EXPECT_THROW(RawNumber(""), std::runtime_error);
+}
+TEST(RawNumberTest, JsonRoundTripIsVerbatim)
+{
+    std::string         input = R"({"id":123456789012345678901234567890,"price":1.50,"data":[1E2,-0.0,7]})";
+    std::stringstream   stream(input);
+    RawNumberTest::Order order;
+    stream >> jsonImport(order);
+
+    EXPECT_EQ("123456789012345678901234567890", order.id.text());
+    EXPECT_EQ(1.5, order.price.asDouble());
+    ASSERT_EQ(3, order.data.size());
+    EXPECT_EQ(100.0, order.data[0].asDouble());
+    EXPECT_EQ(7, order.data[2].asInteger());
+
+    std::stringstream   output;
+    output << jsonExport(order, PrinterInterface::OutputType::Stream);
+    EXPECT_EQ(input, output.str());
+}
+TEST(RawNumberTest, PrintEmptyThrows)
+{
+    RawNumberTest::Order    order;
+    order.price = RawNumber("1");
+
+    std::stringstream       output;
+    EXPECT_THROW(
+        output << jsonExport(order, PrinterInterface::OutputType::Stream),
+        std::runtime_error
+    );
+}
+TEST(RawNumberTest, JsonStringIsNotANumber)
+{
+    std::stringstream   stream(R"({"id":"12"})");
+    RawNumberTest::Order order;
+    EXPECT_THROW(
+        stream >> jsonImport(order),
+        std::runtime_error
+    );
+}
+#ifdef HAVE_YAML
+TEST(RawNumberTest, YamlNumber)
+{
+    using ThorsAnvil::Serialize::yamlImport;
+    std::stringstream   stream("id: 98765432109876543210\nprice: 2.25\n");
+    RawNumberTest::Order order;
+    stream >> yamlImport(order);
+
+    EXPECT_EQ("98765432109876543210", order.id.text());
+    EXPECT_EQ(2.25, order.price.asDouble());
+}
+TEST(RawNumberTest, YamlTextIsRecordedAsInvalidValue)
+{
+    // Yaml does not know the type of a scalar: The text is checked without throwing.
+    using ThorsAnvil::Serialize::yamlImport;
+    std::stringstream   stream("id: twelve\nprice: 2.25\n");
+    RawNumberTest::Order order;
+    ThorsAnvil::Serialize::ParserInterface::ParserConfig config;
+    config.throwOnError = false;
+
+    EXPECT_NO_THROW(
+        stream >> yamlImport(order, config)
+    );
+    EXPECT_TRUE(stream.fail());
+}
+TEST(RawNumberTest, YamlTryImport)
+{
+    std::stringstream   stream("id: twelve\nprice: 2.25\n");
+    RawNumberTest::Order order;
+
+    EXPECT_EQ(ThorsAnvil::Serialize::ParserInterface::ErrorCode::InvalidValue, ThorsAnvil::Serialize::tryImport<ThorsAnvil::Serialize::Yaml>(stream, order).code);
+}
+#endif
+TEST(RawNumberTest, Validate)
+{
+    std::stringstream   good(R"({"id":1,"price":2.5,"data":[3]})");
+    EXPECT_TRUE(jsonValidate<RawNumberTest::Order>(good));
+
+    std::stringstream   bad(R"({"id":true})");
+    EXPECT_FALSE(jsonValidate<RawNumberTest::Order>(bad));
+}
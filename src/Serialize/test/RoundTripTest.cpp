@@ -2,13 +2,141 @@
 
 #include "gtest/gtest.h"
 #include "test/BinaryParserTest.h"
+#include "Serialize.tpp"
 #include "BinaryThor.h"
 #include "JsonThor.h"
 #include "YamlThor.h"
+#include "CborThor.h"
+#include "MsgPackThor.h"
+#include "BsonThor.h"
+#include "SerUtil.h"
+#include <sstream>
+#include <vector>
+#include <map>
 
 namespace TA=ThorsAnvil::Serialize;
 using TA::ParserInterface;
 
+namespace RoundTripTest
+{
+struct Person
+{
+    std::string                 name;
+    int                         age;
+    double                      height;
+    bool                        active;
+    std::vector<long long>      scores;
+    std::map<std::string, int>  counts;
+};
+struct PersonV2
+{
+    std::string                 name;
+    int                         age;
+};
+struct Inner
+{
+    int                         value;
+};
+struct Pointers
+{
+    Inner*                      a;
+    Inner*                      b;
+    int                         tail;
+};
+
+// The formats the format independent round trips are run with.
+struct CborFormat
+{
+    template<typename T> static auto exporter(T const& value)   {return TA::cborExport(value);}
+    template<typename T> static auto importer(T& value)         {return TA::cborImport(value);}
+};
+struct MsgPackFormat
+{
+    template<typename T> static auto exporter(T const& value)   {return TA::msgpackExport(value);}
+    template<typename T> static auto importer(T& value)         {return TA::msgpackImport(value);}
+};
+struct BsonFormat
+{
+    template<typename T> static auto exporter(T const& value)   {return TA::bsonExport(value);}
+    template<typename T> static auto importer(T& value)         {return TA::bsonImport(value);}
+};
+}
+ThorsAnvil_MakeTrait(RoundTripTest::Person, name, age, height, active, scores, counts);
+ThorsAnvil_MakeTrait(RoundTripTest::PersonV2, name, age);
+ThorsAnvil_MakeTrait(RoundTripTest::Inner, value);
+ThorsAnvil_MakeTrait(RoundTripTest::Pointers, a, b, tail);
+
+template<typename Format>
+class RoundTripFormatTest: public ::testing::Test
+{};
+using RoundTripFormats = ::testing::Types<RoundTripTest::CborFormat, RoundTripTest::MsgPackFormat, RoundTripTest::BsonFormat>;
+TYPED_TEST_SUITE(RoundTripFormatTest, RoundTripFormats);
+
+TYPED_TEST(RoundTripFormatTest, Object)
+{
+    RoundTripTest::Person   person{"Bob", -42, 1.75, true, {1, -5000000000LL, 300}, {{"x", 1}, {"y", -2}}};
+
+    std::stringstream       stream;
+    stream << TypeParam::exporter(person);
+
+    RoundTripTest::Person   result{};
+    stream >> TypeParam::importer(result);
+
+    EXPECT_EQ(person.name,      result.name);
+    EXPECT_EQ(person.age,       result.age);
+    EXPECT_EQ(person.height,    result.height);
+    EXPECT_EQ(person.active,    result.active);
+    EXPECT_EQ(person.scores,    result.scores);
+    EXPECT_EQ(person.counts,    result.counts);
+}
+TYPED_TEST(RoundTripFormatTest, UnknownFieldsAreIgnored)
+{
+    RoundTripTest::Person   person{"Alice", 30, 1.6, false, {7}, {{"z", 3}}};
+
+    std::stringstream       stream;
+    stream << TypeParam::exporter(person);
+
+    RoundTripTest::PersonV2 result{};
+    stream >> TypeParam::importer(result);
+
+    EXPECT_EQ("Alice",  result.name);
+    EXPECT_EQ(30,       result.age);
+}
+TYPED_TEST(RoundTripFormatTest, PointerAfterNull)
+{
+    RoundTripTest::Pointers pointers{nullptr, new RoundTripTest::Inner{42}, 7};
+
+    std::stringstream       stream;
+    stream << TypeParam::exporter(pointers);
+    delete pointers.b;
+
+    RoundTripTest::Pointers result{nullptr, nullptr, 0};
+    stream >> TypeParam::importer(result);
+
+    EXPECT_EQ(nullptr,  result.a);
+    ASSERT_NE(nullptr,  result.b);
+    EXPECT_EQ(42,       result.b->value);
+    EXPECT_EQ(7,        result.tail);
+    delete result.b;
+}
+TYPED_TEST(RoundTripFormatTest, PointerVectorAfterNull)
+{
+    std::vector<RoundTripTest::Inner*>  pointers{nullptr, new RoundTripTest::Inner{42}};
+
+    std::stringstream       stream;
+    stream << TypeParam::exporter(pointers);
+    delete pointers[1];
+
+    std::vector<RoundTripTest::Inner*>  result;
+    stream >> TypeParam::importer(result);
+
+    ASSERT_EQ(std::size_t{2},   result.size());
+    EXPECT_EQ(nullptr,          result[0]);
+    ASSERT_NE(nullptr,          result[1]);
+    EXPECT_EQ(42,               result[1]->value);
+    delete result[1];
+}
+
 
 #ifdef NETWORK_BYTE_ORDER
 TEST(RoundTripTest, BinaryMap)
@@ -18,10 +146,11 @@ TEST(RoundTripTest, BinaryMap)
 
     stream << TA::binExport(base);
 
-    std::string expected("\x1c\xa2\x7d\xce"     // THash of Base    \x00\x00
-                         "\x00\x00\x00\x0a"     // 10
-                         "\x00\x00\x04\x00",    // 1024
-                         12);
+    std::string expected("\x01"                                 // Binary format version
+                         "\x2f\xf0\x02\x48\x9d\x3e\xe8\xcf"     // THash of Base
+                         "\x00\x00\x00\x0a"                     // 10
+                         "\x00\x00\x04\x00",                    // 1024
+                         17);
 
     EXPECT_EQ(expected.size(), stream.str().size());
     for(int loop =0;loop < expected.size(); ++loop)
@@ -46,11 +175,12 @@ TEST(RoundTripTest, BinaryParent)
 
     stream << TA::binExport(deri);
 
-    std::string expected("\xf1\x21\x74\x88"     // THash of Derived
-                         "\x00\x00\x00\x0a"     // 10
-                         "\x00\x00\x04\x00"     // 1024
-                         "\x00\x00\xdd\xd5"     // 56789
-                         "\x43\x6a\xe0\x00",    // 234.875
+    std::string expected("\x01"                                 // Binary format version
+                         "\x1f\x64\x87\x8e\x15\x0b\xe1\xff"     // THash of Derived
+                         "\x00\x00\x00\x0a"                     // 10
+                         "\x00\x00\x04\x00"                     // 1024
+                         "\x00\x00\xdd\xd5"                     // 56789
+                         "\x43\x6a\xe0\x00",                    // 234.875
                          /*
                             Bit Patter of 234.875
                          Sign: 1 bit Exponent: 8 bits Significant: 24  bits (23 explicitly stored)
@@ -62,7 +192,7 @@ TEST(RoundTripTest, BinaryParent)
                                 0 1 0 0 - 0 0 1 1 - 0 1 1 0 - 1 0 1 0 - 1 1 1 0 - 0.....
                                 43 6a e0 00
                           */
-                         20);
+                         25);
 
     EXPECT_EQ(expected.size(), stream.str().size());
     for(int loop =0;loop < expected.size(); ++loop)
@@ -84,15 +214,16 @@ TEST(RoundTripTest, BinaryArray)
 
     stream << TA::binExport(data);
 
-    std::string expected("\xea\xb0\x50\x2f"     // THash of vector<int>
-                         "\x00\x00\x00\x06"     // data.size()
-                         "\x00\x00\x00\x0a"     // 10
-                         "\x00\x00\x04\x00"     // 1024
-                         "\x00\x00\x00\x09"     // 9
-                         "\x00\x00\x01\x6f"     // 367
-                         "\x00\x00\x00\x0c"     // 12
-                         "\x00\x00\x00\x22",    // 34
-                         32);
+    std::string expected("\x01"                                 // Binary format version
+                         "\xb3\x76\xd7\xfb\xb3\x68\x34\x00"     // THash of vector<int>
+                         "\x00\x00\x00\x06"                     // data.size()
+                         "\x00\x00\x00\x0a"                     // 10
+                         "\x00\x00\x04\x00"                     // 1024
+                         "\x00\x00\x00\x09"                     // 9
+                         "\x00\x00\x01\x6f"                     // 367
+                         "\x00\x00\x00\x0c"                     // 12
+                         "\x00\x00\x00\x22",                    // 34
+                         37);
 
     EXPECT_EQ(expected.size(), stream.str().size());
     for(int loop =0;loop < expected.size(); ++loop)
@@ -116,7 +247,7 @@ TEST(RoundTripTest, BinaryValue)
 
     stream << TA::binExport(data);
 
-    std::string expected("\x00\x00\x00\x49" "\x04\x14\x8F\x27", 8);
+    std::string expected("\x01" "\xb8\xc6\x88\x62\x26\xc4\x81\xbc" "\x04\x14\x8F\x27", 13);
     EXPECT_EQ(expected.size(), stream.str().size());
     for(int loop =0;loop < expected.size(); ++loop)
     {
@@ -56,3 +56,30 @@ TEST(SerMapTest, deSerializeStringKey)
     EXPECT_EQ(data["OfMiceAndMen"], true);
 }
 
+
+TEST(SerMapTest, deSerializeUnsortedAndDuplicateKeys)
+{
+    std::map<std::string, int>  data;
+
+    std::stringstream       stream(R"({"b":1, "d":2, "a":3, "c":4, "d":5})");
+    stream >> TS::jsonImport(data);
+
+    std::map<std::string, int>  expected{{"a", 3}, {"b", 1}, {"c", 4}, {"d", 5}};
+    EXPECT_EQ(expected, data);
+}
+
+TEST(SerMapTest, roundTripSorted)
+{
+    std::map<int, double>   data;
+    for (int loop = 0; loop < 100; ++loop)
+    {
+        data[loop * 3] = loop;
+    }
+
+    std::stringstream       stream;
+    stream << TS::jsonExport(data);
+
+    std::map<int, double>   result;
+    stream >> TS::jsonImport(result);
+    EXPECT_EQ(data, result);
+}
@@ -32,3 +32,13 @@ TEST(SerSetTest, deSerialize)
     EXPECT_TRUE(data.find(123) != data.end());
 }
 
+
+TEST(SerSetTest, deSerializeUnsorted)
+{
+    std::set<int>  data;
+
+    std::stringstream       stream(R"([123,5,101,6,8,5])");
+    stream >> TS::jsonImport(data);
+
+    EXPECT_EQ(std::set<int>({5, 6, 8, 101, 123}), data);
+}
@@ -1,10 +1,34 @@
 
 #include "gtest/gtest.h"
 #include "JsonThor.h"
+#include "BsonThor.h"
 #include "Serialize.h"
 #include "test/SerializeTest.h"
 #include <algorithm>
 
+namespace SerializeEnumTest
+{
+enum class Permission : unsigned char { Read = 1, Write = 2, Execute = 4 };
+enum class Offset { Low = -2, Mid = -1, High = 0 };
+enum class Sparse { One = 1, Ten = 10, Hundred = 100 };
+struct File
+{
+    std::string     name;
+    Permission      permission;
+};
+}
+
+ThorsAnvil_MakeEnumFlag(SerializeEnumTest::Permission, Read, Write, Execute);
+ThorsAnvil_MakeEnum(SerializeEnumTest::Offset, High, Low, Mid);
+ThorsAnvil_MakeEnum(SerializeEnumTest::Sparse, One, Ten, Hundred);
+ThorsAnvil_MakeTrait(SerializeEnumTest::File, name, permission);
+
+using SerializeEnumTest::Permission;
+inline Permission operator|(Permission lhs, Permission rhs)
+{
+    return static_cast<Permission>(static_cast<unsigned char>(lhs) | static_cast<unsigned char>(rhs));
+}
+
 std::string stripspace(std::string const& value)
 {
     std::string  result(value);
@@ -77,5 +101,144 @@ TEST(SerializeEnum, DeSerEnumInContainer)
     str >> ThorsAnvil::Serialize::jsonImport(holder);
     EXPECT_EQ(SerializeTest::Green, holder.value);
 }
+TEST(DeSerializeEnum, DeSerEnumAllValues)
+{
+    // The names are looked up with a binary search over the sorted names.
+    // So check every value (not just the first few).
+    char const* names[] = {"OCT1", "OCT2", "OCT3", "OCT4", "OCT5", "OCT6", "OCT7", "OCT8"};
+    for (int loop = 0; loop < 8; ++loop)
+    {
+        std::stringstream   str(std::string("\"") + names[loop] + "\"");
+        SerializeTest::OctalValues  enumHolder {SerializeTest::OctalValues::OCT1};
+
+        str >> ThorsAnvil::Serialize::jsonImport(enumHolder);
+        EXPECT_EQ(static_cast<SerializeTest::OctalValues>(loop), enumHolder);
+    }
+}
+TEST(DeSerializeEnum, DeSerEnumInvalidValue)
+{
+    std::stringstream   str(R"("Purple")");
+    SerializeTest::RGB     enumHolder {SerializeTest::Green};
+
+    EXPECT_THROW(
+        str >> ThorsAnvil::Serialize::jsonImport(enumHolder),
+        std::runtime_error
+    );
+}
+TEST(SerializeEnum, EnumNamesAreCompileTime)
+{
+    using RGBTraits = ThorsAnvil::Serialize::Traits<SerializeTest::RGB>;
+    static_assert(RGBTraits::names.size() == 3, "Expected three names");
+    static_assert(RGBTraits::names.find("Green") == 1, "Expected Green to be the second value");
+    static_assert(RGBTraits::names.find(SerializeTest::Blue) == 2, "Expected Blue to be the third value");
+    static_assert(RGBTraits::names.find("Purple") == 3, "Expected Purple to not be found");
+
+    EXPECT_EQ("Blue", RGBTraits::getName(SerializeTest::Blue, "Test"));
+}
+TEST(SerializeEnum, GetValuesMapsValueToName)
+{
+    using RGBTraits = ThorsAnvil::Serialize::Traits<SerializeTest::RGB>;
+    std::map<SerializeTest::RGB, std::string> const& values = RGBTraits::getValues();
+
+    ASSERT_EQ(3, values.size());
+    EXPECT_EQ("Red",   values.at(SerializeTest::Red));
+    EXPECT_EQ("Green", values.at(SerializeTest::Green));
+    EXPECT_EQ("Blue",  values.at(SerializeTest::Blue));
+    EXPECT_EQ(&values, &RGBTraits::getValues());
+}
+TEST(SerializeEnumFlag, SerFlagsAsArrayOfNames)
+{
+    Permission          flags = Permission::Read | Permission::Execute;
+    std::stringstream   str;
+
+    str << ThorsAnvil::Serialize::jsonExport(flags);
+    EXPECT_EQ(R"(["Read","Execute"])", stripspace(str.str()));
+}
+TEST(SerializeEnumFlag, SerNoFlagsIsEmptyArray)
+{
+    Permission          flags = static_cast<Permission>(0);
+    std::stringstream   str;
 
+    str << ThorsAnvil::Serialize::jsonExport(flags);
+    EXPECT_EQ(R"([])", stripspace(str.str()));
+}
+TEST(SerializeEnumFlag, SerFlagsWithUnknownBits)
+{
+    Permission          flags = static_cast<Permission>(9);
+    std::stringstream   str;
 
+    EXPECT_THROW(
+        str << ThorsAnvil::Serialize::jsonExport(flags),
+        std::runtime_error
+    );
+}
+TEST(SerializeEnumFlag, DeSerFlagsFromArrayOfNames)
+{
+    std::stringstream   str(R"(["Write", "Read"])");
+    Permission          flags = Permission::Execute;
+
+    str >> ThorsAnvil::Serialize::jsonImport(flags);
+    EXPECT_EQ(Permission::Read | Permission::Write, flags);
+}
+TEST(SerializeEnumFlag, DeSerFlagsInvalidName)
+{
+    std::stringstream   str(R"(["Write", "Delete"])");
+    Permission          flags = Permission::Execute;
+
+    EXPECT_THROW(
+        str >> ThorsAnvil::Serialize::jsonImport(flags),
+        std::runtime_error
+    );
+}
+TEST(SerializeEnumFlag, RoundTripFlagsInObject)
+{
+    SerializeEnumTest::File     file{"data", Permission::Write | Permission::Execute};
+    std::stringstream           str;
+    str << ThorsAnvil::Serialize::jsonExport(file);
+    EXPECT_EQ(R"({"name":"data","permission":["Write","Execute"]})", stripspace(str.str()));
+
+    SerializeEnumTest::File     result{"", Permission::Read};
+    str >> ThorsAnvil::Serialize::jsonImport(result);
+    EXPECT_EQ("data", result.name);
+    EXPECT_EQ(Permission::Write | Permission::Execute, result.permission);
+}
+TEST(SerializeEnumFlag, RoundTripFlagsInObjectBinaryIsInteger)
+{
+    SerializeEnumTest::File     file{"data", Permission::Write | Permission::Execute};
+    std::stringstream           str;
+    str << ThorsAnvil::Serialize::bsonExport(file);
+
+    // The flags are a single integer (0x12) not an array (0x04).
+    std::string     data = str.str();
+    std::string     element("\x12permission\0\x06\0\0\0\0\0\0\0", 20);
+    EXPECT_NE(std::string::npos, data.find(element));
+
+    SerializeEnumTest::File     result{"", Permission::Read};
+    str >> ThorsAnvil::Serialize::bsonImport(result);
+    EXPECT_EQ("data", result.name);
+    EXPECT_EQ(Permission::Write | Permission::Execute, result.permission);
+}
+TEST(SerializeEnum, EnumNamesFindContiguousValues)
+{
+    // Contiguous values (declared out of order and negative) are found by indexing.
+    using OffsetTraits = ThorsAnvil::Serialize::Traits<SerializeEnumTest::Offset>;
+    static_assert(OffsetTraits::names.find(SerializeEnumTest::Offset::High) == 0, "Expected High to be the first value");
+    static_assert(OffsetTraits::names.find(SerializeEnumTest::Offset::Low) == 1, "Expected Low to be the second value");
+    static_assert(OffsetTraits::names.find(SerializeEnumTest::Offset::Mid) == 2, "Expected Mid to be the third value");
+    static_assert(OffsetTraits::names.find(static_cast<SerializeEnumTest::Offset>(1)) == 3, "Expected 1 to not be found");
+    static_assert(OffsetTraits::names.find(static_cast<SerializeEnumTest::Offset>(-3)) == 3, "Expected -3 to not be found");
+
+    EXPECT_EQ("Low", OffsetTraits::getName(SerializeEnumTest::Offset::Low, "Test"));
+}
+TEST(SerializeEnum, EnumNamesFindSparseValues)
+{
+    using SparseTraits = ThorsAnvil::Serialize::Traits<SerializeEnumTest::Sparse>;
+    static_assert(SparseTraits::names.find(SerializeEnumTest::Sparse::Ten) == 1, "Expected Ten to be the second value");
+    static_assert(SparseTraits::names.find(SerializeEnumTest::Sparse::Hundred) == 2, "Expected Hundred to be the third value");
+    static_assert(SparseTraits::names.find(static_cast<SerializeEnumTest::Sparse>(2)) == 3, "Expected 2 to not be found");
+
+    EXPECT_THROW(
+        SparseTraits::getName(static_cast<SerializeEnumTest::Sparse>(2), "Test"),
+        std::runtime_error
+    );
+}
@@ -0,0 +1,112 @@
+
+#include "gtest/gtest.h"
+#include "Serialize.h"
+#include "Serialize.tpp"
+#include "SerUtil.h"
+#include "JsonThor.h"
+#include "SerializeStats.h"
+#include <sstream>
+#include <vector>
+
+namespace SerializeStatsTest
+{
+struct Point
+{
+    int         x;
+    int         y;
+};
+struct Path
+{
+    std::vector<Point>  points;
+    Point*              start   = nullptr;
+    ~Path() {delete start;}
+};
+}
+ThorsAnvil_MakeTrait(SerializeStatsTest::Point, x, y);
+ThorsAnvil_MakeTrait(SerializeStatsTest::Path, points, start);
+
+using namespace ThorsAnvil::Serialize;
+using ParserToken = ParserInterface::ParserToken;
+
+TEST(SerializeStatsTest, CountTokensWhenParsing)
+{
+    std::string const               input = R"({"x": 1, "y": 2})";
+    std::stringstream               stream(input);
+    SerializeStatsTest::Point       point;
+    SerializeStats                  stats;
+    ParserInterface::ParserConfig   config;
+    config.stats = &stats;
+
+    stream >> jsonImport(point, config);
+
+    EXPECT_EQ(1, stats.tokens[static_cast<int>(ParserToken::DocStart)]);
+    EXPECT_EQ(1, stats.tokens[static_cast<int>(ParserToken::DocEnd)]);
+    EXPECT_EQ(1, stats.tokens[static_cast<int>(ParserToken::MapStart)]);
+    EXPECT_EQ(1, stats.tokens[static_cast<int>(ParserToken::MapEnd)]);
+    EXPECT_EQ(2, stats.tokens[static_cast<int>(ParserToken::Key)]);
+    EXPECT_EQ(2, stats.tokens[static_cast<int>(ParserToken::Value)]);
+    EXPECT_EQ(input.size(), stats.bytesRead);
+    EXPECT_EQ(0, stats.keysIgnored);
+    EXPECT_EQ(0, stats.allocations);
+}
+
+TEST(SerializeStatsTest, CountIgnoredKeysAndAllocations)
+{
+    std::stringstream               stream(R"({"points": [{"x": 1, "y": 2, "z": 3}, {"x": 4, "y": 5}], "extra": [1, 2], "start": {"x": 6, "y": 7}})");
+    SerializeStatsTest::Path        path;
+    SerializeStats                  stats;
+    ParserInterface::ParserConfig   config;
+    config.stats = &stats;
+
+    stream >> jsonImport(path, config);
+
+    EXPECT_EQ(2, stats.keysIgnored);
+    EXPECT_EQ(1, stats.allocations);
+
+    auto find = stats.types.find(std::type_index(typeid(SerializeStatsTest::Point)));
+    ASSERT_NE(stats.types.end(), find);
+    EXPECT_EQ(2, find->second.count);
+    EXPECT_EQ(typeid(SerializeStatsTest::Point).name(), find->second.name);
+
+    find = stats.types.find(std::type_index(typeid(SerializeStatsTest::Path)));
+    ASSERT_NE(stats.types.end(), find);
+    EXPECT_EQ(1, find->second.count);
+}
+
+TEST(SerializeStatsTest, CountBytesAndTypesWhenPrinting)
+{
+    SerializeStatsTest::Path        path;
+    path.points.push_back({1, 2});
+    path.points.push_back({3, 4});
+    path.points.push_back({5, 6});
+
+    std::stringstream               stream;
+    SerializeStats                  stats;
+    PrinterInterface::PrinterConfig config(PrinterInterface::OutputType::Stream);
+    config.stats = &stats;
+
+    stream << jsonExport(path, config);
+
+    EXPECT_EQ(stream.str().size(), stats.bytesWritten);
+
+    auto find = stats.types.find(std::type_index(typeid(SerializeStatsTest::Point)));
+    ASSERT_NE(stats.types.end(), find);
+    EXPECT_EQ(3, find->second.count);
+}
+
+TEST(SerializeStatsTest, ResetClearsEverything)
+{
+    std::stringstream               stream(R"({"x": 1, "y": 2, "z": 3})");
+    SerializeStatsTest::Point       point;
+    SerializeStats                  stats;
+    ParserInterface::ParserConfig   config;
+    config.stats = &stats;
+
+    stream >> jsonImport(point, config);
+    stats.reset();
+
+    EXPECT_EQ(0, stats.tokens[static_cast<int>(ParserToken::Key)]);
+    EXPECT_EQ(0, stats.keysIgnored);
+    EXPECT_EQ(0, stats.bytesRead);
+    EXPECT_TRUE(stats.types.empty());
+}
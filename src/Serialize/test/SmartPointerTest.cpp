@@ -1,8 +1,10 @@
 #include "gtest/gtest.h"
 #include "SmartPointerTest.h"
 #include "JsonThor.h"
+#include "Serialize.tpp"
 #include "SerUtil.h"
 #include <memory>
+#include <vector>
 
 TEST(SmartPointerTest, CreateNormalPtrNull)
 {
@@ -196,3 +198,141 @@ TEST(SmartPointerTest, SerializeSharedPtrObject)
     EXPECT_EQ(stream.str(), R"({"id":456,"name":"This is a test"})");
 }
 
+
+TEST(SmartPointerTest, SerializeSharedPtrDefaultPrintsEachCopy)
+{
+    using ShareObject = std::shared_ptr<SmartPtrTest::Object>;
+
+    ShareObject                 object = std::make_shared<SmartPtrTest::Object>(SmartPtrTest::Object{1, "One"});
+    std::vector<ShareObject>    data{object, object};
+    std::stringstream           stream;
+
+    stream << ThorsAnvil::Serialize::jsonExport(data, ThorsAnvil::Serialize::PrinterInterface::OutputType::Stream);
+    EXPECT_EQ(stream.str(), R"([{"id":1,"name":"One"},{"id":1,"name":"One"}])");
+}
+
+TEST(SmartPointerTest, SerializeSharedPtrPreserved)
+{
+    using ShareObject = std::shared_ptr<SmartPtrTest::Object>;
+
+    ShareObject                 one = std::make_shared<SmartPtrTest::Object>(SmartPtrTest::Object{1, "One"});
+    ShareObject                 two = std::make_shared<SmartPtrTest::Object>(SmartPtrTest::Object{2, "Two"});
+    std::vector<ShareObject>    data{one, two, one, nullptr, two};
+    std::stringstream           stream;
+
+    ThorsAnvil::Serialize::PrinterInterface::PrinterConfig  config{ThorsAnvil::Serialize::PrinterInterface::OutputType::Stream};
+    config.preserveSharedPtr = true;
+    stream << ThorsAnvil::Serialize::jsonExport(data, config);
+    EXPECT_EQ(stream.str(), R"([{"__id":0,"__value":{"id":1,"name":"One"}},{"__id":1,"__value":{"id":2,"name":"Two"}},{"__ref":0},null,{"__ref":1}])");
+}
+
+TEST(SmartPointerTest, DeSerializeSharedPtrPreserved)
+{
+    using ShareObject = std::shared_ptr<SmartPtrTest::Object>;
+
+    std::stringstream           stream(R"([{"__id":0,"__value":{"id":1,"name":"One"}},{"__id":1,"__value":{"id":2,"name":"Two"}},{"__ref":0},null,{"__ref":1}])");
+    std::vector<ShareObject>    data;
+
+    ThorsAnvil::Serialize::ParserInterface::ParserConfig    config;
+    config.preserveSharedPtr = true;
+    stream >> ThorsAnvil::Serialize::jsonImport(data, config);
+
+    ASSERT_EQ(data.size(), 5);
+    ASSERT_NE(data[0], nullptr);
+    ASSERT_NE(data[1], nullptr);
+    EXPECT_EQ(data[0]->id, 1);
+    EXPECT_EQ(data[1]->name, "Two");
+    EXPECT_EQ(data[0], data[2]);
+    EXPECT_EQ(data[1], data[4]);
+    EXPECT_EQ(data[3], nullptr);
+    EXPECT_EQ(data[0].use_count(), 2);
+}
+
+TEST(SmartPointerTest, DeSerializeSharedPtrUnknownReference)
+{
+    using ShareObject = std::shared_ptr<SmartPtrTest::Object>;
+
+    std::stringstream           stream(R"([{"__ref":3}])");
+    std::vector<ShareObject>    data;
+
+    ThorsAnvil::Serialize::ParserInterface::ParserConfig    config;
+    config.preserveSharedPtr = true;
+    EXPECT_THROW(
+        stream >> ThorsAnvil::Serialize::jsonImport(data, config),
+        std::runtime_error
+    );
+}
+
+TEST(SmartPointerTest, DeSerializeSharedPtrReferenceToDifferentType)
+{
+    std::stringstream           stream(R"({"sm":{"__id":0,"__value":{"a":5}},"bg":{"__ref":0}})");
+    SmartPtrTest::Holder        data;
+
+    ThorsAnvil::Serialize::ParserInterface::ParserConfig    config;
+    config.preserveSharedPtr = true;
+    EXPECT_THROW(
+        stream >> ThorsAnvil::Serialize::jsonImport(data, config),
+        std::runtime_error
+    );
+    EXPECT_EQ(data.bg, nullptr);
+}
+
+TEST(SmartPointerTest, DeSerializeSharedPtrHugeId)
+{
+    using ShareObject = std::shared_ptr<SmartPtrTest::Object>;
+
+    std::stringstream           stream(R"([{"__id":1000000000000,"__value":{"id":1,"name":"One"}}])");
+    std::vector<ShareObject>    data;
+
+    ThorsAnvil::Serialize::ParserInterface::ParserConfig    config;
+    config.preserveSharedPtr = true;
+    EXPECT_THROW(
+        stream >> ThorsAnvil::Serialize::jsonImport(data, config),
+        std::runtime_error
+    );
+}
+
+TEST(SmartPointerTest, DeSerializeSharedPtrIdOutOfOrder)
+{
+    using ShareObject = std::shared_ptr<SmartPtrTest::Object>;
+
+    std::stringstream           stream(R"([{"__id":0,"__value":{"id":1,"name":"One"}},{"__id":0,"__value":{"id":2,"name":"Two"}}])");
+    std::vector<ShareObject>    data;
+
+    ThorsAnvil::Serialize::ParserInterface::ParserConfig    config;
+    config.preserveSharedPtr = true;
+    EXPECT_THROW(
+        stream >> ThorsAnvil::Serialize::jsonImport(data, config),
+        std::runtime_error
+    );
+}
+
+TEST(SmartPointerTest, SharedPtrCycleRoundTrip)
+{
+    using ShareNode = std::shared_ptr<SmartPtrTest::Node>;
+
+    ShareNode                   first  = std::make_shared<SmartPtrTest::Node>(SmartPtrTest::Node{1, nullptr});
+    ShareNode                   second = std::make_shared<SmartPtrTest::Node>(SmartPtrTest::Node{2, first});
+    first->next = second;
+
+    std::stringstream           stream;
+    ThorsAnvil::Serialize::PrinterInterface::PrinterConfig  printConfig{ThorsAnvil::Serialize::PrinterInterface::OutputType::Stream};
+    printConfig.preserveSharedPtr = true;
+    stream << ThorsAnvil::Serialize::jsonExport(first, printConfig);
+    EXPECT_EQ(stream.str(), R"({"__id":0,"__value":{"id":1,"next":{"__id":1,"__value":{"id":2,"next":{"__ref":0}}}}})");
+
+    ShareNode                   result;
+    ThorsAnvil::Serialize::ParserInterface::ParserConfig    parseConfig;
+    parseConfig.preserveSharedPtr = true;
+    stream >> ThorsAnvil::Serialize::jsonImport(result, parseConfig);
+
+    ASSERT_NE(result, nullptr);
+    ASSERT_NE(result->next, nullptr);
+    EXPECT_EQ(result->id, 1);
+    EXPECT_EQ(result->next->id, 2);
+    EXPECT_EQ(result->next->next, result);
+
+    // Break the cycles so the nodes are released.
+    first->next = nullptr;
+    result->next->next = nullptr;
+}
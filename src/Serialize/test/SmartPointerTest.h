@@ -10,6 +10,29 @@ namespace SmartPtrTest
         int         id;
         std::string name;
     };
+    struct Small
+    {
+        int         a;
+    };
+    struct Big
+    {
+        std::string s;
+        std::string t;
+    };
+    struct Holder
+    {
+        std::shared_ptr<Small>  sm;
+        std::shared_ptr<Big>    bg;
+    };
+    struct Node
+    {
+        int                     id;
+        std::shared_ptr<Node>   next;
+    };
 }
 ThorsAnvil_MakeTrait(SmartPtrTest::Object, id, name);
+ThorsAnvil_MakeTrait(SmartPtrTest::Small, a);
+ThorsAnvil_MakeTrait(SmartPtrTest::Big, s, t);
+ThorsAnvil_MakeTrait(SmartPtrTest::Holder, sm, bg);
+ThorsAnvil_MakeTrait(SmartPtrTest::Node, id, next);
 
@@ -0,0 +1,111 @@
+#include "gtest/gtest.h"
+#include "Serialize.h"
+#include "Serialize.tpp"
+#include "SerUtil.h"
+#include "JsonThor.h"
+#include <sstream>
+#include <vector>
+#include <map>
+#include <tuple>
+#include <memory>
+
+namespace StaticDispatchTest
+{
+struct Point
+{
+    int         x;
+    double      y;
+};
+struct Shape: public Point
+{
+    std::string                             name;
+    std::vector<Point>                      corners;
+    std::map<std::string, int>              tags;
+    std::tuple<int, std::string>            id;
+    std::unique_ptr<Point>                  centre;
+};
+}
+
+ThorsAnvil_MakeTrait(StaticDispatchTest::Point, x, y);
+ThorsAnvil_ExpandTrait(StaticDispatchTest::Point, StaticDispatchTest::Shape, name, corners, tags, id, centre);
+
+using ThorsAnvil::Serialize::BasicSerializer;
+using ThorsAnvil::Serialize::BasicDeSerializer;
+using ThorsAnvil::Serialize::Serializer;
+using ThorsAnvil::Serialize::DeSerializer;
+using ThorsAnvil::Serialize::JsonPrinter;
+using ThorsAnvil::Serialize::JsonParser;
+using ThorsAnvil::Serialize::PrinterInterface;
+
+namespace
+{
+StaticDispatchTest::Shape makeShape()
+{
+    StaticDispatchTest::Shape   shape;
+    shape.x         = 1;
+    shape.y         = 2.5;
+    shape.name      = "Box";
+    shape.corners   = {{0, 0}, {4, 0}, {4, 4}};
+    shape.tags      = {{"a", 1}, {"b", 2}};
+    shape.id        = std::make_tuple(7, std::string("seven"));
+    shape.centre    = std::make_unique<StaticDispatchTest::Point>(StaticDispatchTest::Point{2, 2});
+    return shape;
+}
+}
+
+TEST(StaticDispatchTest, SameOutputAsVirtual)
+{
+    StaticDispatchTest::Shape   shape = makeShape();
+
+    std::stringstream   dynamicStream;
+    {
+        JsonPrinter     printer(dynamicStream, PrinterInterface::OutputType::Stream);
+        Serializer      serializer(printer);
+        serializer.print(shape);
+    }
+    std::stringstream   staticStream;
+    {
+        JsonPrinter                     printer(staticStream, PrinterInterface::OutputType::Stream);
+        BasicSerializer<JsonPrinter>    serializer(printer);
+        serializer.print(shape);
+    }
+    EXPECT_EQ(dynamicStream.str(), staticStream.str());
+    EXPECT_EQ(R"({"x":1,"y":2.5,"name":"Box","corners":[{"x":0,"y":0.0},{"x":4,"y":0.0},{"x":4,"y":4}],"tags":{"a":1,"b":2},"id":[7,"seven"],"centre":{"x":2,"y":2}})", staticStream.str());
+}
+TEST(StaticDispatchTest, ParseWithConcreteParser)
+{
+    std::stringstream   stream(R"({"x":1,"y":2.5,"name":"Box","corners":[{"x":0,"y":0},{"x":4,"y":1}],"tags":{"a":1},"id":[7,"seven"],"centre":{"x":2,"y":3}})");
+    StaticDispatchTest::Shape   shape;
+    {
+        JsonParser                      parser(stream);
+        BasicDeSerializer<JsonParser>   deSerializer(parser);
+        deSerializer.parse(shape);
+    }
+    EXPECT_EQ(1,        shape.x);
+    EXPECT_EQ(2.5,      shape.y);
+    EXPECT_EQ("Box",    shape.name);
+    ASSERT_EQ(2,        shape.corners.size());
+    EXPECT_EQ(4,        shape.corners[1].x);
+    EXPECT_EQ(1,        shape.corners[1].y);
+    EXPECT_EQ(1,        shape.tags["a"]);
+    EXPECT_EQ(7,        std::get<0>(shape.id));
+    EXPECT_EQ("seven",  std::get<1>(shape.id));
+    ASSERT_NE(nullptr,  shape.centre);
+    EXPECT_EQ(3,        shape.centre->y);
+}
+TEST(StaticDispatchTest, RoundTripThroughExporter)
+{
+    StaticDispatchTest::Shape   shape = makeShape();
+    std::stringstream           stream;
+    stream << ThorsAnvil::Serialize::jsonExport(shape);
+
+    StaticDispatchTest::Shape   result;
+    stream >> ThorsAnvil::Serialize::jsonImport(result);
+
+    EXPECT_EQ(shape.name,           result.name);
+    EXPECT_EQ(shape.corners.size(), result.corners.size());
+    EXPECT_EQ(shape.tags,           result.tags);
+    EXPECT_EQ(shape.id,             result.id);
+    ASSERT_NE(nullptr,              result.centre);
+    EXPECT_EQ(shape.centre->x,      result.centre->x);
+}
@@ -0,0 +1,124 @@
+#include "gtest/gtest.h"
+#include "Serialize.h"
+#include "Serialize.tpp"
+#include "SerUtil.h"
+#include "JsonThor.h"
+#include <sstream>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace StringPoolTest
+{
+using ThorsAnvil::Serialize::InternedString;
+struct Product
+{
+    std::string                 name;
+    InternedString              country;
+    std::vector<InternedString> tags;
+};
+}
+
+ThorsAnvil_MakeTrait(StringPoolTest::Product, name, country, tags);
+
+using ThorsAnvil::Serialize::StringPool;
+using ThorsAnvil::Serialize::InternedString;
+using ThorsAnvil::Serialize::ParserInterface;
+using ThorsAnvil::Serialize::PrinterInterface;
+using ThorsAnvil::Serialize::jsonImport;
+using ThorsAnvil::Serialize::jsonExport;
+
+TEST(StringPoolTest, InternSharesStorage)
+{
+    StringPool      pool;
+    std::string     first("GB");
+    std::string     second("GB");
+    InternedString  a = pool.intern(first);
+    InternedString  b = pool.intern(second);
+    InternedString  c = pool.intern("US");
+
+    EXPECT_EQ(a.data(), b.data());
+    EXPECT_NE(first.data(), a.data());
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, c);
+    EXPECT_EQ("GB", a.view());
+    EXPECT_EQ(2, pool.size());
+    EXPECT_EQ(4, pool.memory());
+}
+TEST(StringPoolTest, LargeStrings)
+{
+    StringPool      pool;
+    std::string     large(100000, 'x');
+    InternedString  a = pool.intern(large);
+    InternedString  b = pool.intern("small");
+
+    EXPECT_EQ(large, a.view());
+    EXPECT_EQ("small", b.view());
+    EXPECT_EQ(a.data(), pool.intern(large).data());
+}
+TEST(StringPoolTest, ParseMembers)
+{
+    std::stringstream                       stream(R"([{"name": "Tea",    "country": "GB", "tags": ["hot", "drink"]},
+                                                       {"name": "Coffee", "country": "GB", "tags": ["hot"]}])");
+    std::vector<StringPoolTest::Product>    products;
+    StringPool                              pool;
+    ParserInterface::ParserConfig           config;
+    config.stringPool = &pool;
+
+    stream >> jsonImport(products, config);
+
+    ASSERT_EQ(2, products.size());
+    EXPECT_EQ("GB", products[0].country.view());
+    EXPECT_EQ(products[0].country.data(), products[1].country.data());
+    EXPECT_EQ(products[0].tags[0].data(), products[1].tags[0].data());
+    EXPECT_EQ(3, pool.size());
+}
+TEST(StringPoolTest, ParseWithoutPool)
+{
+    std::stringstream                       stream(R"({"name": "Tea", "country": "GB"})");
+    StringPoolTest::Product                 product;
+
+    EXPECT_THROW(
+        stream >> jsonImport(product),
+        std::runtime_error
+    );
+}
+TEST(StringPoolTest, MapKeys)
+{
+    std::stringstream                       stream(R"([{"GB": 1, "US": 2}, {"GB": 3}])");
+    std::vector<std::map<InternedString, int>>  data;
+    StringPool                              pool;
+    ParserInterface::ParserConfig           config;
+    config.stringPool = &pool;
+
+    stream >> jsonImport(data, config);
+
+    ASSERT_EQ(2, data.size());
+    EXPECT_EQ(3, data[1].begin()->second);
+    EXPECT_EQ(data[0].begin()->first.data(), data[1].begin()->first.data());
+    EXPECT_EQ(2, pool.size());
+}
+TEST(StringPoolTest, UnorderedMapKeys)
+{
+    std::stringstream                       stream(R"({"GB": 1, "US": 2})");
+    std::unordered_map<InternedString, int> data;
+    StringPool                              pool;
+    ParserInterface::ParserConfig           config;
+    config.stringPool = &pool;
+
+    stream >> jsonImport(data, config);
+
+    ASSERT_EQ(2, data.size());
+    EXPECT_EQ(1, data[pool.intern("GB")]);
+    EXPECT_EQ(2, data[pool.intern("US")]);
+}
+TEST(StringPoolTest, Print)
+{
+    StringPool                              pool;
+    StringPoolTest::Product                 product{"Tea", pool.intern("GB"), {pool.intern("hot")}};
+    std::map<InternedString, int>           data{{pool.intern("GB"), 1}};
+    std::stringstream                       stream;
+    stream << jsonExport(product, PrinterInterface::OutputType::Stream) << jsonExport(data, PrinterInterface::OutputType::Stream);
+
+    EXPECT_EQ(R"({"name":"Tea","country":"GB","tags":["hot"]}{"GB":1})", stream.str());
+}
@@ -152,4 +152,17 @@ TEST(THashTest, hashCompound)
     EXPECT_NE(TS::thash<THashTest::T1>(),      TS::thash<THashTest::D1>());
 }
 
+TEST(THashTest, hashIsCompileTimeConstant)
+{
+    static constexpr TS::THash     t1H         = TS::thash<THashTest::T1>();
+    static constexpr TS::THash     vectorH     = TS::thash<std::vector<BinaryParserTest::MapOneValue>>();
+    static constexpr TS::THash     mapH        = TS::thash<std::map<std::string, int>>();
+
+    static_assert(t1H == TS::thash<THashTest::T2>(), "Same layout should have the same hash");
+    static_assert(t1H != TS::thash<THashTest::D1>(), "Different layout should have different hash");
 
+    EXPECT_EQ(t1H,              TS::thash<THashTest::T1>());
+    EXPECT_EQ(vectorH,          TS::thash<std::vector<BinaryParserTest::MapOneValue>>());
+    EXPECT_EQ(mapH,             (TS::thash<std::map<std::string, int>>()));
+    EXPECT_NE(vectorH,          TS::thash<std::vector<BinaryParserTest::MapTwoValue>>());
+}
@@ -0,0 +1,163 @@
+#include "gtest/gtest.h"
+#include "Utf8Validator.h"
+#include "JsonThor.h"
+#include "Serialize.tpp"
+#include "SerUtil.h"
+#include <string>
+#include <vector>
+
+using ThorsAnvil::Serialize::isValidUtf8;
+
+namespace Utf8ValidatorTest
+{
+struct Named
+{
+    int         x;
+};
+}
+ThorsAnvil_MakeTrait(Utf8ValidatorTest::Named, x);
+
+namespace
+{
+bool valid(std::string const& value)
+{
+    return isValidUtf8(value.data(), value.size());
+}
+}
+
+TEST(Utf8ValidatorTest, Empty)
+{
+    EXPECT_TRUE(valid(""));
+}
+TEST(Utf8ValidatorTest, Ascii)
+{
+    // Long enough to use the block scan with a tail.
+    EXPECT_TRUE(valid("The quick brown fox jumps over the lazy dog 0123456789"));
+}
+TEST(Utf8ValidatorTest, MultiByte)
+{
+    EXPECT_TRUE(valid("\xC2\xA9"));                     // U+00A9
+    EXPECT_TRUE(valid("\xE2\x82\xAC"));                 // U+20AC
+    EXPECT_TRUE(valid("\xF0\x9F\x98\x80"));             // U+1F600
+    EXPECT_TRUE(valid("\xF4\x8F\xBF\xBF"));             // U+10FFFF
+    EXPECT_TRUE(valid(std::string(40, 'a') + "\xE2\x82\xAC" + std::string(40, 'b') + "\xC2\xA9"));
+}
+TEST(Utf8ValidatorTest, InvalidContinuation)
+{
+    EXPECT_FALSE(valid("\x80"));
+    EXPECT_FALSE(valid(std::string(33, 'a') + "\xBF"));
+    EXPECT_FALSE(valid("\xE2\x28\xA1"));
+}
+TEST(Utf8ValidatorTest, Truncated)
+{
+    EXPECT_FALSE(valid("\xC2"));
+    EXPECT_FALSE(valid("\xE2\x82"));
+    EXPECT_FALSE(valid("\xF0\x9F\x98"));
+}
+TEST(Utf8ValidatorTest, Overlong)
+{
+    EXPECT_FALSE(valid("\xC0\xAF"));
+    EXPECT_FALSE(valid("\xC1\xBF"));
+    EXPECT_FALSE(valid("\xE0\x80\xAF"));
+    EXPECT_FALSE(valid("\xF0\x80\x80\xAF"));
+}
+TEST(Utf8ValidatorTest, SurrogatesAndOutOfRange)
+{
+    EXPECT_FALSE(valid("\xED\xA0\x80"));                // U+D800
+    EXPECT_FALSE(valid("\xED\xBF\xBF"));                // U+DFFF
+    EXPECT_TRUE(valid("\xED\x9F\xBF"));                 // U+D7FF
+    EXPECT_FALSE(valid("\xF4\x90\x80\x80"));            // U+110000
+    EXPECT_FALSE(valid("\xF5\x80\x80\x80"));
+    EXPECT_FALSE(valid("\xFF"));
+}
+TEST(Utf8ValidatorTest, JsonParserRejectsInvalidString)
+{
+    std::stringstream           stream("[\"Good\", \"Bad\xC3\x28\"]");
+    std::vector<std::string>    data;
+
+    ThorsAnvil::Serialize::ParserInterface::ParserConfig    config;
+    config.validateUtf8 = true;
+    EXPECT_THROW(
+        stream >> ThorsAnvil::Serialize::jsonImport(data, config),
+        std::runtime_error
+    );
+}
+TEST(Utf8ValidatorTest, JsonParserRejectsInvalidKey)
+{
+    std::stringstream           stream("{\"Bad\xC3\x28\": 1}");
+    std::map<std::string, int>  data;
+
+    ThorsAnvil::Serialize::ParserInterface::ParserConfig    config;
+    config.validateUtf8 = true;
+    EXPECT_THROW(
+        stream >> ThorsAnvil::Serialize::jsonImport(data, config),
+        std::runtime_error
+    );
+}
+TEST(Utf8ValidatorTest, JsonParserDefaultDoesNotValidate)
+{
+    std::stringstream           stream("[\"Good\", \"Bad\xC3\x28\"]");
+    std::vector<std::string>    data;
+
+    stream >> ThorsAnvil::Serialize::jsonImport(data);
+    ASSERT_EQ(2, data.size());
+    EXPECT_EQ("Bad\xC3\x28", data[1]);
+}
+TEST(Utf8ValidatorTest, JsonParserAcceptsValidString)
+{
+    std::stringstream           stream("[\"Caf\xC3\xA9\", \"\\u20AC\"]");
+    std::vector<std::string>    data;
+
+    ThorsAnvil::Serialize::ParserInterface::ParserConfig    config;
+    config.validateUtf8 = true;
+    stream >> ThorsAnvil::Serialize::jsonImport(data, config);
+    ASSERT_EQ(2, data.size());
+    EXPECT_EQ("Caf\xC3\xA9", data[0]);
+    EXPECT_EQ("\xE2\x82\xAC", data[1]);
+}
+TEST(Utf8ValidatorTest, JsonParserRejectsInvalidIgnoredString)
+{
+    // "unknown" is not a member of Named so its value is skipped, not read.
+    std::stringstream           stream("{\"x\": 1, \"unknown\": [\"Bad\xC3\x28\"]}");
+    Utf8ValidatorTest::Named    data{};
+
+    ThorsAnvil::Serialize::ParserInterface::ParserConfig    config;
+    config.validateUtf8 = true;
+    EXPECT_THROW(
+        stream >> ThorsAnvil::Serialize::jsonImport(data, config),
+        std::runtime_error
+    );
+}
+TEST(Utf8ValidatorTest, JsonValidateRejectsInvalidString)
+{
+    std::stringstream           stream("{\"x\": 1, \"unknown\": \"Bad\xC3\x28\"}");
+
+    ThorsAnvil::Serialize::ParserInterface::ParserConfig    config;
+    config.validateUtf8 = true;
+    EXPECT_FALSE(ThorsAnvil::Serialize::jsonValidate<Utf8ValidatorTest::Named>(stream, config));
+}
+TEST(Utf8ValidatorTest, JsonParserRejectsInvalidEscape)
+{
+    // A lone low surrogate decodes to bytes that are not valid UTF-8.
+    std::stringstream           stream("[\"\\udc00\"]");
+    std::vector<std::string>    data;
+
+    ThorsAnvil::Serialize::ParserInterface::ParserConfig    config;
+    config.validateUtf8 = true;
+    EXPECT_THROW(
+        stream >> ThorsAnvil::Serialize::jsonImport(data, config),
+        std::runtime_error
+    );
+}
+TEST(Utf8ValidatorTest, JsonInSituRejectsInvalidString)
+{
+    std::string                 input("[\"Good\", \"Bad\xC3\x28\"]");
+    std::vector<std::string>    data;
+
+    ThorsAnvil::Serialize::ParserInterface::ParserConfig    config;
+    config.validateUtf8 = true;
+    EXPECT_THROW(
+        ThorsAnvil::Serialize::jsonImportInSitu(input.data(), input.size(), data, config),
+        std::runtime_error
+    );
+}
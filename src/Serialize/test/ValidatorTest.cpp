@@ -0,0 +1,117 @@
+#include "gtest/gtest.h"
+#include "Serialize.h"
+#include "Serialize.tpp"
+#include "SerUtil.h"
+#include "JsonThor.h"
+#include "Validator.h"
+#include <sstream>
+#include <vector>
+#include <map>
+
+namespace ValidatorTest
+{
+struct Point
+{
+    int         x;
+    double      y;
+};
+struct Named: public Point
+{
+    std::string         name;
+    bool                active;
+    std::vector<int>    data;
+};
+struct Index
+{
+    std::map<std::string, Point>    points;
+};
+}
+
+ThorsAnvil_MakeTrait(ValidatorTest::Point, x, y);
+ThorsAnvil_ExpandTrait(ValidatorTest::Point, ValidatorTest::Named, name, active, data);
+ThorsAnvil_MakeTrait(ValidatorTest::Index, points);
+
+using ThorsAnvil::Serialize::jsonValidate;
+using ThorsAnvil::Serialize::ParserInterface;
+using ThorsAnvil::Serialize::SchemaValidator;
+using ThorsAnvil::Serialize::JsonParser;
+
+TEST(ValidatorTest, ValidObject)
+{
+    std::stringstream   stream(R"({"x": 1, "y": 2.5})");
+    EXPECT_TRUE(jsonValidate<ValidatorTest::Point>(stream));
+}
+TEST(ValidatorTest, IntegerAcceptedForFloat)
+{
+    std::stringstream   stream(R"({"x": 1, "y": 2})");
+    EXPECT_TRUE(jsonValidate<ValidatorTest::Point>(stream));
+}
+TEST(ValidatorTest, FloatRejectedForInteger)
+{
+    std::stringstream   stream(R"({"x": 1.5, "y": 2})");
+    EXPECT_FALSE(jsonValidate<ValidatorTest::Point>(stream));
+}
+TEST(ValidatorTest, StringRejectedForNumber)
+{
+    std::stringstream   stream(R"({"x": "1", "y": 2})");
+    EXPECT_FALSE(jsonValidate<ValidatorTest::Point>(stream));
+}
+TEST(ValidatorTest, ValidDerivedObject)
+{
+    std::stringstream   stream(R"({"x": 1, "y": 2, "name": "Loki \"the\" cat\\", "active": true, "data": [1, 2, 3]})");
+    EXPECT_TRUE(jsonValidate<ValidatorTest::Named>(stream));
+}
+TEST(ValidatorTest, BadArrayElement)
+{
+    std::stringstream   stream(R"({"name": "Loki", "data": [1, true, 3]})");
+    EXPECT_FALSE(jsonValidate<ValidatorTest::Named>(stream));
+}
+TEST(ValidatorTest, MapExpectedFoundArray)
+{
+    std::stringstream   stream(R"([1, 2])");
+    EXPECT_FALSE(jsonValidate<ValidatorTest::Point>(stream));
+}
+TEST(ValidatorTest, WeakIgnoresUnknownKey)
+{
+    std::stringstream   stream(R"({"x": 1, "z": {"a": [1, "2"]}, "y": 2})");
+    EXPECT_TRUE(jsonValidate<ValidatorTest::Point>(stream));
+}
+TEST(ValidatorTest, StrictRejectsUnknownKey)
+{
+    std::stringstream   stream(R"({"x": 1, "z": 3, "y": 2})");
+    EXPECT_FALSE(jsonValidate<ValidatorTest::Point>(stream, ParserInterface::ParseType::Strict));
+}
+TEST(ValidatorTest, StrictAllowsMissingMember)
+{
+    std::stringstream   stream(R"({"x": 1})");
+    EXPECT_TRUE(jsonValidate<ValidatorTest::Point>(stream, ParserInterface::ParseType::Strict));
+}
+TEST(ValidatorTest, ExactRejectsMissingMember)
+{
+    std::stringstream   stream(R"({"x": 1, "name": "Loki", "active": false, "data": []})");
+    EXPECT_FALSE(jsonValidate<ValidatorTest::Named>(stream, ParserInterface::ParseType::Exact));
+}
+TEST(ValidatorTest, ExactAcceptsAllMembers)
+{
+    std::stringstream   stream(R"({"x": 1, "y": 2, "name": "Loki", "active": false, "data": []})");
+    EXPECT_TRUE(jsonValidate<ValidatorTest::Named>(stream, ParserInterface::ParseType::Exact));
+}
+TEST(ValidatorTest, DynamicMap)
+{
+    std::stringstream   good(R"({"points": {"a": {"x": 1, "y": 2}, "b": {"x": 3}}})");
+    EXPECT_TRUE(jsonValidate<ValidatorTest::Index>(good));
+
+    std::stringstream   bad(R"({"points": {"a": {"x": 1, "y": 2}, "b": 4}})");
+    EXPECT_FALSE(jsonValidate<ValidatorTest::Index>(bad));
+}
+TEST(ValidatorTest, ErrorIsReported)
+{
+    std::stringstream   stream(R"({"x": true})");
+    JsonParser          parser(stream);
+    SchemaValidator     validator(parser);
+
+    EXPECT_THROW(
+        validator.validateDocument<ValidatorTest::Point>(),
+        std::runtime_error
+    );
+}